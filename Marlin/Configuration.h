@@ -580,8 +580,10 @@
 //===========================================================================
 // PID Tuning Guide here: https://reprap.org/wiki/PID_Tuning
 
-// Comment the following line to disable PID and enable bang-bang.
+// Enable PIDTEMP for PID control or MPCTEMP for Model Predictive Control.
+// Disable both for bang-bang heating.
 #define PIDTEMP
+//#define MPCTEMP
 #define BANG_MAX 255     // Limits current to nozzle while in bang-bang mode; 255=full current
 #define PID_MAX BANG_MAX // Limits current to nozzle while PID is active (see PID_FUNCTIONAL_RANGE below); 255=full current
 #define PID_K1 0.95      // Smoothing factor within any PID loop
@@ -606,6 +608,41 @@
   #endif
 #endif // PIDTEMP
 
+/**
+ * Model Predictive Control for hotend
+ *
+ * Use a model of the hotend to plan the heater power, including the heat taken
+ * by the fan and by the filament the planner is feeding. The power for a change
+ * in flow is applied as the flow changes, not after the temperature has dropped.
+ * Measure the constants with 'M306 T', set them with M306, and save with M500.
+ */
+#if ENABLED(MPCTEMP)
+  #define MPC_MAX BANG_MAX                            // (0..255) Current to nozzle while MPC is active
+  #define MPC_HEATER_POWER { 40.0f }                  // (W) Heat cartridge powers
+
+  #define MPC_INCLUDE_FAN                             // Model the fan speed?
+
+  // Measured physical constants from M306
+  #define MPC_BLOCK_HEAT_CAPACITY { 16.7f }           // (J/K) Heat block heat capacities
+  #define MPC_SENSOR_RESPONSIVENESS { 0.22f }         // (K/s per ∆K) Rate of change of sensor temperature from heat block
+  #define MPC_AMBIENT_XFER_COEFF { 0.068f }           // (W/K) Heat transfer coefficients from heat block to room air with fan off
+  #if ENABLED(MPC_INCLUDE_FAN)
+    #define MPC_AMBIENT_XFER_COEFF_FAN255 { 0.097f }  // (W/K) Heat transfer coefficients from heat block to room air with fan on full
+    //#define MPC_FAN_0_ACTIVE_HOTEND                 // Fan 0 cools the active hotend. Otherwise fan N cools hotend N.
+  #endif
+
+  #define FILAMENT_HEAT_CAPACITY_PERMM { 5.6e-3f }    // (J/K/mm) 0.0056 for 1.75mm PLA (0.0149 for 2.85mm PLA)
+  //#define FILAMENT_HEAT_CAPACITY_PERMM { 3.6e-3f }  // (J/K/mm) 0.0036 for 1.75mm PETG (0.0094 for 2.85mm PETG)
+
+  // Advanced options
+  #define MPC_SMOOTHING_FACTOR 0.5f                   // (0.0...1.0) Noisy temperature sensors may need a lower value for stabilization
+  #define MPC_MIN_AMBIENT_CHANGE 1.0f                 // (K/s) Modeled ambient temperature rate of change, when correcting model inaccuracies
+  #define MPC_STEADYSTATE 0.5f                        // (K/s) Temperature change rate for steady state logic to be enforced
+
+  //#define MPC_TUNING_POS { X_CENTER, Y_CENTER, 1.0f } // (mm) M306 Autotuning position, ideally bed center at first layer height
+  #define MPC_TUNING_END_Z 10.0f                      // (mm) M306 Autotuning final Z position
+#endif // MPCTEMP
+
 //===========================================================================
 //====================== PID > Bed Temperature Control ======================
 //===========================================================================
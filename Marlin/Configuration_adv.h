@@ -137,6 +137,41 @@
   #define REDUNDANT_BETA                   3950    // Beta value
 #endif
 
+/**
+ * Custom Thermistor 1000 lookup tables
+ * Build a table in RAM for each custom thermistor whenever its parameters change (M305)
+ * and interpolate readings from it, instead of computing a logarithm for each reading.
+ * Tables cover -50°C to 500°C and take 2 bytes of RAM per step for each custom thermistor.
+ * Interpolation error for a 100K thermistor: 0.5°C with 10°C steps, 0.15°C with 5°C steps.
+ */
+#define USER_THERMISTOR_TABLE_STEP 10          // (°C) Comment out to compute each reading directly
+
+/**
+ * Thermistor Direct Index
+ * Expand each thermistor table in use at compile time into one entry per ADC count,
+ * so a reading is converted with one table read and an integer interpolation
+ * instead of a binary search and a float divide. Readings match the table search
+ * to within 1/32°C. Costs about 2K of flash for each thermistor type in use.
+ * Requires C++14, so not for AVR.
+ */
+//#define THERMISTOR_DIRECT_INDEX
+
+/**
+ * ADC Scan Mode
+ * On boards with HAL support, convert all analog channels continuously in the
+ * background (e.g., with DMA) instead of starting one conversion per Temperature
+ * ISR call. Temperatures are then read every ADC_SCAN_INTERVAL ISR calls (~1ms each)
+ * instead of every ~164ms, and the ISR does almost no ADC work in between.
+ * PID and MPC run at the new rate, so re-tune PID with M303 after enabling.
+ */
+//#define ADC_SCAN_MODE
+#if ENABLED(ADC_SCAN_MODE)
+  #define ADC_SCAN_OVERSAMPLE 16  // Conversions averaged for each reading (1, 2, 4, 8, 16)
+  #define ADC_SCAN_INTERVAL   16  // Temperature ISR calls between readings
+  #define ADC_SCAN_MEDIAN         // Take the median of the last 3 readings to reject spikes
+  #define ADC_SCAN_IIR_SHIFT   1  // Low-pass filter each reading with a weight of 1/2^n (0 to disable)
+#endif
+
 /**
  * Configuration options for MAX Thermocouples (-2, -3, -5).
  *   FORCE_HW_SPI:   Ignore SCK/MOSI/MISO pins and just use the CS pin & default SPI bus.
@@ -1124,6 +1159,20 @@
  */
 #define ADAPTIVE_STEP_SMOOTHING
 
+/**
+ * Step Segment Buffer
+ *
+ * Split each move into short segments at a constant step rate in the main loop, so
+ * the Stepper ISR no longer evaluates the acceleration curve for every step. This
+ * reduces ISR time and jitter, allowing for higher step rates. Whenever the main loop
+ * falls behind, the Stepper ISR computes the step rate itself, as usual.
+ */
+//#define STEP_SEGMENT_BUFFER
+#if ENABLED(STEP_SEGMENT_BUFFER)
+  #define STEP_SEGMENT_BUFFER_SIZE 16   // Number of prepared segments. Power of 2, up to 128.
+  #define STEP_SEGMENT_TIME      1000   // (µs) Duration of each accelerating/decelerating segment
+#endif
+
 /**
  * Custom Microstepping
  * Override as-needed for your setup. Up to 3 MS pins are supported.
@@ -1351,6 +1400,18 @@
 
   #define SD_PROCEDURE_DEPTH 1              // Increase if you need more nested M32 calls
 
+  // Read ahead while printing, using multiple block reads to fill a buffer of 512-byte blocks.
+  // Keeps dense G-code from starving the planner with slow SPI cards. Costs 512 bytes of RAM per block.
+  //#define SD_READ_AHEAD_BLOCKS 2            // Blocks to read ahead (1-32)
+
+  // Cache several 512-byte blocks so FAT, directory and file data don't keep evicting each other.
+  // Blocks are written back when evicted or flushed. M35 reports hits and misses to help size it.
+  //#define SD_CACHE_BLOCKS 4                 // Blocks in the cache (1-16). Costs 512 bytes of RAM per block.
+
+  // Claim clusters for files being written several at a time, so the FAT is updated less often and
+  // whole blocks stream to the card as one multiple block write. Unused clusters are freed on close.
+  //#define SD_PREALLOCATE_CLUSTERS 16        // Clusters to claim at a time (2-255)
+
   #define SD_FINISHED_STEPPERRELEASE true   // Disable steppers when SD Print is finished
   #define SD_FINISHED_RELEASECOMMAND "M84"  // Use "M84XYE" to keep Z enabled so your bed stays in place
 
@@ -1533,6 +1594,30 @@
   // Add an optimized binary file transfer mode, initiated with 'M28 B1'
   //#define BINARY_FILE_TRANSFER
 
+  #if ENABLED(BINARY_FILE_TRANSFER)
+    // Let the host send packets ahead of the ACKs to keep the link busy.
+    // Packets are held in a static buffer of WINDOW * (PACKET_SIZE + 4) bytes of RAM,
+    // e.g., 8 * 512 bytes is over 4K. (Default 1 packet of MAX_CMD_SIZE, about 100 bytes)
+    // AVR is limited to 1K.
+    //#define BINARY_STREAM_WINDOW         4  // Packets in flight (1, 2, 4, 8, or 16)
+    //#define BINARY_STREAM_PACKET_SIZE  512  // Largest packet payload, in bytes
+
+    // Collect uploads in two 512-byte sector buffers and write each full sector to SD
+    // between packets. Best with SD_PREALLOCATE_CLUSTERS.
+    //#define BINARY_STREAM_WRITE_BEHIND
+
+    // Print a transfer opened with the "print" flag as it arrives, like an SD print.
+    // The file is also saved to SD unless it's a dummy transfer, so it can be printed again.
+    //#define BINARY_STREAM_PRINT
+    #if ENABLED(BINARY_STREAM_PRINT)
+      #define BINARY_STREAM_PRINT_BUFFER 1024 // Bytes of G-code buffered ahead of the queue (512-16384, a power of 2)
+    #endif
+  #endif
+
+  // Accept pre-tokenized binary G-code (see buildroot/share/scripts/gcode_binary.py)
+  // in SD files and, with BINARY_FILE_TRANSFER, as a stream of binary packets
+  //#define BINARY_GCODE
+
   /**
    * Set this option to one of the following (or the board's defaults apply):
    *
@@ -1911,6 +1996,47 @@
   //#define EXPERIMENTAL_SCURVE // Enable this option to permit S-Curve Acceleration
 #endif
 
+// @section motion
+
+/**
+ * Input Shaping -- EXPERIMENTAL
+ *
+ * Cancel the ringing ("ghosting") caused by a frame resonance, allowing
+ * much higher accelerations. Every step on a shaped axis is split into
+ * two or three smaller impulses, spread in time so that the vibrations
+ * they excite cancel each other out.
+ *
+ * Shaper types, from the shortest to the longest (and most robust):
+ *   SHAPER_ZV  : Zero Vibration. 2 impulses over half a period.
+ *   SHAPER_MZV : Modified ZV. 3 impulses over 3/4 period.
+ *   SHAPER_ZVD : ZV and Derivative. 3 impulses over one period.
+ *   SHAPER_EI  : Extra Insensitive. 3 impulses over one period, tolerates the most frequency error.
+ *
+ * Measure the ringing frequency from a test print and tune with
+ * M593 [X|Y] F<Hz> D<zeta> T<type>. A frequency of 0 disables shaping.
+ *
+ * Each shaped axis keeps a queue of recent steps until all their impulses
+ * are out. If a queue fills up, motion is slowed until there is room.
+ * Size it to hold (max steps/s) * (shaper duration), e.g. 24000 * 0.75 / 40Hz = 450 steps.
+ */
+//#define INPUT_SHAPING_X
+//#define INPUT_SHAPING_Y
+#if EITHER(INPUT_SHAPING_X, INPUT_SHAPING_Y)
+  #if ENABLED(INPUT_SHAPING_X)
+    #define SHAPING_FREQ_X  40          // (Hz) The default dominant resonant frequency on the X axis.
+    #define SHAPING_ZETA_X  0.10f       // Damping ratio of the X axis (range: 0.0 = no damping to 0.99).
+    #define SHAPING_TYPE_X  SHAPER_MZV  // Shaper used on the X axis.
+  #endif
+  #if ENABLED(INPUT_SHAPING_Y)
+    #define SHAPING_FREQ_Y  40          // (Hz) The default dominant resonant frequency on the Y axis.
+    #define SHAPING_ZETA_Y  0.10f       // Damping ratio of the Y axis (range: 0.0 = no damping to 0.99).
+    #define SHAPING_TYPE_Y  SHAPER_MZV  // Shaper used on the Y axis.
+  #endif
+  #define SHAPING_MIN_FREQ    10        // (Hz) Lowest frequency accepted by M593
+  #define SHAPING_MAX_FREQ   200        // (Hz) Highest frequency accepted by M593
+  #define SHAPING_BUFFER_SIZE 512       // Queued steps per shaped axis (4 bytes each, 2K per axis). Power of 2. AVR: 128 for 2 axes.
+#endif
+
 // @section leveling
 
 /**
@@ -2058,6 +2184,7 @@
   #define ARC_P_CIRCLES           // Enable the 'P' parameter to specify complete circles
   //#define CNC_WORKSPACE_PLANES    // Allow G2/G3 to operate in XY, ZX, or YZ planes
   //#define SF_ARC_FIX              // Enable only if using SkeinForge with "Arc Point" fillet procedure
+  //#define ARC_BLOCKS              // Plan each arc as a single block traced by the stepper (Cartesian only)
 #endif
 
 // Support for G5 with XYZE destination and IJPQ offsets. Requires ~2666 bytes.
@@ -2086,6 +2213,24 @@
   #define G38_MINIMUM_MOVE 0.0275 // (mm) Minimum distance that will produce a move.
 #endif
 
+/**
+ * Path Blending
+ *
+ * Merge runs of short, nearly collinear G0/G1 segments into longer moves
+ * before they are planned, so the machine can hold its speed through the
+ * finely-tessellated curves produced by most slicers.
+ *
+ * Use 'G64 P<mm>' to enable blending with the given deviation from the
+ * original path, 'G64' for the default tolerance, and 'G64 P0' to disable.
+ * Blending is off at startup. 'M415' reports the number of merged segments.
+ * Cartesian machines only.
+ */
+//#define PATH_BLENDING
+#if ENABLED(PATH_BLENDING)
+  #define PATH_BLENDING_TOLERANCE      0.02 // (mm) Default deviation for 'G64' with no 'P'
+  #define PATH_BLENDING_MAX_SEGMENTS      8 // Maximum number of segments merged into one move
+#endif
+
 // Moves (or segments) with fewer steps than this will be joined with the next move
 #define MIN_STEPS_PER_SEGMENT 6
 
@@ -2145,6 +2290,8 @@
 
 // The number of linear moves that can be in the planner at once.
 // The value of BLOCK_BUFFER_SIZE must be a power of 2 (e.g., 8, 16, 32)
+// 32-bit boards with enough RAM may use up to 1024 for a longer lookahead
+// with very short segments at high speed. Each block takes about 150 bytes.
 #if BOTH(SDSUPPORT, DIRECT_STEPPING)
   #define BLOCK_BUFFER_SIZE  8
 #elif ENABLED(SDSUPPORT)
@@ -2159,6 +2306,12 @@
 #define MAX_CMD_SIZE 96
 #define BUFSIZE 4
 
+// Queued commands are packed end-to-end into BUFSIZE * MAX_CMD_SIZE bytes, so short
+// lines leave room for more of them. Set the most commands to keep in that space.
+// Typical G1 lines are 20-30 bytes, so 3 to 5 times BUFSIZE is a good choice.
+// Each extra command costs 4 bytes of RAM (8 with POWER_LOSS_RECOVERY).
+//#define MAX_QUEUED_COMMANDS 16
+
 // Transmission to Host Buffer Size
 // To save 386 bytes of PROGMEM (and TX_BUFFER_SIZE+3 bytes of RAM) set to 0.
 // To buffer a simple "ok" you need 4 bytes.
@@ -2235,6 +2388,13 @@
 // Some clients will have this feature soon. This could make the NO_TIMEOUTS unnecessary.
 //#define ADVANCED_OK
 
+// Credit flow control. After "M577 S1" a host gets "credit L<lines> B<bytes>" reports
+// instead of an "ok" per command, so it can keep sending without waiting for replies.
+//#define SERIAL_CREDITS
+#if ENABLED(SERIAL_CREDITS)
+  //#define SERIAL_CREDITS_BATCH 4  // Commands run between reports while the planner is busy
+#endif
+
 // Printrun may have trouble receiving long strings all at once.
 // This option inserts short delays between lines of serial output.
 #define SERIAL_OVERRUN_PROTECTION
@@ -3664,11 +3824,23 @@
 
 #if ENABLED(FASTER_GCODE_PARSER)
   //#define GCODE_QUOTED_STRINGS  // Support for quoted string parameters
+
+  // Parse commands and convert their values as they are queued, while the planner is busy,
+  // instead of when they run. Costs about 48 bytes of SRAM per MAX_QUEUED_COMMANDS.
+  //#define PARSE_AT_ENQUEUE
+  #if ENABLED(PARSE_AT_ENQUEUE)
+    //#define G0_G1_FAST_PATH     // Send plain G0 / G1 moves from the queue straight to the planner (Cartesian only)
+  #endif
 #endif
 
 // Support for MeatPack G-code compression (https://github.com/scottmudge/OctoPrint-MeatPack)
 //#define MEATPACK_ON_SERIAL_PORT_1
 //#define MEATPACK_ON_SERIAL_PORT_2
+//#define MEATPACK_V2             // Add protocol version 2, with symbol and token tables set by the host
+//#define MEATPACK_SD_FILES       // Print MeatPack v2 files (*.MP) from SD. Pack them with buildroot/share/scripts/meatpack.py
+#if EITHER(MEATPACK_V2, MEATPACK_SD_FILES)
+  //#define MEATPACK_TOKEN_SIZE 6 // Longest v2 token. Each stream takes 15 bytes of SRAM per character.
+#endif
 
 //#define GCODE_CASE_INSENSITIVE  // Accept G-code sent to the firmware in lowercase
 
@@ -57,6 +57,20 @@
   #error "MONITOR_DRIVER_STATUS causes performance issues when used with SoftwareSerial-connected drivers. Disable MONITOR_DRIVER_STATUS or use hardware serial to continue."
 #endif
 
+/**
+ * Binary Stream packet window, a static buffer
+ */
+#if ENABLED(BINARY_FILE_TRANSFER) && (BINARY_STREAM_WINDOW) * ((BINARY_STREAM_PACKET_SIZE) + 4) > 1024
+  #error "BINARY_STREAM_WINDOW * BINARY_STREAM_PACKET_SIZE is too large for AVR. Use 1K of RAM or less."
+#endif
+
+/**
+ * Input Shaping step queues, 4 bytes per step for each shaped axis
+ */
+#if HAS_SHAPING && (SHAPING_BUFFER_SIZE) * 4 * (ENABLED(INPUT_SHAPING_X) + ENABLED(INPUT_SHAPING_Y)) > 1024
+  #error "SHAPING_BUFFER_SIZE is too large for AVR. Use 256 or less with one shaped axis, 128 or less with two."
+#endif
+
 /**
  * Postmortem debugging
  */
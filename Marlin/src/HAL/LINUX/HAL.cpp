@@ -23,6 +23,7 @@
 
 #include "../../inc/MarlinConfig.h"
 #include "../shared/Delay.h"
+#include "virtual_time.h"
 
 MSerialT usb_serial(TERN0(EMERGENCY_PARSER, true));
 
@@ -62,17 +63,67 @@ bool HAL_adc_finished() {
   return true;
 }
 
-uint16_t HAL_adc_get_result() {
-  pin_t pin = analogInputToDigitalPin(active_ch);
+static uint16_t adc_read(const uint8_t ch) {
+  pin_t pin = analogInputToDigitalPin(ch);
   if (!VALID_PIN(pin)) return 0;
   uint16_t data = ((Gpio::get(pin) >> 2) & 0x3FF);
   return data;    // return 10bit value as Marlin expects
 }
 
+uint16_t HAL_adc_get_result() {
+  return adc_read(active_ch);
+}
+
+#if ENABLED(ADC_SCAN_MODE)
+
+  /**
+   * Emulate a DMA scan of the channels. A sweep converts every channel once,
+   * taking ADC_SCAN_CONVERSION_NS per channel, into a circular buffer that
+   * holds the last ADC_SCAN_OVERSAMPLE sweeps. The sweeps that would have
+   * completed are caught up whenever the buffer is read.
+   */
+  #define ADC_SCAN_CONVERSION_NS 10000
+
+  static const pin_t *scan_pins;
+  static uint8_t scan_count, scan_sweep;
+  static uint16_t scan_buffer[ADC_SCAN_OVERSAMPLE][NUM_ANALOG_INPUTS];
+  static uint64_t scan_next_ns;
+
+  static void adc_scan_sweep() {
+    LOOP_L_N(i, scan_count) scan_buffer[scan_sweep][i] = adc_read(scan_pins[i]);
+    if (++scan_sweep >= ADC_SCAN_OVERSAMPLE) scan_sweep = 0;
+  }
+
+  void HAL_adc_scan_start(const pin_t pins[], const uint8_t count) {
+    scan_pins = pins;
+    scan_count = _MIN(count, NUM_ANALOG_INPUTS);
+    LOOP_L_N(i, ADC_SCAN_OVERSAMPLE) adc_scan_sweep();
+    scan_next_ns = Clock::nanos() + uint64_t(ADC_SCAN_CONVERSION_NS) * scan_count;
+  }
+
+  uint32_t HAL_adc_scan_value(const uint8_t index) {
+    const uint64_t now = Clock::nanos(), sweep_ns = uint64_t(ADC_SCAN_CONVERSION_NS) * scan_count;
+    if (now >= scan_next_ns) {
+      // Older sweeps would be overwritten by the newer ones
+      const uint64_t sweeps = _MIN((now - scan_next_ns) / sweep_ns + 1, uint64_t(ADC_SCAN_OVERSAMPLE));
+      LOOP_L_N(i, sweeps) adc_scan_sweep();
+      scan_next_ns = now + sweep_ns;
+    }
+    uint32_t sum = 0;
+    LOOP_L_N(i, ADC_SCAN_OVERSAMPLE) sum += scan_buffer[i][index];
+    return sum;
+  }
+
+#endif // ADC_SCAN_MODE
+
 void HAL_pwm_init() {
 
 }
 
 void HAL_reboot() { /* Reset the application state and GPIO */ }
 
+void HAL_idletask() {
+  if (Clock::isVirtual()) VirtualTime::idle();
+}
+
 #endif // __PLAT_LINUX__
@@ -78,6 +78,14 @@ extern MSerialT usb_serial;
 
 inline void HAL_init() {}
 
+// Run due timers on the virtual clock
+#define HAL_IDLETASK 1
+void HAL_idletask();
+
+#if ENABLED(PLANNER_BENCHMARK)
+  #include "benchmark.h"
+#endif
+
 // Utility functions
 #if GCC_VERSION <= 50000
   #pragma GCC diagnostic push
@@ -103,6 +111,11 @@ void HAL_adc_enable_channel(const uint8_t ch);
 void HAL_adc_start_conversion(const uint8_t ch);
 uint16_t HAL_adc_get_result();
 
+// ADC scan mode: convert a list of channels continuously into a buffer
+#define HAL_ADC_SCAN
+void HAL_adc_scan_start(const pin_t pins[], const uint8_t count);
+uint32_t HAL_adc_scan_value(const uint8_t index); // Sum of the last ADC_SCAN_OVERSAMPLE conversions
+
 // Reset source
 inline void HAL_clear_reset_source(void) {}
 inline uint8_t HAL_get_reset_source(void) { return RST_POWER_ON; }
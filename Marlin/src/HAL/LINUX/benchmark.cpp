@@ -0,0 +1,787 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#ifdef __PLAT_LINUX__
+
+// Ahead of Arduino.h, whose abs() macro breaks <random>
+#include <string.h>
+#include <random>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(PLANNER_BENCHMARK)
+
+#include "virtual_time.h"
+#include "hardware/Heater.h"
+#include "hardware/LinearAxis.h"
+#include "../../gcode/parser.h"
+#include "../../module/planner.h"
+#include "../../module/stepper.h"
+#include "../../module/temperature.h"
+
+#if ENABLED(INPUT_SHAPING_X)
+  #include "../../feature/input_shaping.h"
+#endif
+#if ENABLED(BINARY_GCODE)
+  #include "../../gcode/queue.h"
+  #include "../../feature/binary_gcode.h"
+#endif
+
+#include "../../module/thermistor/thermistors.h"
+
+/**
+ * Usage: linux_native_benchmark [-v] [--heaters] <file.gcode>
+ *        linux_native_benchmark --numbers
+ *        linux_native_benchmark --thermistors
+ *        linux_native_benchmark --shaping
+ *        linux_native_benchmark --binary-gcode <file.bgcode> <file.gcode>
+ *
+ *  -v             Echo the firmware's serial output to stderr
+ *  --heaters      Report how the hotend and bed settle on each new target (see buildroot/test-gcode/heater-scenario.gcode)
+ *  --numbers      Check the G-code number scanners against strtof / strtol / strtoul and time them
+ *  --thermistors  Check the direct-index thermistor tables against the table search for every raw value
+ *  --shaping      Check the shaped X step trace against the unshaped Y axis for each shaper type
+ *  --binary-gcode Decode each record of a file made by gcode_binary.py into the command queue and
+ *                 check that it parses as the same command as the line it came from
+ *
+ * The file runs on the virtual clock (see virtual_time.h), so host time
+ * spent planning does not count towards the simulated print time.
+ */
+
+extern void loop();
+
+Benchmark benchmark;
+
+bench_stat_t Benchmark::populate, Benchmark::recalculate, Benchmark::step_isr, Benchmark::temp_isr, Benchmark::command;
+uint64_t Benchmark::excluded_ns, Benchmark::excluded_count;
+uint8_t Benchmark::excluded_depth;
+double Benchmark::excluded_overhead_ns;
+
+static void print_time(const char * const label, const uint64_t ns) {
+  const uint64_t ms = ns / 1000000;
+  printf("%-22s: %u:%02u:%02u.%03u\n", label, unsigned(ms / 3600000), unsigned(ms / 60000 % 60), unsigned(ms / 1000 % 60), unsigned(ms % 1000));
+}
+
+// A random G-code style number, with the odd long, padded, or unusual one
+static std::string random_number(std::mt19937 &rng) {
+  auto digits = [&](int n) { std::string d; while (n--) d += char('0' + rng() % 10); return d; };
+  std::string s;
+  switch (rng() % 8) {
+    case 0: s += '-'; break;
+    case 1: s += '+'; break;
+  }
+  const int idig = rng() % 8, fdig = rng() % 10;
+  switch (rng() % 16) {
+    case 0:  s += digits(10 + rng() % 6); break;                      // Too long for the fast path
+    case 1:  s += "0x" + digits(1 + rng() % 3); return s;             // Hexadecimal
+    case 2:  s += digits(idig) + "." + digits(fdig) + "000000"; break; // Trailing zeros
+    case 3:  s += "." + std::string(rng() % 8, '0') + digits(1 + rng() % 4); break;
+    default: s += (idig ? digits(idig) : "0");
+             if (fdig) s += "." + digits(fdig);
+  }
+  switch (rng() % 6) {                                                // What follows the number
+    case 0: s += " Y1"; break;
+    case 1: s += "E2"; break;
+    case 2: s += "e-3"; break;
+  }
+  return s;
+}
+
+// Find the host time that timing an excluded section adds outside of it
+static void calibrate_excluded_overhead() {
+  constexpr uint32_t n = 1000000;
+  const uint64_t start = Benchmark::host_nanos(), excluded = Benchmark::excluded_ns;
+  for (uint32_t i = 0; i < n; i++) { const BenchmarkExcludeScope section; }
+  Benchmark::excluded_overhead_ns = double(Benchmark::host_nanos() - start - (Benchmark::excluded_ns - excluded)) / n;
+  Benchmark::excluded_ns = excluded;
+  Benchmark::excluded_count = 0;
+}
+
+static int number_benchmark() {
+  std::mt19937 rng(1);
+  std::vector<std::string> numbers;
+  for (const char *edge : { "0", "-0", "+0", ".5", "-.5", "5.", "16777216", "16777217", "0.0000000001", "0.00000000001",
+                            "2147483647", "-2147483648", "4294967295", "99999999999", "1.5E3", "-12.34567 X" })
+    numbers.push_back(edge);
+  while (numbers.size() < 1000000) numbers.push_back(random_number(rng));
+
+  // strtof with the 'E' hidden, as value_float() used to do it
+  auto reference_float = [](char *p) {
+    char *e = p;
+    while (*e && *e != ' ' && *e != 'E' && *e != 'e') ++e;
+    const char c = *e;
+    *e = '\0';
+    const float f = strtof(p, nullptr);
+    *e = c;
+    return f;
+  };
+
+  unsigned errors = 0;
+  for (std::string &n : numbers) {
+    char * const p = &n[0];
+    const float f = GCodeParser::scan_float(p), g = reference_float(p);
+    const int32_t l = GCodeParser::scan_long(p);
+    const uint32_t u = GCodeParser::scan_ulong(p);
+    if (memcmp(&f, &g, sizeof(f)) || l != int32_t(strtol(p, nullptr, 10)) || u != uint32_t(strtoul(p, nullptr, 10))) {
+      if (++errors <= 10) printf("Mismatch for \"%s\": %.9g / %.9g, %ld, %lu\n", p, f, g, long(l), (unsigned long)u);
+    }
+  }
+
+  // Unlike strtof, the scanner reads no digits in "nan" or "inf", so they give zero
+  for (const char *word : { "nan", "-nan", "NAN", "inf", "-inf", "Infinity" }) {
+    std::string n = word;
+    const float f = GCodeParser::scan_float(&n[0]);
+    if (f != 0 && ++errors <= 10) printf("Mismatch for \"%s\": %.9g / 0\n", word, f);
+  }
+
+  auto time_ns = [&](auto fn) {
+    volatile float sink = 0;
+    const uint64_t start = Benchmark::host_nanos();
+    for (std::string &n : numbers) sink = sink + fn(&n[0]);
+    return double(Benchmark::host_nanos() - start) / numbers.size();
+  };
+  const double fast_f = time_ns([](char *p) { return GCodeParser::scan_float(p); }),
+               slow_f = time_ns(reference_float),
+               fast_l = time_ns([](char *p) { return float(GCodeParser::scan_long(p)); }),
+               slow_l = time_ns([](char *p) { return float(strtol(p, nullptr, 10)); });
+
+  printf("%-22s: %u\n", "Numbers", unsigned(numbers.size()));
+  printf("%-22s: %u\n", "Mismatches", errors);
+  printf("%-22s: %.1f ns (strtof %.1f ns)\n", "scan_float()", fast_f, slow_f);
+  printf("%-22s: %.1f ns (strtol %.1f ns)\n", "scan_long()", fast_l, slow_l);
+  return errors ? 1 : 0;
+}
+
+// Every thermistor table, including those the configuration doesn't use
+#define THERMISTOR_TABLES(F) F(1) F(2) F(3) F(4) F(5) F(6) F(7) F(8) F(9) F(10) F(11) F(12) F(13) F(15) F(17) F(18) \
+                             F(20) F(21) F(22) F(23) F(30) F(51) F(52) F(55) F(60) F(61) F(66) F(67) F(70) F(71) F(75) \
+                             F(99) F(110) F(147) F(201) F(202) F(331) F(332) F(501) F(502) F(503) F(512) F(666) \
+                             F(998) F(999) F(1010) F(1047) F(2000)
+
+#if !ANY_THERMISTOR_IS(1)
+  #include "../../module/thermistor/thermistor_1.h"
+#endif
+#if !ANY_THERMISTOR_IS(2)
+  #include "../../module/thermistor/thermistor_2.h"
+#endif
+#if !ANY_THERMISTOR_IS(3)
+  #include "../../module/thermistor/thermistor_3.h"
+#endif
+#if !ANY_THERMISTOR_IS(4)
+  #include "../../module/thermistor/thermistor_4.h"
+#endif
+#if !ANY_THERMISTOR_IS(5)
+  #include "../../module/thermistor/thermistor_5.h"
+#endif
+#if !ANY_THERMISTOR_IS(6)
+  #include "../../module/thermistor/thermistor_6.h"
+#endif
+#if !ANY_THERMISTOR_IS(7)
+  #include "../../module/thermistor/thermistor_7.h"
+#endif
+#if !ANY_THERMISTOR_IS(8)
+  #include "../../module/thermistor/thermistor_8.h"
+#endif
+#if !ANY_THERMISTOR_IS(9)
+  #include "../../module/thermistor/thermistor_9.h"
+#endif
+#if !ANY_THERMISTOR_IS(10)
+  #include "../../module/thermistor/thermistor_10.h"
+#endif
+#if !ANY_THERMISTOR_IS(11)
+  #include "../../module/thermistor/thermistor_11.h"
+#endif
+#if !ANY_THERMISTOR_IS(12)
+  #include "../../module/thermistor/thermistor_12.h"
+#endif
+#if !ANY_THERMISTOR_IS(13)
+  #include "../../module/thermistor/thermistor_13.h"
+#endif
+#if !ANY_THERMISTOR_IS(15)
+  #include "../../module/thermistor/thermistor_15.h"
+#endif
+#if !ANY_THERMISTOR_IS(17)
+  #include "../../module/thermistor/thermistor_17.h"
+#endif
+#if !ANY_THERMISTOR_IS(18)
+  #include "../../module/thermistor/thermistor_18.h"
+#endif
+#if !ANY_THERMISTOR_IS(20)
+  #include "../../module/thermistor/thermistor_20.h"
+#endif
+#if !ANY_THERMISTOR_IS(21)
+  #include "../../module/thermistor/thermistor_21.h"
+#endif
+#if !ANY_THERMISTOR_IS(22)
+  #include "../../module/thermistor/thermistor_22.h"
+#endif
+#if !ANY_THERMISTOR_IS(23)
+  #include "../../module/thermistor/thermistor_23.h"
+#endif
+#if !ANY_THERMISTOR_IS(30)
+  #include "../../module/thermistor/thermistor_30.h"
+#endif
+#if !ANY_THERMISTOR_IS(51)
+  #include "../../module/thermistor/thermistor_51.h"
+#endif
+#if !ANY_THERMISTOR_IS(52)
+  #include "../../module/thermistor/thermistor_52.h"
+#endif
+#if !ANY_THERMISTOR_IS(55)
+  #include "../../module/thermistor/thermistor_55.h"
+#endif
+#if !ANY_THERMISTOR_IS(60)
+  #include "../../module/thermistor/thermistor_60.h"
+#endif
+#if !ANY_THERMISTOR_IS(61)
+  #include "../../module/thermistor/thermistor_61.h"
+#endif
+#if !ANY_THERMISTOR_IS(66)
+  #include "../../module/thermistor/thermistor_66.h"
+#endif
+#if !ANY_THERMISTOR_IS(67)
+  #include "../../module/thermistor/thermistor_67.h"
+#endif
+#if !ANY_THERMISTOR_IS(70)
+  #include "../../module/thermistor/thermistor_70.h"
+#endif
+#if !ANY_THERMISTOR_IS(71)
+  #include "../../module/thermistor/thermistor_71.h"
+#endif
+#if !ANY_THERMISTOR_IS(75)
+  #include "../../module/thermistor/thermistor_75.h"
+#endif
+#if !ANY_THERMISTOR_IS(99)
+  #include "../../module/thermistor/thermistor_99.h"
+#endif
+#if !ANY_THERMISTOR_IS(110)
+  #include "../../module/thermistor/thermistor_110.h"
+#endif
+#if !ANY_THERMISTOR_IS(147)
+  #include "../../module/thermistor/thermistor_147.h"
+#endif
+#if !ANY_THERMISTOR_IS(201)
+  #include "../../module/thermistor/thermistor_201.h"
+#endif
+#if !ANY_THERMISTOR_IS(202)
+  #include "../../module/thermistor/thermistor_202.h"
+#endif
+#if !ANY_THERMISTOR_IS(331)
+  #include "../../module/thermistor/thermistor_331.h"
+#endif
+#undef OVM
+#if !ANY_THERMISTOR_IS(332)
+  #include "../../module/thermistor/thermistor_332.h"
+#endif
+#if !ANY_THERMISTOR_IS(501)
+  #include "../../module/thermistor/thermistor_501.h"
+#endif
+#if !ANY_THERMISTOR_IS(502)
+  #include "../../module/thermistor/thermistor_502.h"
+#endif
+#if !ANY_THERMISTOR_IS(503)
+  #include "../../module/thermistor/thermistor_503.h"
+#endif
+#if !ANY_THERMISTOR_IS(512)
+  #include "../../module/thermistor/thermistor_512.h"
+#endif
+#if !ANY_THERMISTOR_IS(666)
+  #include "../../module/thermistor/thermistor_666.h"
+#endif
+#if !ANY_THERMISTOR_IS(998)
+  #include "../../module/thermistor/thermistor_998.h"
+#endif
+#if !ANY_THERMISTOR_IS(999)
+  #include "../../module/thermistor/thermistor_999.h"
+#endif
+#if !ANY_THERMISTOR_IS(1010)
+  #include "../../module/thermistor/thermistor_1010.h"
+#endif
+#if !ANY_THERMISTOR_IS(1047)
+  #include "../../module/thermistor/thermistor_1047.h"
+#endif
+#if !ANY_THERMISTOR_IS(2000)
+  #include "../../module/thermistor/thermistor_2000.h"
+#endif
+
+template<const temp_entry_t *TBL, uint8_t LEN>
+static celsius_float_t scan_thermistor_table(const int16_t raw) { SCAN_THERMISTOR_TABLE(TBL, LEN); }
+
+template<const temp_entry_t *TBL, uint8_t LEN>
+static celsius_float_t lookup_thermistor_table(const int16_t raw) { LOOKUP_THERMISTOR_TABLE(TBL, LEN); }
+
+/**
+ * Compare the direct-index lookup with the table search for every raw value.
+ * Entries are rounded to 1/16°, so the lookup may be off by up to 1/32°.
+ */
+template<const temp_entry_t *TBL, uint8_t LEN>
+static bool check_thermistor_table(const int n, double &scan_ns, double &lookup_ns) {
+  float max_err = 0;
+  int32_t max_err_raw = 0;
+  uint16_t scan_cells = 0;
+  bool ok = true;
+  for (int32_t raw = 0; raw <= int32_t(MAX_RAW_THERMISTOR_VALUE); raw++) {
+    const float err = ABS(lookup_thermistor_table<TBL, LEN>(raw) - scan_thermistor_table<TBL, LEN>(raw));
+    if (err > 1.0f / 32 + 1e-4f) {
+      if (ok) printf("Mismatch in table %d at raw %d: %.4f / %.4f\n", n, int(raw), lookup_thermistor_table<TBL, LEN>(raw), scan_thermistor_table<TBL, LEN>(raw));
+      ok = false;
+    }
+    if (err > max_err) { max_err = err; max_err_raw = raw; }
+  }
+  const thermistor_index_t &t = *thermistor_index<TBL, LEN>();
+  for (uint16_t i = 0; i < THERMISTOR_INDEX_LEN; i++) if (TEST(t.scan[i >> 3], i & 7)) scan_cells++;
+
+  auto time_ns = [](auto fn) {
+    volatile float sink = 0;
+    const uint64_t start = Benchmark::host_nanos();
+    for (uint8_t pass = 0; pass < 8; pass++)
+      for (int32_t raw = 0; raw <= int32_t(MAX_RAW_THERMISTOR_VALUE); raw++) sink = sink + fn(raw);
+    return double(Benchmark::host_nanos() - start) / (8 * (MAX_RAW_THERMISTOR_VALUE + 1));
+  };
+  scan_ns += time_ns(scan_thermistor_table<TBL, LEN>);
+  lookup_ns += time_ns(lookup_thermistor_table<TBL, LEN>);
+
+  printf("Table %-16d: %3u entries, %2u searched cells, max error %.4f° at raw %d%s\n", n, LEN, scan_cells, max_err, int(max_err_raw), ok ? "" : " FAILED");
+  return ok;
+}
+
+static int thermistor_benchmark() {
+  unsigned tables = 0, failures = 0;
+  double scan_ns = 0, lookup_ns = 0;
+  #define _CHECK_TABLE(N) tables++; if (!check_thermistor_table<temptable_##N, COUNT(temptable_##N)>(N, scan_ns, lookup_ns)) failures++;
+  THERMISTOR_TABLES(_CHECK_TABLE)
+  printf("%-22s: %u\n", "Tables", tables);
+  printf("%-22s: %u\n", "Failures", failures);
+  printf("%-22s: %.1f ns (table search %.1f ns)\n", "Direct index lookup", lookup_ns / tables, scan_ns / tables);
+  printf("%-22s: %u bytes per table\n", "Index size", unsigned(sizeof(thermistor_index_t)));
+  return failures ? 1 : 0;
+}
+
+#if ENABLED(INPUT_SHAPING_X)
+
+// Position of a simulated axis after each of its steps
+struct axis_trace_t {
+  std::vector<uint64_t> time;
+  std::vector<int32_t> position;
+  int32_t start;
+
+  // The position at time t, after all steps up to and including t
+  int32_t at(const uint64_t t) const {
+    const size_t n = std::upper_bound(time.begin(), time.end(), t) - time.begin();
+    return n ? position[n - 1] : start;
+  }
+};
+
+// Follow the X and Y LinearAxis through their step pins. A pause of 200ms or more starts a new move.
+class ShapingTrace : public IOLogger {
+public:
+  std::vector<axis_trace_t> x, y;
+
+  ShapingTrace() : x_axis(axis(X_STEP_PIN)), y_axis(axis(Y_STEP_PIN)), x_pos(x_axis->position), y_pos(y_axis->position), last(0) {}
+
+  // Position of the X motor, which may be ahead of the last logged step
+  int32_t x_motor() const { return x_axis->position; }
+
+  // Called after the axis has taken the step, so a move starts from the positions logged before it
+  void log(GpioEvent ev) {
+    if (ev.event != GpioEvent::RISE || (ev.pin_id != X_STEP_PIN && ev.pin_id != Y_STEP_PIN)) return;
+    if (x.empty() || ev.timestamp - last >= 200000000ULL) {
+      x.push_back({ {}, {}, x_pos });
+      y.push_back({ {}, {}, y_pos });
+    }
+    last = ev.timestamp;
+    const bool is_x = ev.pin_id == X_STEP_PIN;
+    int32_t &pos = is_x ? x_pos : y_pos;
+    pos = (is_x ? x_axis : y_axis)->position;
+    axis_trace_t &t = (is_x ? x : y).back();
+    t.time.push_back(ev.timestamp);
+    t.position.push_back(pos);
+  }
+
+private:
+  const LinearAxis *x_axis, *y_axis;
+  int32_t x_pos, y_pos;
+  uint64_t last;
+
+  static const LinearAxis* axis(const pin_t step_pin) { return static_cast<const LinearAxis*>(Gpio::pin_map[step_pin].cb); }
+};
+
+/**
+ * Run a diagonal move with each shaper on X only. Y isn't shaped, so it has
+ * the same source steps as X. The X trace must follow the Y trace run through
+ * the shaper's impulses, computed here from the published formulas, and must
+ * end on the same number of steps. The shaper only steps once it's a threshold
+ * behind, and a source step can add up to its largest impulse before it does,
+ * so X may be off by that much, plus a little for the ISR timing.
+ *
+ * A last move is aborted halfway. The motor must stop at once, without the
+ * delayed steps, and the stepper position must still match the motor.
+ */
+static int shaping_test() {
+  constexpr float freq = 40, zeta = 0.1f, steps_per_mm[] = DEFAULT_AXIS_STEPS_PER_UNIT;
+  constexpr char const *names[] = { "ZV", "ZVD", "MZV", "EI" };
+
+  // Equal steps on X and Y give both axes the same Bresenham step stream
+  const float dx = 20, dy = dx * steps_per_mm[X_AXIS] / steps_per_mm[Y_AXIS];
+  std::string gcode = "G92 X0 Y0\n";
+  TERN_(INPUT_SHAPING_Y, gcode += "M593 Y F0\n");
+  LOOP_L_N(type, NUM_SHAPER_TYPES) {
+    char line[96];
+    snprintf(line, sizeof(line), "M593 X F%g D%g T%d\nG1 X%g Y%g F6000\nG4 P300\n", freq, zeta, int(type), type & 1 ? 0 : dx, type & 1 ? 0 : dy);
+    gcode += line;
+  }
+  char line[96];
+  snprintf(line, sizeof(line), "M593 X F%g D%g T%d\nG1 X%g Y%g F6000\nG4 P300\n", freq, zeta, int(SHAPER_EI), dx, dy);
+  gcode += line;
+
+  FILE * const gcode_file = fmemopen(&gcode[0], gcode.size(), "r");
+  VirtualTime::begin(gcode_file, nullptr);
+  static ShapingTrace trace;
+  Gpio::attachLogger(&trace);
+
+  // Abort the last move halfway, noting the motor position and the steps the shaper still owes
+  static int32_t abort_x, abort_lag;
+  static bool aborted;
+  static const int32_t abort_steps = LROUND(dx * steps_per_mm[X_AXIS] / 2);
+  VirtualTime::monitor([](const Heater&, const Heater&) {
+    if (aborted || trace.x.size() <= NUM_SHAPER_TYPES) return;
+    abort_x = trace.x_motor();
+    if (abort_x - trace.x.back().start < abort_steps) return;
+    abort_lag = stepper.position(X_AXIS) - (abort_x - trace.x[0].start);
+    planner.quick_stop();
+    aborted = true;
+  }, 100000);
+
+  while (!VirtualTime::finished()) loop();
+  VirtualTime::end();
+  VirtualTime::monitor(nullptr, 0);
+  Gpio::attachLogger(nullptr);
+  fclose(gcode_file);
+
+  if (trace.x.size() != NUM_SHAPER_TYPES + 1) {
+    printf("Expected %d moves, got %u\n", NUM_SHAPER_TYPES + 1, unsigned(trace.x.size()));
+    return 1;
+  }
+
+  unsigned failures = 0;
+  LOOP_L_N(type, NUM_SHAPER_TYPES) {
+    // Impulses as a fraction of the damped period
+    const double df = sqrt(1 - sq(zeta)), td = 1 / (freq * df), K = exp(-zeta * M_PI / df);
+    double a[3], t[3] = { 0, 0.5 * td, td };
+    uint8_t n = 3;
+    switch (type) {
+      case SHAPER_ZV:  n = 2; a[0] = 1; a[1] = K; break;
+      case SHAPER_ZVD: a[0] = 1; a[1] = 2 * K; a[2] = sq(K); break;
+      case SHAPER_MZV: {
+        const double k = exp(-0.75 * zeta * M_PI / df);
+        a[0] = 1 - M_SQRT1_2; a[1] = (M_SQRT2 - 1) * k; a[2] = a[0] * sq(k);
+        t[1] = 0.375 * td; t[2] = 0.75 * td;
+      } break;
+      case SHAPER_EI:  a[0] = 0.25 * 1.05; a[1] = 0.5 * 0.95 * K; a[2] = a[0] * sq(K); break;
+    }
+    double sum = 0, max_a = 0;
+    LOOP_L_N(i, n) { sum += a[i]; NOLESS(max_a, a[i]); }
+    const double allowed = double(SHAPING_THRESHOLD) / SHAPING_ONE_STEP + max_a / sum + 0.125;
+
+    const axis_trace_t &x = trace.x[type], &y = trace.y[type];
+    std::vector<uint64_t> times = x.time;
+    times.insert(times.end(), y.time.begin(), y.time.end());
+
+    double max_error = 0, max_lag = 0;
+    for (const uint64_t now : times) for (const uint64_t tt : { now - 1, now }) {
+      double shaped = 0;
+      LOOP_L_N(i, n) {
+        const uint64_t delay = uint64_t(uint32_t(t[i] * (STEPPER_TIMER_RATE))) * 1000000000ULL / (STEPPER_TIMER_RATE);
+        shaped += a[i] / sum * (tt >= delay ? y.at(tt - delay) - y.start : 0);
+      }
+      NOLESS(max_error, ABS(x.at(tt) - x.start - shaped));
+      NOLESS(max_lag, ABS((x.at(tt) - x.start) - (y.at(tt) - y.start)));
+    }
+
+    const int32_t x_steps = x.position.back() - x.start, y_steps = y.position.back() - y.start;
+    const bool ok = x_steps == y_steps && y_steps && max_error <= allowed && max_lag >= 10;
+    if (!ok) failures++;
+    printf("%-22s: %ld / %ld steps, max error %.2f steps (%.2f allowed), max lag %.0f steps%s\n",
+      names[type], long(x_steps), long(y_steps), max_error, allowed, max_lag, ok ? "" : " FAILED");
+  }
+
+  // G92 X0 started the count at the motor position before the first move
+  const int32_t stop_x = trace.x_motor(), count_error = stepper.position(X_AXIS) - (stop_x - trace.x[0].start);
+  const bool ok = aborted && abort_lag > 0 && stop_x == abort_x && !count_error;
+  if (!ok) failures++;
+  printf("%-22s: %ld steps owed, %ld steps after abort, position off by %ld%s\n",
+    "Aborted move", long(abort_lag), long(stop_x - abort_x), long(count_error), ok ? "" : " FAILED");
+
+  printf("%-22s: %u\n", "Failures", failures);
+  return failures ? 1 : 0;
+}
+
+#endif // INPUT_SHAPING_X
+
+#if ENABLED(BINARY_GCODE)
+
+static bool read_file(const char * const path, std::string &out) {
+  FILE * const f = fopen(path, "rb");
+  if (!f) { perror(path); return false; }
+  char buf[4096];
+  for (size_t n; (n = fread(buf, 1, sizeof(buf), f)) > 0;) out.append(buf, n);
+  fclose(f);
+  return true;
+}
+
+// What the parser gets from a line: the command and the value of each parameter
+static std::string parsed_command(std::string line OPTARG(PARSE_AT_ENQUEUE, const parsed_command_t * const pre=nullptr)) {
+  char * const p = &line[0];
+  #if ENABLED(PARSE_AT_ENQUEUE)
+    if (pre) parser.load_preparsed(p, *pre); else
+  #endif
+      parser.parse(p);
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%c%u.%u", parser.command_letter, unsigned(parser.codenum), unsigned(TERN0(USE_GCODE_SUBCODES, parser.subcode)));
+  std::string out = buf;
+  for (char c = 'A'; c <= 'Z'; c++) if (parser.seen(c)) {
+    if (parser.has_value())
+      snprintf(buf, sizeof(buf), " %c%.9g", c, parser.value_float() + 0.0f); // No -0
+    else
+      snprintf(buf, sizeof(buf), " %c", c);
+    out += buf;
+  }
+  parser.reset();
+  return out;
+}
+
+/**
+ * Feed the records of a binary G-code file to the command queue, as SD printing
+ * does, and compare each queued line with the command from the source file. The
+ * text can differ (e.g., "X1.50" becomes "X1.5"), so lines that don't match are
+ * compared as parsed. With PARSE_AT_ENQUEUE the values the decoder filled in must
+ * also match the parsed text.
+ */
+static int binary_gcode_test(const char * const bin_path, const char * const gcode_path) {
+  std::string bin, text;
+  if (!read_file(bin_path, bin) || !read_file(gcode_path, text)) return 1;
+
+  // The source commands, with comments and blank lines dropped as the firmware reads them
+  std::vector<std::string> source;
+  for (size_t pos = 0; pos < text.size();) {
+    size_t eol = text.find('\n', pos);
+    if (eol == std::string::npos) eol = text.size();
+    std::string line = text.substr(pos, eol - pos);
+    pos = eol + 1;
+    line = line.substr(0, line.find(';'));
+    while (!line.empty() && (line.back() == ' ' || line.back() == '\r')) line.pop_back();
+    if (!line.empty()) source.push_back(line);
+  }
+
+  queue.clear();
+  unsigned records = 0, failures = 0;
+  size_t n = 0;
+  for (size_t pos = 0; pos < bin.size();) {
+    const uint8_t * const rec = (const uint8_t*)&bin[pos];
+    if (!BinaryGCode::is_record(*rec)) {            // Skip a text line, the header comment
+      const size_t eol = bin.find('\n', pos);
+      pos = eol == std::string::npos ? bin.size() : eol + 1;
+      continue;
+    }
+    if (pos + BinaryGCode::HEADER_SIZE > bin.size() || pos + BinaryGCode::record_size(rec) > bin.size()) {
+      printf("Record cut short at byte %u\n", unsigned(pos));
+      failures++;
+      break;
+    }
+    pos += BinaryGCode::record_size(rec);
+    records++;
+
+    queue.ring_buffer.enqueue_binary(rec);
+    if (queue.ring_buffer.empty()) {                // Dropped as corrupt
+      if (++failures <= 10) printf("Bad record %u\n", records);
+      n++;
+      continue;
+    }
+    const std::string line = queue.ring_buffer.peek_next_command_string();
+    #if ENABLED(PARSE_AT_ENQUEUE)
+      const parsed_command_t &pre = queue.ring_buffer.peek_next_command().parsed;
+    #endif
+    queue.ring_buffer.advance_pos(queue.ring_buffer.index_r, -1);
+
+    const std::string src = n < source.size() ? source[n] : "";
+    n++;
+    bool ok = line == src || parsed_command(line) == parsed_command(src);
+    #if ENABLED(PARSE_AT_ENQUEUE)
+      if (pre.command_letter && parsed_command(line, &pre) != parsed_command(line)) ok = false;
+    #endif
+    if (!ok && ++failures <= 10) printf("Mismatch in record %u: \"%s\" from \"%s\"\n", records, line.c_str(), src.c_str());
+  }
+  if (n != source.size()) {
+    printf("%u records for %u commands\n", unsigned(n), unsigned(source.size()));
+    failures++;
+  }
+
+  printf("%-22s: %u\n", "Records", records);
+  printf("%-22s: %u\n", "Failures", failures);
+  return failures ? 1 : 0;
+}
+
+#endif // BINARY_GCODE
+
+/**
+ * Heater response to each target set by the G-code
+ *
+ * A segment runs from one target change to the next. It has settled once the
+ * reading stays within HEATER_SETTLE_BAND of the target for HEATER_SETTLE_HOLD
+ * samples. Overshoot is how far the reading (and the simulated block) passed
+ * the target in the direction of the change. Deviation and RMS error cover
+ * the rest of the segment, so they show how well the target holds against
+ * the fan and extrusion loads in the scenario.
+ */
+#define HEATER_SAMPLE_NS   100000000ULL // 100ms
+#define HEATER_SETTLE_BAND 1.0f
+#define HEATER_SETTLE_HOLD 100          // 10s
+
+struct heater_sample_t { float target, reading, block; };
+static std::vector<heater_sample_t> hotend_samples, bed_samples;
+
+static void sample_heaters(const Heater &hotend, const Heater &bed) {
+  hotend_samples.push_back({ float(thermalManager.degTargetHotend(0)), float(thermalManager.degHotend(0)), float(hotend.block_temp) });
+  #if HAS_HEATED_BED
+    bed_samples.push_back({ float(thermalManager.degTargetBed()), float(thermalManager.degBed()), float(bed.block_temp) });
+  #else
+    UNUSED(bed);
+  #endif
+}
+
+static void report_heater(const char * const name, const std::vector<heater_sample_t> &samples) {
+  constexpr double dt = HEATER_SAMPLE_NS / 1e9;
+  for (size_t start = 0, end; start < samples.size(); start = end) {
+    const float target = samples[start].target;
+    for (end = start + 1; end < samples.size() && samples[end].target == target; end++) { /* nada */ }
+    if (!target || end - start < 2) continue;
+
+    const float from = samples[start].reading, dir = target >= from ? 1 : -1;
+    float overshoot = 0, block_overshoot = 0, deviation = 0;
+    size_t settled = end;
+    for (size_t i = start, in_band = 0; i < end && settled == end; i++) {
+      in_band = ABS(samples[i].reading - target) <= HEATER_SETTLE_BAND ? in_band + 1 : 0;
+      if (in_band == HEATER_SETTLE_HOLD || (in_band && i == end - 1)) settled = i + 1 - in_band;
+    }
+    double sum_sq = 0;
+    for (size_t i = start; i < end; i++) {
+      NOLESS(overshoot, (samples[i].reading - target) * dir);
+      NOLESS(block_overshoot, (samples[i].block - target) * dir);
+      if (i >= settled) {
+        NOLESS(deviation, ABS(samples[i].reading - target));
+        sum_sq += sq(samples[i].reading - target);
+      }
+    }
+
+    printf("%-6s %5.0f -> %3.0f : ", name, from, target);
+    if (settled < end)
+      printf("settled %6.1f s, overshoot %5.2f (block %5.2f), max deviation %4.2f, RMS %4.2f over %.0f s\n",
+        (settled - start) * dt, overshoot, block_overshoot, deviation, SQRT(sum_sq / (end - settled)), (end - settled) * dt);
+    else
+      printf("not settled in %.1f s, overshoot %5.2f (block %5.2f), final error %.2f\n",
+        (end - start) * dt, overshoot, block_overshoot, samples[end - 1].reading - target);
+  }
+}
+
+int Benchmark::run(int argc, char *argv[]) {
+  const char *path = nullptr;
+  bool verbose = false, heaters = false;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--numbers"))
+      return number_benchmark();
+    else if (!strcmp(argv[i], "--thermistors"))
+      return thermistor_benchmark();
+    else if (!strcmp(argv[i], "--shaping")) {
+      #if ENABLED(INPUT_SHAPING_X)
+        return shaping_test();
+      #else
+        fprintf(stderr, "--shaping requires INPUT_SHAPING_X\n");
+        return 1;
+      #endif
+    }
+    else if (!strcmp(argv[i], "--binary-gcode")) {
+      #if ENABLED(BINARY_GCODE)
+        if (i + 2 < argc) return binary_gcode_test(argv[i + 1], argv[i + 2]);
+        fprintf(stderr, "--binary-gcode needs a binary G-code file and its source\n");
+      #else
+        fprintf(stderr, "--binary-gcode requires BINARY_GCODE\n");
+      #endif
+      return 1;
+    }
+    else if (!strcmp(argv[i], "-v"))
+      verbose = true;
+    else if (!strcmp(argv[i], "--heaters"))
+      heaters = true;
+    else
+      path = argv[i];
+  }
+  if (!path) {
+    fprintf(stderr, "Usage: %s [-v] [--heaters] <file.gcode> | --numbers | --thermistors | --shaping | --binary-gcode <file.bgcode> <file.gcode>\n", argv[0]);
+    return 1;
+  }
+  FILE * const gcode_file = fopen(path, "r");
+  if (!gcode_file) {
+    perror(path);
+    return 1;
+  }
+
+  calibrate_excluded_overhead();
+  VirtualTime::begin(gcode_file, verbose ? stderr : nullptr);
+  if (heaters) VirtualTime::monitor(sample_heaters, HEATER_SAMPLE_NS);
+
+  const uint64_t host_start = host_nanos(), sim_start = Clock::nanos();
+
+  while (!VirtualTime::finished()) loop();
+  VirtualTime::end();
+
+  const uint64_t host_ns = host_nanos() - host_start, sim_ns = Clock::nanos() - sim_start,
+                 planner_ns = populate.total_ns + recalculate.total_ns;
+  fclose(gcode_file);
+
+  printf("%-22s: %s\n", "File", path);
+  printf("%-22s: %u\n", "Lines", VirtualTime::lines);
+  printf("%-22s: %llu\n", "Commands", (unsigned long long)command.count);
+  printf("%-22s: %.0f commands/s\n", "Command throughput", command.total_ns ? command.count * 1e9 / command.total_ns : 0.0);
+  printf("%-22s: %.3f us avg, %.3f us max\n", "process_next_command()", command.average_us(), command.max_us());
+  printf("%-22s: %llu\n", "Blocks planned", (unsigned long long)recalculate.count);
+  printf("%-22s: %.0f blocks/s\n", "Planner throughput", planner_ns ? recalculate.count * 1e9 / planner_ns : 0.0);
+  printf("%-22s: %.3f us avg, %.3f us max\n", "_populate_block()", populate.average_us(), populate.max_us());
+  printf("%-22s: %.3f us avg, %.3f us max\n", "recalculate()", recalculate.average_us(), recalculate.max_us());
+  printf("%-22s: %llu calls, %.3f us avg\n", "Stepper ISR", (unsigned long long)step_isr.count, step_isr.average_us());
+  printf("%-22s: %llu calls, %.3f us avg, %.3f us max\n", "Temperature ISR", (unsigned long long)temp_isr.count, temp_isr.average_us(), temp_isr.max_us());
+  printf("%-22s: %u\n", "Buffer underruns", VirtualTime::underruns);
+  print_time("Motion time", VirtualTime::motion_ns);
+  print_time("Simulated print time", sim_ns);
+  printf("%-22s: %.3f s (%.1fx realtime)\n", "Host time", host_ns / 1e9, host_ns ? double(sim_ns) / host_ns : 0.0);
+  if (heaters) {
+    report_heater("Hotend", hotend_samples);
+    report_heater("Bed", bed_samples);
+  }
+  fflush(stdout);
+
+  return 0;
+}
+
+#endif // PLANNER_BENCHMARK
+#endif // __PLAT_LINUX__
@@ -0,0 +1,113 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * Planner / Stepper throughput benchmark (linux_native_benchmark)
+ *
+ * Runs a G-code file through the firmware on the virtual clock and reports
+ * command and planner throughput, recalculate() cost, buffer underruns, and
+ * the total simulated print time.
+ */
+
+#include <stdint.h>
+#include <chrono>
+
+// Host time spent in a section of code
+struct bench_stat_t {
+  uint64_t count, total_ns, max_ns;
+  void add(const uint64_t ns) {
+    count++;
+    total_ns += ns;
+    if (ns > max_ns) max_ns = ns;
+  }
+  double average_us() const { return count ? total_ns / 1000.0 / count : 0; }
+  double max_us() const { return max_ns / 1000.0; }
+};
+
+class Benchmark {
+  public:
+    static bench_stat_t populate,     // Planner::_populate_block
+                        recalculate,  // Planner::recalculate
+                        step_isr,     // Stepper ISR
+                        temp_isr,     // Temperature ISR
+                        command;      // GcodeSuite::process_next_command, less idle() and the planner
+
+    static uint64_t excluded_ns,      // Host time in idle() and the planner
+                    excluded_count;   // Number of those sections
+    static uint8_t excluded_depth;    // Nested excluded sections
+    static double excluded_overhead_ns; // Host time each excluded section adds outside itself
+
+    static uint64_t host_nanos() {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static int run(int argc, char *argv[]);
+};
+
+extern Benchmark benchmark;
+
+// Measure host time from here to the end of the enclosing scope
+class BenchmarkScope {
+  public:
+    BenchmarkScope(bench_stat_t &s) : stat(s), start(Benchmark::host_nanos()) {}
+    ~BenchmarkScope() { stat.add(Benchmark::host_nanos() - start); }
+  private:
+    bench_stat_t &stat;
+    const uint64_t start;
+};
+
+// Measure host time to the end of the enclosing scope, less the time spent in
+// idle() and the planner, so a command is charged only for its own work. A move
+// waiting for the planner may call idle() thousands of times, so the cost of
+// timing each of those calls is taken off too.
+class BenchmarkBusyScope {
+  public:
+    BenchmarkBusyScope(bench_stat_t &s) : stat(s), start(Benchmark::host_nanos()),
+      excluded_start(Benchmark::excluded_ns), count_start(Benchmark::excluded_count) {}
+    ~BenchmarkBusyScope() {
+      const uint64_t ns = Benchmark::host_nanos() - start - (Benchmark::excluded_ns - excluded_start),
+                     overhead = (Benchmark::excluded_count - count_start) * Benchmark::excluded_overhead_ns;
+      stat.add(ns > overhead ? ns - overhead : 0);
+    }
+  private:
+    bench_stat_t &stat;
+    const uint64_t start, excluded_start, count_start;
+};
+
+// Add the host time of the outermost excluded section to Benchmark::excluded_ns
+class BenchmarkExcludeScope {
+  public:
+    BenchmarkExcludeScope() : start(Benchmark::excluded_depth++ ? 0 : Benchmark::host_nanos()) {}
+    ~BenchmarkExcludeScope() {
+      if (--Benchmark::excluded_depth) return;
+      Benchmark::excluded_ns += Benchmark::host_nanos() - start;
+      Benchmark::excluded_count++;
+    }
+  private:
+    const uint64_t start;
+};
+
+// A planner section, timed on its own and left out of the command time
+#define BENCHMARK_SCOPE(S) const BenchmarkExcludeScope _bench_exclude; const BenchmarkScope _bench_scope(Benchmark::S)
+#define BENCHMARK_BUSY_SCOPE(S) const BenchmarkBusyScope _bench_scope(Benchmark::S)
+#define BENCHMARK_IDLE_SCOPE() const BenchmarkExcludeScope _bench_exclude
@@ -45,6 +45,8 @@ public:
 
   // Time Acceleration compensated
   static uint64_t nanos() {
+    // Reading the virtual clock takes no time. It only moves on delays, busy-waits and idle.
+    if (virtual_time) return virtual_nanos;
     auto now = std::chrono::high_resolution_clock::now().time_since_epoch();
     return (now.count() - Clock::startup.count()) * Clock::time_multiplier;
   }
@@ -62,18 +64,22 @@ public:
   }
 
   static void delayCycles(uint64_t cycles) {
+    if (virtual_time) return advance((1000000000L / frequency) * cycles);
     std::this_thread::sleep_for(std::chrono::nanoseconds( (1000000000L / frequency) * cycles) / Clock::time_multiplier );
   }
 
   static void delayMicros(uint64_t micros) {
+    if (virtual_time) return advance(micros * 1000);
     std::this_thread::sleep_for(std::chrono::microseconds( micros ) / Clock::time_multiplier);
   }
 
   static void delayMillis(uint64_t millis) {
+    if (virtual_time) return advance(millis * 1000000);
     std::this_thread::sleep_for(std::chrono::milliseconds( millis ) / Clock::time_multiplier);
   }
 
   static void delaySeconds(double secs) {
+    if (virtual_time) return advance(secs * 1000000000);
     std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(secs * 1000) / Clock::time_multiplier);
   }
 
@@ -82,8 +88,28 @@ public:
     Clock::time_multiplier = tm;
   }
 
+  // Virtual time starts at zero and only moves when the simulation advances it
+  static void useVirtualTime() {
+    Clock::virtual_time = true;
+    Clock::virtual_nanos = 0;
+  }
+
+  static bool isVirtual() {
+    return Clock::virtual_time;
+  }
+
+  static void advance(uint64_t ns) {
+    Clock::virtual_nanos += ns;
+  }
+
+  static void advanceTo(uint64_t ns) {
+    if (ns > Clock::virtual_nanos) Clock::virtual_nanos = ns;
+  }
+
 private:
   static std::chrono::nanoseconds startup;
   static uint32_t frequency;
   static double time_multiplier;
+  static bool virtual_time;
+  static uint64_t virtual_nanos;
 };
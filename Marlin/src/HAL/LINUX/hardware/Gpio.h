@@ -51,6 +51,7 @@ class IOLogger {
 public:
   virtual ~IOLogger(){};
   virtual void log(GpioEvent ev) = 0;
+  virtual void flush() {}
 };
 
 class Peripheral {
@@ -136,6 +137,10 @@ public:
     Gpio::logger = logger;
   }
 
+  static void flushLogger() {
+    if (Gpio::logger) Gpio::logger->flush();
+  }
+
 private:
   static IOLogger* logger;
 };
@@ -22,35 +22,98 @@
 #ifdef __PLAT_LINUX__
 
 #include "Clock.h"
-#include <stdio.h>
+#include <math.h>
 #include "../../../inc/MarlinConfig.h"
 
 #include "Heater.h"
 
-Heater::Heater(pin_t heater, pin_t adc) {
-  heater_state = 0;
-  room_temp_raw = 150;
-  last = Clock::micros();
-  heater_pin = heater;
-  adc_pin = adc;
-  heat = 0.0;
+#if TEMP_SENSOR_0 == 1000
+  #define SIM_HOTEND_THERMISTOR HOTEND0_PULLUP_RESISTOR_OHMS, HOTEND0_RESISTANCE_25C_OHMS, HOTEND0_BETA
+#else
+  #define SIM_HOTEND_THERMISTOR 4700, 100000, 3950
+#endif
+#if TEMP_SENSOR_BED == 1000
+  #define SIM_BED_THERMISTOR BED_PULLUP_RESISTOR_OHMS, BED_RESISTANCE_25C_OHMS, BED_BETA
+#else
+  #define SIM_BED_THERMISTOR 4700, 100000, 3950
+#endif
+
+// An E3D V6 style hotend with a 40W cartridge
+const HeaterModel Heater::hotend_model = { 40, 16.7, 0.068, 0.029, 5.6e-3, 2.0, 25, SIM_HOTEND_THERMISTOR };
+
+// A 220x220mm aluminium bed with a 220W heater
+const HeaterModel Heater::bed_model = { 220, 550, 1.8, 0, 0, 4.0, 25, SIM_BED_THERMISTOR };
+
+Heater::Heater(pin_t heater, pin_t adc, const HeaterModel &model, const temp_entry_t *table, const uint8_t table_len)
+  : heater_pin(heater), adc_pin(adc), fan_pin(P_NC), model(model),
+    block_temp(model.ambient), sensor_temp(model.ambient),
+    table(table_len > 1 ? table : nullptr), table_len(table_len),
+    extruder(nullptr), e_steps_per_mm(0), e_last(0), last(Clock::nanos()) {
+  Gpio::pin_map[analogInputToDigitalPin(adc_pin)].value = adc_value(sensor_temp);
 }
 
 Heater::~Heater() {
 }
 
+void Heater::attach_extruder(const LinearAxis *axis) {
+  constexpr float steps_per_mm[] = DEFAULT_AXIS_STEPS_PER_UNIT;
+  extruder = axis;
+  e_steps_per_mm = steps_per_mm[E_AXIS];
+  e_last = axis->position;
+}
+
+// Duty of a pin driven by WRITE (0 / 1) or analogWrite (0 - 255)
+double Heater::duty(const pin_t pin) {
+  if (!Gpio::valid_pin(pin)) return 0;
+  const uint16_t v = Gpio::pin_map[pin].value;
+  return v > 1 ? _MIN(v, 255) / 255.0 : v;
+}
+
+// The 12-bit ADC reading for a sensor temperature
+uint16_t Heater::adc_value(const double celsius) const {
+  double raw;   // Oversampled, as in the thermistor tables
+  if (table) {
+    // Interpolate the raw value between the two entries around the temperature
+    uint8_t i = 1;
+    const bool rising = table[table_len - 1].celsius > table[0].celsius;
+    while (i < table_len - 1 && (rising ? table[i].celsius < celsius : table[i].celsius > celsius)) i++;
+    const temp_entry_t &a = table[i - 1], &b = table[i];
+    const double t = b.celsius == a.celsius ? 0 : constrain((celsius - a.celsius) / double(b.celsius - a.celsius), 0.0, 1.0);
+    raw = a.value + t * (b.value - a.value);
+  }
+  else {
+    // Beta thermistor to ground with a pullup, as for custom thermistors
+    const double r = model.r25 * exp(model.beta * (1.0 / (celsius + 273.15) - 1.0 / (25 + 273.15)));
+    raw = r / (r + model.pullup) * (MAX_RAW_THERMISTOR_VALUE + 1);
+  }
+  return constrain(raw * 4 / ((OVERSAMPLENR) * (THERMISTOR_TABLE_SCALE)) + 0.5, 0.0, 4095.0);
+}
+
 void Heater::update() {
-  // crude pwm read and cruder heat simulation
-  auto now = Clock::micros();
-  double delta = (now - last);
-  if (delta > 1000 ) {
-    heater_state = pwmcap.update(0xFFFF * Gpio::pin_map[heater_pin].value);
-    last = now;
-    heat += (heater_state - heat) * (delta / 1000000000.0);
-
-    NOLESS(heat, room_temp_raw);
-    Gpio::pin_map[analogInputToDigitalPin(adc_pin)].value = 0xFFFF - (uint16_t)heat;
+  const uint64_t now = Clock::nanos();
+  if (now == last) return;
+  const double dt = (now - last) * 1e-9;
+  last = now;
+
+  // New filament fed through the block since the last update. Retracted filament
+  // has already been heated, so only motion past the furthest position counts.
+  double e_mm = 0;
+  if (extruder && extruder->position > e_last) {
+    e_mm = (extruder->position - e_last) / e_steps_per_mm;
+    e_last = extruder->position;
   }
+
+  // The pins hold their state since the last update. Step in 10ms or less to keep Euler stable.
+  const double power = duty(heater_pin) * model.heater_power,
+               xfer = model.ambient_xfer + duty(fan_pin) * model.fan_xfer + model.filament_heat * e_mm / dt;
+  const int steps = ceil(dt / 0.01);
+  const double h = dt / steps;
+  for (int i = 0; i < steps; i++) {
+    block_temp += (power - xfer * (block_temp - model.ambient)) * h / model.heat_capacity;
+    sensor_temp += (block_temp - sensor_temp) * h / model.sensor_lag;
+  }
+
+  Gpio::pin_map[analogInputToDigitalPin(adc_pin)].value = adc_value(sensor_temp);
 }
 
 void Heater::interrupt(GpioEvent ev) {
@@ -21,27 +21,67 @@
  */
 #pragma once
 
+/**
+ * Lumped thermal model of a heater block
+ *
+ * The block is one thermal mass, heated by the duty cycle of the heater pin
+ * and losing heat to the room, to the part cooling fan, and to the filament
+ * pushed through it. The sensor follows the block with a first-order lag and
+ * is read through the same thermistor table the firmware uses.
+ *
+ *   C * dT/dt = P * duty - (h + h_fan * fan) * (T - T_amb) - c_fil * e_rate * (T - T_amb)
+ *   dT_s/dt   = (T - T_s) / lag
+ */
+
 #include "Gpio.h"
+#include "LinearAxis.h"
+#include "../../../module/thermistor/thermistors.h"
 
-struct LowpassFilter {
-  uint64_t data_delay = 0;
-  uint16_t update(uint16_t value) {
-    data_delay = data_delay - (data_delay >> 6) + value;
-    return (uint16_t)(data_delay >> 6);
-  }
+struct HeaterModel {
+  double heater_power,        // (W)     Power at full duty
+         heat_capacity,       // (J/K)   Heat capacity of the block
+         ambient_xfer,        // (W/K)   Heat lost to still air
+         fan_xfer,            // (W/K)   Extra heat lost with the part cooling fan at full speed
+         filament_heat,       // (J/K/mm) Heat taken by each mm of filament brought up to temperature
+         sensor_lag,          // (s)     Time constant of the sensor following the block
+         ambient;             // (°C)    Room temperature
+  // Thermistor for sensors without a conversion table (e.g., 1000)
+  double pullup, r25, beta;
 };
 
 class Heater: public Peripheral {
 public:
-  Heater(pin_t heater, pin_t adc);
+  static const HeaterModel hotend_model, bed_model;
+
+  Heater(pin_t heater, pin_t adc, const HeaterModel &model=hotend_model, const temp_entry_t *table=nullptr, const uint8_t table_len=0);
   virtual ~Heater();
   void interrupt(GpioEvent ev);
   void update();
 
-  pin_t heater_pin, adc_pin;
-  uint16_t room_temp_raw;
-  uint16_t heater_state;
-  LowpassFilter pwmcap;
-  double heat;
+  // Part cooling fan (analogWrite 0-255) and extruder that load this heater
+  void attach_fan(const pin_t fan) { fan_pin = fan; }
+  void attach_extruder(const LinearAxis *axis);
+
+  pin_t heater_pin, adc_pin, fan_pin;
+  HeaterModel model;
+  double block_temp, sensor_temp;   // (°C)
+
+private:
+  const temp_entry_t *table;
+  uint8_t table_len;
+  const LinearAxis *extruder;
+  double e_steps_per_mm;
+  int32_t e_last;                   // Furthest extruder position so far
   uint64_t last;
+
+  static double duty(const pin_t pin);
+  uint16_t adc_value(const double celsius) const;
 };
+
+// Heater models for the configured hotend and bed sensors
+#define HOTEND_SIM(H,A) H, A, Heater::hotend_model, TEMPTABLE_0, TEMPTABLE_0_LEN
+#ifdef TEMPTABLE_BED
+  #define BED_SIM(H,A) H, A, Heater::bed_model, TEMPTABLE_BED, TEMPTABLE_BED_LEN
+#else
+  #define BED_SIM(H,A) H, A, Heater::bed_model
+#endif
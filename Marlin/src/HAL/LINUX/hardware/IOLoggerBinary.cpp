@@ -0,0 +1,139 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#ifdef __PLAT_LINUX__
+
+#include "IOLoggerBinary.h"
+#include <string.h>
+
+static void write_le(FILE *f, uint32_t value, uint8_t bytes) {
+  for (; bytes; bytes--, value >>= 8) fputc(value & 0xFF, f);
+}
+
+IOLoggerBinary::IOLoggerBinary(const char *filename, const Axis *axes, uint8_t axis_count) {
+  file = fopen(filename, "wb");
+  ring = new Cell[ring_size];
+  for (size_t i = 0; i < ring_size; i++) ring[i].sequence.store(i, std::memory_order_relaxed);
+  write_pos = 0;
+  read_pos = 0;
+  dropped = 0;
+  bitmap = 0;
+  last_timestamp = 0;
+
+  // Each axis traces its step and dir pins
+  memset(pin_bit, -1, sizeof(pin_bit));
+  if (axis_count > 16) axis_count = 16;
+  pin_count = axis_count * 2;
+
+  if (!file) {
+    perror(filename);
+    return;
+  }
+
+  fputs("MSTR", file);
+  write_le(file, version, 1);
+  write_le(file, pin_count, 1);
+  write_le(file, axis_count, 1);
+  write_le(file, 0, 1);
+  for (uint8_t i = 0; i < axis_count; i++) {
+    write_le(file, axes[i].step_pin, 2);
+    write_le(file, axes[i].dir_pin, 2);
+  }
+  for (uint8_t i = 0; i < axis_count; i++) {
+    uint32_t spu;
+    memcpy(&spu, &axes[i].steps_per_unit, sizeof(spu));
+    write_le(file, axes[i].name, 1);
+    write_le(file, i * 2, 1);
+    write_le(file, i * 2 + 1, 1);
+    write_le(file, 0, 1);
+    write_le(file, spu, 4);
+    if (Gpio::valid_pin(axes[i].step_pin)) pin_bit[axes[i].step_pin] = i * 2;
+    if (Gpio::valid_pin(axes[i].dir_pin)) pin_bit[axes[i].dir_pin] = i * 2 + 1;
+  }
+}
+
+IOLoggerBinary::~IOLoggerBinary() {
+  flush();
+  if (file) fclose(file);
+  if (dropped) fprintf(stderr, "Step trace: %u events dropped\n", (uint32_t)dropped);
+  delete[] ring;
+}
+
+// Multi-producer queue (Vyukov), safe to call from a signal handler. Never waits on the consumer.
+void IOLoggerBinary::log(GpioEvent ev) {
+  if (!Gpio::valid_pin(ev.pin_id) || pin_bit[ev.pin_id] < 0) return;
+
+  size_t pos = write_pos.load(std::memory_order_relaxed);
+  Cell *cell;
+  for (;;) {
+    cell = &ring[pos & (ring_size - 1)];
+    const intptr_t diff = intptr_t(cell->sequence.load(std::memory_order_acquire)) - intptr_t(pos);
+    if (diff == 0) {
+      if (write_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+    }
+    else if (diff < 0) { // Full
+      dropped++;
+      return;
+    }
+    else
+      pos = write_pos.load(std::memory_order_relaxed);
+  }
+
+  cell->timestamp = ev.timestamp;
+  cell->pin_id = ev.pin_id;
+  cell->event = ev.event;
+  cell->sequence.store(pos + 1, std::memory_order_release);
+}
+
+void IOLoggerBinary::flush() {
+  for (;;) {
+    Cell &cell = ring[read_pos & (ring_size - 1)];
+    if (cell.sequence.load(std::memory_order_acquire) != read_pos + 1) break;
+    write(cell.event, cell.pin_id, cell.timestamp);
+    cell.sequence.store(read_pos + ring_size, std::memory_order_release);
+    read_pos++;
+  }
+}
+
+void IOLoggerBinary::write(const GpioEvent::Type event, const pin_type pin_id, const uint64_t timestamp) {
+  const uint32_t mask = 1UL << pin_bit[pin_id];
+  uint32_t bits = bitmap;
+  switch (event) {
+    case GpioEvent::RISE: case GpioEvent::SET_VALUE: bits |= mask; break;
+    case GpioEvent::FALL: bits &= ~mask; break;
+    default: return;
+  }
+  if (bits == bitmap || !file) return;
+  bitmap = bits;
+
+  // Events from a signal handler may be queued slightly out of order
+  uint64_t delta = timestamp > last_timestamp ? timestamp - last_timestamp : 0;
+  if (timestamp > last_timestamp) last_timestamp = timestamp;
+  do {
+    const uint8_t b = delta & 0x7F;
+    delta >>= 7;
+    fputc(delta ? b | 0x80 : b, file);
+  } while (delta);
+
+  write_le(file, bitmap, (pin_count + 7) / 8);
+}
+
+#endif // __PLAT_LINUX__
@@ -0,0 +1,87 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * Binary step trace
+ *
+ * Events on the traced pins are queued in a lock-free ring buffer, so the
+ * GPIO hooks (which may run in a timer signal handler) never block. flush()
+ * drains the ring to the file from the simulation thread.
+ *
+ * File format (little-endian):
+ *   Header:  "MSTR", uint8 version, uint8 pin count, uint8 axis count, uint8 reserved
+ *            int16 pin id         x pin count
+ *            char name, uint8 step bit, uint8 dir bit, uint8 reserved,
+ *            float steps per unit x axis count
+ *   Records: LEB128 nanoseconds since the previous record,
+ *            bitmap of all traced pins after the event, (pin count + 7) / 8 bytes
+ *
+ * A record is only written when the event changes the bitmap.
+ * See buildroot/share/scripts/step_trace.py to analyze a trace.
+ */
+
+#include <atomic>
+#include <stdio.h>
+#include "Gpio.h"
+
+class IOLoggerBinary: public IOLogger {
+public:
+  struct Axis {
+    char name;
+    pin_type step_pin, dir_pin;
+    float steps_per_unit;
+  };
+
+  IOLoggerBinary(const char *filename, const Axis *axes, uint8_t axis_count);
+  virtual ~IOLoggerBinary();
+  void flush();
+  void log(GpioEvent ev);
+
+  // Events lost to a full ring buffer
+  uint32_t getDropped() { return dropped; }
+
+  static constexpr uint8_t version = 1;
+
+private:
+  static constexpr size_t ring_size = 1 << 16; // Power of 2
+
+  struct Cell {
+    std::atomic<size_t> sequence;
+    uint64_t timestamp;
+    pin_type pin_id;
+    GpioEvent::Type event;
+  };
+
+  void write(const GpioEvent::Type event, const pin_type pin_id, const uint64_t timestamp);
+
+  FILE *file;
+  Cell *ring;
+  std::atomic<size_t> write_pos;
+  size_t read_pos;
+  std::atomic<uint32_t> dropped;
+
+  int8_t pin_bit[Gpio::pin_count + 1]; // Bit in the bitmap, or -1 if not traced
+  uint8_t pin_count;
+  uint32_t bitmap;
+  uint64_t last_timestamp;
+};
@@ -34,10 +34,12 @@ Timer::Timer() {
   period = 0;
   start_time = 0;
   avg_error = 0;
+  due = 0;
+  last_read = UINT64_MAX;
 }
 
 Timer::~Timer() {
-  timer_delete(timerid);
+  if (!Clock::isVirtual()) timer_delete(timerid);
 }
 
 void Timer::init(uint32_t sig_id, uint32_t sim_freq, callback_fn* fn) {
@@ -47,6 +49,8 @@ void Timer::init(uint32_t sig_id, uint32_t sim_freq, callback_fn* fn) {
   frequency = sim_freq;
   cbfn = fn;
 
+  if (Clock::isVirtual()) return;
+
   sa.sa_flags = SA_SIGINFO;
   sa.sa_sigaction = Timer::handler;
   sigemptyset(&sa.sa_mask);
@@ -73,7 +77,7 @@ void Timer::start(uint32_t frequency) {
 }
 
 void Timer::enable() {
-  if (sigprocmask(SIG_UNBLOCK, &mask, nullptr) == -1) {
+  if (!Clock::isVirtual() && sigprocmask(SIG_UNBLOCK, &mask, nullptr) == -1) {
     return; // todo: handle error
   }
   active = true;
@@ -81,13 +85,19 @@ void Timer::enable() {
 }
 
 void Timer::disable() {
-  if (sigprocmask(SIG_SETMASK, &mask, nullptr) == -1) {
+  if (!Clock::isVirtual() && sigprocmask(SIG_SETMASK, &mask, nullptr) == -1) {
     return; // todo: handle error
   }
   active = false;
 }
 
 void Timer::setCompare(uint32_t compare) {
+  if (Clock::isVirtual()) {
+    this->compare = compare;
+    due = start_time + Clock::ticksToNanos(compare, frequency);
+    return;
+  }
+
   uint32_t nsec_offset = 0;
   if (active) {
     nsec_offset = Clock::nanos() - this->start_time; // calculate how long the timer would have been running for
@@ -111,7 +121,13 @@ void Timer::setCompare(uint32_t compare) {
 }
 
 uint32_t Timer::getCount() {
-  return Clock::nanosToTicks(Clock::nanos() - this->start_time, frequency);
+  uint32_t count = Clock::nanosToTicks(Clock::nanos() - this->start_time, frequency);
+  if (Clock::isVirtual()) {
+    // Reading the count again with the clock stopped can only be a busy-wait for it to change, so go to the next tick
+    if (Clock::nanos() == last_read) Clock::advanceTo(start_time + Clock::ticksToNanos(++count, frequency));
+    last_read = Clock::nanos();
+  }
+  return count;
 }
 
 #endif // __PLAT_LINUX__
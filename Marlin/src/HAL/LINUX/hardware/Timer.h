@@ -52,6 +52,14 @@ public:
     return (*(intptr_t*)timerid);
   }
 
+  // With a virtual Clock the timer is not signaled. The simulation calls fire() when it comes due.
+  uint64_t getDue() {return due;}
+  void fire() {
+    start_time = due; // The count restarts on compare match
+    due = start_time + Clock::ticksToNanos(compare > 1 ? compare : 1, frequency);
+    cbfn();
+  }
+
   static void handler(int sig, siginfo_t *si, void *uc) {
     Timer* _this = (Timer*)si->si_value.sival_ptr;
     _this->avg_error += (Clock::nanos() - _this->start_time) - _this->period; //high_resolution_clock is also limited in precision, but best we have
@@ -73,4 +81,6 @@ private:
   uint64_t period;
   uint64_t avg_error;
   uint64_t start_time;
+  uint64_t due;
+  uint64_t last_read; // Virtual time of the last getCount()
 };
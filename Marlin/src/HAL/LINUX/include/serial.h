@@ -75,7 +75,7 @@ private:
 };
 
 struct HalSerial {
-  HalSerial() { host_connected = true; }
+  HalSerial() { host_connected = true; direct = false; direct_out = nullptr; }
 
   void begin(int32_t) {}
   void end()          {}
@@ -89,6 +89,10 @@ struct HalSerial {
 
   size_t write(char c) {
     if (!host_connected) return 0;
+    if (direct) {
+      if (direct_out) fputc(c, direct_out);
+      return 1;
+    }
     while (!transmit_buffer.free());
     return transmit_buffer.write(c);
   }
@@ -106,13 +110,17 @@ struct HalSerial {
   }
 
   void flushTX() {
-    if (host_connected)
+    if (host_connected && !direct)
       while (transmit_buffer.available()) { /* nada */ }
   }
 
   volatile RingBuffer<uint8_t, 128> receive_buffer;
   volatile RingBuffer<uint8_t, 128> transmit_buffer;
   volatile bool host_connected;
+
+  // With no thread to drain the transmit buffer, write straight to a file (or nowhere)
+  bool direct;
+  FILE *direct_out;
 };
 
 typedef Serial1Class<HalSerial> MSerialT;
@@ -18,16 +18,18 @@
  */
 #ifdef __PLAT_LINUX__
 
-//#define GPIO_LOGGING // Full GPIO and Positional Logging
+//#define GPIO_LOGGING // Binary step trace of every axis (see hardware/IOLoggerBinary.h)
 
 #include "../../inc/MarlinConfig.h"
 #include "../shared/Delay.h"
-#include "hardware/IOLoggerCSV.h"
+#include "hardware/IOLoggerBinary.h"
 #include "hardware/Heater.h"
 #include "hardware/LinearAxis.h"
+#include "virtual_time.h"
 
 #include <stdio.h>
 #include <stdarg.h>
+#include <string.h>
 #include <thread>
 #include <iostream>
 #include <fstream>
@@ -56,23 +58,30 @@ void read_serial_thread() {
   }
 }
 
+#ifdef GPIO_LOGGING
+  // Trace the step and dir pins of each axis to step_trace.bin
+  void start_step_trace() {
+    static const float steps_per_unit[] = DEFAULT_AXIS_STEPS_PER_UNIT;
+    static const IOLoggerBinary::Axis axes[] = {
+      { 'X', X_STEP_PIN, X_DIR_PIN, steps_per_unit[X_AXIS] },
+      { 'Y', Y_STEP_PIN, Y_DIR_PIN, steps_per_unit[Y_AXIS] },
+      { 'Z', Z_STEP_PIN, Z_DIR_PIN, steps_per_unit[Z_AXIS] },
+      { 'E', E0_STEP_PIN, E0_DIR_PIN, steps_per_unit[E_AXIS] }
+    };
+    static IOLoggerBinary logger("step_trace.bin", axes, COUNT(axes));
+    Gpio::attachLogger(&logger);
+  }
+#endif
+
 void simulation_loop() {
-  Heater hotend(HEATER_0_PIN, TEMP_0_PIN);
-  Heater bed(HEATER_BED_PIN, TEMP_BED_PIN);
+  Heater hotend(HOTEND_SIM(HEATER_0_PIN, TEMP_0_PIN));
+  Heater bed(BED_SIM(HEATER_BED_PIN, TEMP_BED_PIN));
   LinearAxis x_axis(X_ENABLE_PIN, X_DIR_PIN, X_STEP_PIN, X_MIN_PIN, X_MAX_PIN);
   LinearAxis y_axis(Y_ENABLE_PIN, Y_DIR_PIN, Y_STEP_PIN, Y_MIN_PIN, Y_MAX_PIN);
   LinearAxis z_axis(Z_ENABLE_PIN, Z_DIR_PIN, Z_STEP_PIN, Z_MIN_PIN, Z_MAX_PIN);
   LinearAxis extruder0(E0_ENABLE_PIN, E0_DIR_PIN, E0_STEP_PIN, P_NC, P_NC);
-
-  #ifdef GPIO_LOGGING
-    IOLoggerCSV logger("all_gpio_log.csv");
-    Gpio::attachLogger(&logger);
-
-    std::ofstream position_log;
-    position_log.open("axis_position_log.csv");
-
-    int32_t x,y,z;
-  #endif
+  hotend.attach_extruder(&extruder0);
+  TERN_(HAS_FAN0, hotend.attach_fan(FAN_PIN));
 
   for (;;) {
 
@@ -84,24 +93,57 @@ void simulation_loop() {
     z_axis.update();
     extruder0.update();
 
-    #ifdef GPIO_LOGGING
-      if (x_axis.position != x || y_axis.position != y || z_axis.position != z) {
-        uint64_t update = _MAX(x_axis.last_update, y_axis.last_update, z_axis.last_update);
-        position_log << update << ", " << x_axis.position << ", " << y_axis.position << ", " << z_axis.position << std::endl;
-        position_log.flush();
-        x = x_axis.position;
-        y = y_axis.position;
-        z = z_axis.position;
-      }
-      // flush the logger
-      logger.flush();
-    #endif
+    // Drain the step trace ring buffer
+    Gpio::flushLogger();
 
     std::this_thread::yield();
   }
 }
 
-int main() {
+#if ENABLED(PLANNER_BENCHMARK)
+
+int main(int argc, char *argv[]) {
+  return Benchmark::run(argc, argv);
+}
+
+#else
+
+/**
+ * Run the firmware on the virtual clock with G-code from a file or stdin,
+ * then report the simulated time on stderr. No threads are used, so runs
+ * are reproducible and take only as long as the host needs to compute them.
+ */
+int virtual_time_main(const char * const path) {
+  FILE * const in = path ? fopen(path, "r") : stdin;
+  if (!in) {
+    perror(path);
+    return 1;
+  }
+
+  #ifdef GPIO_LOGGING
+    start_step_trace();
+  #endif
+
+  VirtualTime::begin(in, stdout);
+  while (!VirtualTime::finished()) loop();
+  VirtualTime::end();
+
+  const uint64_t ns = Clock::nanos();
+  fprintf(stderr, "Simulated time: %.3f s, motion: %.3f s, underruns: %u\n", ns / 1e9, VirtualTime::motion_ns / 1e9, VirtualTime::underruns);
+
+  if (path) fclose(in);
+  return 0;
+}
+
+/**
+ * Usage: program [--virtual [file.gcode]]
+ *
+ *  --virtual  Run on the virtual clock with input from the file (or stdin) until it ends
+ */
+int main(int argc, char *argv[]) {
+  if (argc > 1 && !strcmp(argv[1], "--virtual"))
+    return virtual_time_main(argc > 2 ? argv[2] : nullptr);
+
   std::thread write_serial (write_serial_thread);
   std::thread read_serial (read_serial_thread);
 
@@ -114,6 +156,10 @@ int main() {
   Clock::setFrequency(F_CPU);
   Clock::setTimeMultiplier(1.0); // some testing at 10x
 
+  #ifdef GPIO_LOGGING
+    start_step_trace();
+  #endif
+
   HAL_timer_init();
 
   std::thread simulation (simulation_loop);
@@ -131,4 +177,6 @@ int main() {
   read_serial.join();
 }
 
+#endif // PLANNER_BENCHMARK
+
 #endif // __PLAT_LINUX__
@@ -0,0 +1,147 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#ifdef __PLAT_LINUX__
+
+#include "../../inc/MarlinConfig.h"
+
+#include "virtual_time.h"
+#include "hardware/Timer.h"
+#include "hardware/Heater.h"
+#include "hardware/LinearAxis.h"
+#include "../../module/planner.h"
+#include "../../gcode/queue.h"
+
+extern void setup();
+extern Timer timers[2];
+
+uint32_t VirtualTime::lines, VirtualTime::underruns;
+uint64_t VirtualTime::motion_ns;
+
+static FILE *gcode_in;
+static bool input_done;
+static Heater *hotend, *bed;
+static VirtualTime::monitor_t monitor_fn;
+static uint64_t monitor_interval, monitor_next;
+
+// Feed G-code to the serial port as fast as the firmware takes it, then M400 to finish all moves
+static void feed_input() {
+  static const char *tail = nullptr;
+  while (!input_done && usb_serial.receive_buffer.free()) {
+    int c;
+    if (tail) {
+      if (!*tail) { input_done = true; break; }
+      c = *tail++;
+    }
+    else if ((c = fgetc(gcode_in)) == EOF) {
+      tail = "\nM400\n";
+      continue;
+    }
+    else if (c == '\n')
+      VirtualTime::lines++;
+    usb_serial.receive_buffer.write(c);
+  }
+}
+
+static void fire(Timer &t) {
+  #if ENABLED(PLANNER_BENCHMARK)
+    const BenchmarkScope isr_time(&t == &timers[STEP_TIMER_NUM] ? Benchmark::step_isr : Benchmark::temp_isr);
+  #endif
+  t.fire();
+}
+
+// Jump to the next timer event and run every timer that has come due
+static void run_timers() {
+  Timer *next = nullptr;
+  for (Timer &t : timers)
+    if (t.enabled() && (!next || t.getDue() < next->getDue())) next = &t;
+  if (!next) return;
+
+  const uint64_t now = Clock::nanos(), due = next->getDue();
+  if (due > now) {
+    if (planner.has_blocks_queued()) VirtualTime::motion_ns += due - now;
+    Clock::advanceTo(due);
+  }
+
+  for (;;) {
+    Timer *t = nullptr;
+    for (Timer &u : timers)
+      if (u.enabled() && u.getDue() <= Clock::nanos() && (!t || u.getDue() < t->getDue())) t = &u;
+    if (!t) break;
+
+    const bool was_moving = t == &timers[STEP_TIMER_NUM] && planner.has_blocks_queued();
+    fire(*t);
+    if (was_moving && !planner.has_blocks_queued() && (!input_done || queue.has_commands_queued()))
+      VirtualTime::underruns++;
+  }
+}
+
+void VirtualTime::idle() {
+  feed_input();
+  hotend->update();
+  bed->update();
+  if (monitor_fn && Clock::nanos() >= monitor_next) {
+    monitor_fn(*hotend, *bed);
+    monitor_next += monitor_interval;
+  }
+  Gpio::flushLogger();
+  run_timers();
+}
+
+void VirtualTime::begin(FILE *in, FILE *out) {
+  gcode_in = in;
+
+  Clock::useVirtualTime();
+  Clock::setFrequency(F_CPU);
+
+  usb_serial.direct = true;
+  usb_serial.direct_out = out;
+
+  static Heater hotend_sim(HOTEND_SIM(HEATER_0_PIN, TEMP_0_PIN)), bed_sim(BED_SIM(HEATER_BED_PIN, TEMP_BED_PIN));
+  static LinearAxis x_axis(X_ENABLE_PIN, X_DIR_PIN, X_STEP_PIN, X_MIN_PIN, X_MAX_PIN),
+                    y_axis(Y_ENABLE_PIN, Y_DIR_PIN, Y_STEP_PIN, Y_MIN_PIN, Y_MAX_PIN),
+                    z_axis(Z_ENABLE_PIN, Z_DIR_PIN, Z_STEP_PIN, Z_MIN_PIN, Z_MAX_PIN),
+                    extruder0(E0_ENABLE_PIN, E0_DIR_PIN, E0_STEP_PIN, P_NC, P_NC);
+  hotend_sim.attach_extruder(&extruder0);
+  TERN_(HAS_FAN0, hotend_sim.attach_fan(FAN_PIN));
+  hotend = &hotend_sim;
+  bed = &bed_sim;
+
+  HAL_timer_init();
+  setup();
+}
+
+void VirtualTime::monitor(const monitor_t fn, const uint64_t interval_ns) {
+  monitor_fn = fn;
+  monitor_interval = interval_ns;
+  monitor_next = Clock::nanos();
+}
+
+bool VirtualTime::finished() {
+  return input_done && !usb_serial.receive_buffer.available() && !queue.has_commands_queued();
+}
+
+void VirtualTime::end() {
+  Gpio::flushLogger();
+  if (usb_serial.direct_out) fflush(usb_serial.direct_out);
+}
+
+#endif // __PLAT_LINUX__
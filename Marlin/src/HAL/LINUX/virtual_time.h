@@ -0,0 +1,60 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * Discrete-event simulation on a virtual Clock
+ *
+ * Time only moves when the firmware delays, busy-waits on a timer count, or
+ * goes idle. Reading the clock takes no time. On idle the clock jumps
+ * straight to the next timer compare and every timer that has come due
+ * runs in order, so step timing is exact and runs are reproducible.
+ * There are no helper threads: serial input is read from a file as the
+ * firmware takes it and output is written straight through.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+class Heater;
+
+class VirtualTime {
+  public:
+    static uint32_t lines,        // G-code lines read
+                    underruns;    // The planner ran out of moves with G-code still to run
+    static uint64_t motion_ns;    // Time with moves in the planner
+
+    // Start the clock and run setup() with G-code from 'in' and serial output to 'out' (or nowhere)
+    static void begin(FILE *in, FILE *out);
+
+    // All input has been read and every command is done
+    static bool finished();
+
+    // Finish up after the last loop()
+    static void end();
+
+    static void idle();
+
+    // Call 'fn' with the simulated heaters every 'interval_ns' of virtual time
+    typedef void (*monitor_t)(const Heater &hotend, const Heater &bed);
+    static void monitor(const monitor_t fn, const uint64_t interval_ns);
+};
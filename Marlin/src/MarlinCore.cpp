@@ -240,6 +240,10 @@
   #include "feature/power.h"
 #endif
 
+#if ENABLED(PATH_BLENDING)
+  #include "feature/path_blending.h"
+#endif
+
 PGMSTR(M112_KILL_STR, "M112 Shutdown");
 
 MarlinState marlin_state = MF_INITIALIZING;
@@ -790,6 +794,8 @@ inline void manage_inactivity(const bool no_stepper_sleep=false) {
  *  - Handle Joystick jogging
  */
 void idle(bool no_stepper_sleep/*=false*/) {
+  TERN_(PLANNER_BENCHMARK, BENCHMARK_IDLE_SCOPE());
+
   #if ENABLED(MARLIN_DEV_MODE)
     static uint16_t idle_depth = 0;
     if (++idle_depth > 5) SERIAL_ECHOLNPAIR("idle() call depth: ", idle_depth);
@@ -807,6 +813,14 @@ void idle(bool no_stepper_sleep/*=false*/) {
   // Return if setup() isn't completed
   if (marlin_state == MF_INITIALIZING) goto IDLE_DONE;
 
+  // Prepare step rates for the Stepper ISR
+  TERN_(STEP_SEGMENT_BUFFER, stepper.prep_segments());
+
+  // Don't hold a move for blending while the planner runs dry
+  #if ENABLED(PATH_BLENDING)
+    if (planner.movesplanned() < 3) blender.flush();
+  #endif
+
   // TODO: Still causing errors
   (void)check_tool_sensor_stats(active_extruder, true);
 
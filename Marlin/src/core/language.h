@@ -133,6 +133,7 @@
 #define STR_FLOWMETER_FAULT                 "Coolant flow fault. Flowmeter safety is active. Attention required."
 #define STR_ERR_STOPPED                     "Printer stopped due to errors. Fix the error and use M999 to restart. (Temperature is reset. Set it after restarting)"
 #define STR_ERR_SERIAL_MISMATCH             "Serial status mismatch"
+#define STR_ERR_BINARY_GCODE                "Bad binary G-code record"
 #define STR_BUSY_PROCESSING                 "busy: processing"
 #define STR_BUSY_PAUSED_FOR_USER            "busy: paused for user"
 #define STR_BUSY_PAUSED_FOR_INPUT           "busy: paused for input"
@@ -226,6 +227,15 @@
 #define STR_PID_DEBUG_ITERM                 " iTerm "
 #define STR_PID_DEBUG_DTERM                 " dTerm "
 #define STR_PID_DEBUG_CTERM                 " cTerm "
+#define STR_MPC_AUTOTUNE_START              "MPC Autotune start for " STR_E
+#define STR_MPC_AUTOTUNE_INTERRUPTED        "MPC Autotune interrupted!"
+#define STR_MPC_AUTOTUNE_FAILED             "MPC Autotune failed! Not enough samples"
+#define STR_MPC_AUTOTUNE_FINISHED           "MPC Autotune finished! Put the constants below into Configuration.h"
+#define STR_MPC_COOLING_TO_AMBIENT          "Cooling to ambient"
+#define STR_MPC_HEATING_PAST_200            "Heating to over 200C"
+#define STR_MPC_HEATING_TIMEOUT             "MPC Autotune failed! Heating timeout"
+#define STR_MPC_MEASURING_AMBIENT           "Measuring ambient heat loss at "
+#define STR_MPC_TEMPERATURE_ERROR           "MPC Autotune failed! Temperature out of range"
 #define STR_INVALID_EXTRUDER_NUM            " - Invalid extruder number !"
 
 #define STR_HEATER_BED                      "bed"
@@ -0,0 +1,163 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(BINARY_GCODE)
+
+#include "binary_gcode.h"
+
+#if ENABLED(SDSUPPORT)
+  uint8_t BinaryGCode::record[MAX_CMD_SIZE + 1];
+#endif
+
+int16_t BinaryGCode::decode(const uint8_t * const rec, char * const line, const uint16_t size
+  OPTARG(PARSE_AT_ENQUEUE, parsed_command_t &parsed)
+) {
+  const uint8_t head = rec[0];
+  const uint8_t *p = rec + HEADER_SIZE, * const end = p + rec[1];
+  char *out = line, * const out_end = line + size - 1; // Leave room for the terminator
+
+  TERN_(PARSE_AT_ENQUEUE, parsed.command_letter = '\0'); // Parse the text unless filled in below
+
+  const uint8_t kind = (head >> 5) & 0x3;
+  if (kind == KIND_TEXT) {
+    const uint16_t len = _MIN(uint16_t(end - p), uint16_t(out_end - out));
+    memcpy(line, p, len);
+    line[len] = '\0';
+    return len;
+  }
+
+  // Read a varint, failing at the end of the record
+  auto get_varint = [&](uint32_t &v) {
+    v = 0;
+    for (uint8_t shift = 0; p < end && shift < 32; shift += 7) {
+      const uint8_t b = *p++;
+      v |= uint32_t(b & 0x7F) << shift;
+      if (!(b & 0x80)) return true;
+    }
+    return false;
+  };
+
+  // Write a number with 'places' decimal places, failing if the line is full
+  auto put_decimal = [&](uint32_t v, const uint8_t places) {
+    char digits[10];
+    uint8_t n = 0;
+    do { digits[n++] = '0' + v % 10; v /= 10; } while (v || n <= places);
+    if (out + n + !!places > out_end) return false;
+    while (n) {
+      if (n == places) *out++ = '.';
+      *out++ = digits[--n];
+    }
+    return true;
+  };
+
+  uint32_t code;
+  if (!get_varint(code) || code > 0xFFFF) return -1;
+
+  const char letter = kind == KIND_G ? 'G' : kind == KIND_M ? 'M' : 'T';
+  *out++ = letter;
+  if (!put_decimal(code, 0)) return -1;
+
+  uint8_t subcode = 0;
+  if (TEST(head, 4)) {
+    if (p >= end) return -1;
+    subcode = *p++;
+    if (out >= out_end) return -1;
+    *out++ = '.';
+    if (!put_decimal(subcode, 0)) return -1;
+  }
+
+  const uint8_t count = head & 0x0F;
+
+  #if ENABLED(PARSE_AT_ENQUEUE)
+    // Commands with a string argument, too many parameters, or a subcode the parser ignores get parsed as text
+    bool fill = count <= PARSED_PARAMS && !(letter == 'M' && GCodeParser::is_string_mcode(code));
+    #if !USE_GCODE_SUBCODES
+      if (TEST(head, 4)) fill = false;
+    #endif
+    parsed.codebits = 0;
+    parsed.codenum = code;
+    parsed.subcode = subcode;
+    parsed.command_offset = 0;
+    parsed.string_offset = 0;
+    parsed.count = count;
+  #endif
+
+  LOOP_L_N(i, count) {
+    if (p >= end || out + 2 > out_end) return -1;
+    const uint8_t param = *p++, ind = param & 0x1F, format = param >> 5;
+    if (ind > 'Z' - 'A') return -1;
+
+    *out++ = ' ';
+    *out++ = 'A' + ind;
+    TERN_(PARSE_AT_ENQUEUE, char * const value_ptr = out);
+
+    TERN_(PARSE_AT_ENQUEUE, float value = 0);
+    if (format) {
+      uint32_t zz;
+      if (!get_varint(zz)) return -1;
+      const bool neg = zz & 1;
+      const uint32_t mag = (zz >> 1) + neg;   // Magnitude of the zigzag value
+      const uint8_t places = format - 1;
+      if (neg) {
+        if (out >= out_end) return -1;
+        *out++ = '-';
+      }
+      if (!put_decimal(mag, places)) return -1;
+
+      #if ENABLED(PARSE_AT_ENQUEUE)
+        if (fill) {
+          if (mag <= _BV32(24)) {
+            value = GCodeParser::float_from_decimal(mag, places);
+            if (neg) value = -value;
+          }
+          else {
+            *out = '\0';                      // Too long to convert exactly. Scan the text.
+            value = GCodeParser::scan_float(value_ptr);
+          }
+        }
+      #endif
+    }
+
+    #if ENABLED(PARSE_AT_ENQUEUE)
+      if (fill) {
+        if (TEST32(parsed.codebits, ind)) fill = false; // Repeated letters are left to the parser
+        SBI32(parsed.codebits, ind);
+        parsed.letter[i] = ind;
+        parsed.param[i] = format ? value_ptr - line : 0;
+        parsed.value[i] = value;
+        if (!format && !parsed.string_offset)     // The first parameter with no value is the string_arg
+          parsed.string_offset = value_ptr - line;  // (letter offset + 1)
+      }
+    #endif
+  }
+
+  if (p != end) return -1;
+  *out = '\0';
+
+  TERN_(PARSE_AT_ENQUEUE, if (fill) parsed.command_letter = letter);
+
+  return out - line;
+}
+
+#endif // BINARY_GCODE
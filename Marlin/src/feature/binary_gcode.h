@@ -0,0 +1,92 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * Binary G-code
+ *
+ * Commands tokenized ahead of time by the host or by
+ * buildroot/share/scripts/gcode_binary.py, so the firmware never has to
+ * find the parameters or convert their values. Records are about half the
+ * size of the text they replace.
+ *
+ * Every record starts with a byte over 127, so records and plain text lines
+ * can be mixed in a file.
+ *
+ *   byte 0  1KKSCCCC  K = Kind: 0 = G, 1 = M, 2 = T, 3 = Text line
+ *                     S = A subcode byte follows the code number
+ *                     C = Number of parameters (0-15). S and C are 0 for Text.
+ *   byte 1            Number of bytes that follow in this record
+ *
+ * G, M, and T records then hold:
+ *
+ *   varint            Code number
+ *   byte              Subcode, if S is set
+ *   params            FFFLLLLL  L = Parameter letter - 'A'
+ *                               F = 0: No value
+ *                                   1-7: A zigzag varint follows, with F-1 decimal places
+ *
+ * A Text record holds the characters of a line that can't be tokenized
+ * (strings, comments that must be kept, etc.) with no terminator.
+ *
+ * Varints are little-endian, 7 bits per byte, with the high bit set on all but
+ * the last byte. Zigzag encoding maps 0, -1, 1, -2... to 0, 1, 2, 3...
+ *
+ * Records are decoded into the command queue as the canonical text of the
+ * command ("G1 X12.3 E0.05") so everything that reads the line still works.
+ * With PARSE_AT_ENQUEUE the parsed record is filled in directly as well.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(PARSE_AT_ENQUEUE)
+  #include "../gcode/parser.h"
+#endif
+
+class BinaryGCode {
+public:
+  enum Kind : uint8_t { KIND_G, KIND_M, KIND_T, KIND_TEXT };
+
+  static constexpr uint8_t RECORD_MARK = 0x80,
+                           HEADER_SIZE = 2;
+
+  // A line starting with this byte is a binary record. Text records have no
+  // flags, so a UTF-8 byte order mark (0xEF) still starts a text line.
+  static inline bool is_record(const int16_t c) { return c >= RECORD_MARK && (c & 0x7F) <= (KIND_TEXT << 5); }
+
+  // Size of the record whose header is at 'rec'
+  static inline uint16_t record_size(const uint8_t * const rec) { return HEADER_SIZE + rec[1]; }
+
+  #if ENABLED(SDSUPPORT)
+    static uint8_t record[MAX_CMD_SIZE + 1]; // A record read from the SD card
+  #endif
+
+  /**
+   * Decode the record at 'rec' into a command line of up to 'size' bytes,
+   * including the terminator. Return its length, or -1 for a corrupt record.
+   * With PARSE_AT_ENQUEUE 'parsed' gets the parsed command, or a nul command_letter
+   * if the line has to be parsed as text.
+   */
+  static int16_t decode(const uint8_t * const rec, char * const line, const uint16_t size
+    OPTARG(PARSE_AT_ENQUEUE, parsed_command_t &parsed)
+  );
+};
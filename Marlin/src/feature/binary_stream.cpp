@@ -29,8 +29,27 @@
 
 char* SDFileTransferProtocol::Packet::Open::data = nullptr;
 size_t SDFileTransferProtocol::data_waiting, SDFileTransferProtocol::transfer_timeout, SDFileTransferProtocol::idle_timeout;
-bool SDFileTransferProtocol::transfer_active, SDFileTransferProtocol::dummy_transfer, SDFileTransferProtocol::compression;
+bool SDFileTransferProtocol::transfer_active, SDFileTransferProtocol::dummy_transfer, SDFileTransferProtocol::compression, SDFileTransferProtocol::write_error;
+#if ENABLED(BINARY_STREAM_WRITE_BEHIND)
+  uint8_t SDFileTransferProtocol::fill_index;
+  bool SDFileTransferProtocol::sector_waiting;
+#endif
+#if ENABLED(BINARY_STREAM_PRINT)
+  bool SDFileTransferProtocol::printing;
+  uint16_t SDFileTransferProtocol::data_index; // = 0
+
+  char StreamPrint::buffer[BINARY_STREAM_PRINT_BUFFER], StreamPrint::line[MAX_CMD_SIZE];
+  uint16_t StreamPrint::index_r, StreamPrint::index_w;
+  bool StreamPrint::active;
+  int StreamPrint::count;
+  uint8_t StreamPrint::input_state;
+#endif
+
+#if ENABLED(BINARY_GCODE)
+  uint16_t BinaryGCodeProtocol::data_index; // = 0
+#endif
 
+BinaryStream::Slot BinaryStream::window[BINARY_STREAM_WINDOW];
 BinaryStream binaryStream[NUM_SERIAL];
 
 #endif
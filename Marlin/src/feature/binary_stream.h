@@ -26,11 +26,26 @@
 #define BINARY_STREAM_COMPRESSION
 #if ENABLED(BINARY_STREAM_COMPRESSION)
   #include "../libs/heatshrink/heatshrink_decoder.h"
-  // STM32 (and others?) require a word-aligned buffer for SD card transfers via DMA
-  static __attribute__((aligned(sizeof(size_t)))) uint8_t decode_buffer[512] = {};
   static heatshrink_decoder hsd;
 #endif
 
+// Whole sectors of file data, decompressed or collected for write-behind.
+// With write-behind one sector fills while the other waits to be written.
+#if ENABLED(BINARY_STREAM_WRITE_BEHIND)
+  #define SECTOR_BUFFERS 2
+#elif ENABLED(BINARY_STREAM_COMPRESSION)
+  #define SECTOR_BUFFERS 1
+#endif
+#ifdef SECTOR_BUFFERS
+  // STM32 (and others?) require a word-aligned buffer for SD card transfers via DMA
+  static __attribute__((aligned(sizeof(size_t)))) uint8_t sector_buffer[SECTOR_BUFFERS][512] = {};
+#endif
+
+#if ENABLED(BINARY_GCODE)
+  #include "binary_gcode.h"
+  #include "../gcode/queue.h"
+#endif
+
 inline bool bs_serial_data_available(const serial_index_t index) {
   return SERIAL_IMPL.available(index);
 }
@@ -39,6 +54,56 @@ inline int bs_read_serial(const serial_index_t index) {
   return SERIAL_IMPL.read(index);
 }
 
+#if ENABLED(BINARY_STREAM_PRINT)
+
+/**
+ * Stream print
+ *
+ * File data from a transfer opened with the "print" flag goes into this
+ * buffer, and the command queue takes lines from it just as it does from
+ * an SD print. A WRITE packet isn't acknowledged until all its data fits,
+ * so the host is held back by the command queue and the planner.
+ */
+class StreamPrint {
+public:
+  static char buffer[BINARY_STREAM_PRINT_BUFFER];
+  static uint16_t index_r, index_w;   // Free-running, masked to the buffer size
+  static bool active;                 // The transfer is open, so more data may come
+
+  // The line being collected from the buffer, as with serial input
+  static char line[MAX_CMD_SIZE];
+  static int count;
+  static uint8_t input_state;
+
+  static void begin() { clear(); active = true; }
+  static void end() { active = false; }
+  static void abort() { clear(); active = false; }
+
+  static void clear() { index_r = index_w = 0; count = 0; input_state = 0; }
+
+  static uint16_t used() { return index_w - index_r; }
+  static bool available() { return used() != 0; }
+
+  // Still printing while the transfer is open or data is left
+  static bool printing() { return active || available() || count; }
+
+  static uint8_t peek(const uint16_t i=0) { return buffer[(index_r + i) & MASK]; }
+  static char read() { return buffer[index_r++ & MASK]; }
+
+  // Free space from the write position up to the end of the buffer
+  static char* space(uint16_t &n) {
+    const uint16_t w = index_w & MASK;
+    n = _MIN(uint16_t(BINARY_STREAM_PRINT_BUFFER - used()), uint16_t(BINARY_STREAM_PRINT_BUFFER - w));
+    return &buffer[w];
+  }
+  static void commit(const uint16_t n) { index_w += n; }
+
+private:
+  static constexpr uint16_t MASK = BINARY_STREAM_PRINT_BUFFER - 1;
+};
+
+#endif // BINARY_STREAM_PRINT
+
 class SDFileTransferProtocol  {
 private:
   struct Packet {
@@ -51,10 +116,11 @@ private:
         return *reinterpret_cast<Open*>(buffer);
       }
       bool compression_enabled() { return compression & 0x1; }
-      bool dummy_transfer() { return dummy & 0x1; }
+      bool dummy_transfer() { return flags & 0x1; }
+      bool stream_print() { return flags & 0x2; }
       static char* filename() { return data; }
       private:
-        uint8_t dummy, compression;
+        uint8_t flags, compression;
         static char* data;  // variable length strings complicate things
     };
   };
@@ -64,13 +130,53 @@ private:
       card.mount();
       card.openFileWrite(filename);
       if (!card.isFileOpen()) return false;
+      // A printing file is saved as it goes, so the queued commands still run
+      if (TERN0(BINARY_STREAM_PRINT, printing)) card.flag.saving = false;
     }
     transfer_active = true;
     data_waiting = 0;
+    write_error = false;
+    #if ENABLED(BINARY_STREAM_WRITE_BEHIND)
+      fill_index = 0;
+      sector_waiting = false;
+    #endif
+    TERN_(BINARY_STREAM_PRINT, if (printing) StreamPrint::begin());
     TERN_(BINARY_STREAM_COMPRESSION, heatshrink_decoder_reset(&hsd));
     return true;
   }
 
+  #ifdef SECTOR_BUFFERS
+
+    // The sector being filled
+    static uint8_t* sector() { return sector_buffer[TERN0(BINARY_STREAM_WRITE_BEHIND, fill_index)]; }
+
+    // The sector being filled is full. With write-behind it's left for idle() to write
+    // unless the other sector is still waiting, so the card write comes between packets.
+    static bool sector_full() {
+      data_waiting = 0;
+      #if ENABLED(BINARY_STREAM_WRITE_BEHIND)
+        if (!write_waiting()) return false;
+        sector_waiting = true;
+        fill_index ^= 1;
+        return true;
+      #else
+        return dummy_transfer || card.write(sector_buffer[0], 512) >= 0;
+      #endif
+    }
+
+  #endif
+
+  #if ENABLED(BINARY_STREAM_WRITE_BEHIND)
+
+    // Write the full sector that's waiting, if there is one
+    static bool write_waiting() {
+      if (!sector_waiting) return true;
+      sector_waiting = false;
+      return dummy_transfer || card.write(sector_buffer[fill_index ^ 1], 512) >= 0;
+    }
+
+  #endif
+
   static bool file_write(char *buffer, const size_t length) {
     #if ENABLED(BINARY_STREAM_COMPRESSION)
       if (compression) {
@@ -81,29 +187,90 @@ private:
           heatshrink_decoder_sink(&hsd, reinterpret_cast<uint8_t*>(&buffer[total_processed]), length - total_processed, &processed_count);
           total_processed += processed_count;
           do {
-            presult = heatshrink_decoder_poll(&hsd, &decode_buffer[data_waiting], sizeof(decode_buffer) - data_waiting, &processed_count);
+            presult = heatshrink_decoder_poll(&hsd, &sector()[data_waiting], sizeof(sector_buffer[0]) - data_waiting, &processed_count);
             data_waiting += processed_count;
-            if (data_waiting == sizeof(decode_buffer)) {
-              if (!dummy_transfer)
-                if (card.write(decode_buffer, data_waiting) < 0) {
-                  return false;
-                }
-              data_waiting = 0;
-            }
+            if (data_waiting == sizeof(sector_buffer[0]) && !sector_full()) return false;
           } while (presult == HSDR_POLL_MORE);
         }
         return true;
       }
     #endif
-    return (dummy_transfer || card.write(buffer, length) >= 0);
+    return store(buffer, length);
   }
 
+  // Write uncompressed data to the file
+  static bool store(char *buffer, const size_t length) {
+    #if ENABLED(BINARY_STREAM_WRITE_BEHIND)
+      // Collect whole sectors so every card write is a full, aligned block
+      for (size_t i = 0; i < length;) {
+        const size_t n = _MIN(length - i, sizeof(sector_buffer[0]) - data_waiting);
+        memcpy(&sector()[data_waiting], &buffer[i], n);
+        data_waiting += n;
+        i += n;
+        if (data_waiting == sizeof(sector_buffer[0]) && !sector_full()) return false;
+      }
+      return true;
+    #else
+      return (dummy_transfer || card.write(buffer, length) >= 0);
+    #endif
+  }
+
+  #if ENABLED(BINARY_STREAM_PRINT)
+
+    // Data in the print buffer goes to the file too
+    static void print_commit(char *data, const uint16_t n) {
+      StreamPrint::commit(n);
+      if (!store(data, n)) write_error = true;
+    }
+
+    /**
+     * Put the data of a WRITE packet into the print buffer, continuing from
+     * the last call. Return false while the buffer is too full to take it all.
+     */
+    static bool print_write(char *buffer, const uint16_t length) {
+      transfer_timeout = millis() + TIMEOUT; // Waiting on the printer isn't a stalled transfer
+      uint16_t n;
+      #if ENABLED(BINARY_STREAM_COMPRESSION)
+        if (compression) {
+          for (;;) {
+            HSD_poll_res presult;
+            do {
+              char * const out = StreamPrint::space(n);
+              if (!n) return false;
+              size_t processed_count;
+              presult = heatshrink_decoder_poll(&hsd, reinterpret_cast<uint8_t*>(out), n, &processed_count);
+              print_commit(out, processed_count);
+            } while (presult == HSDR_POLL_MORE);
+            if (data_index == length) break;
+            size_t processed_count;
+            heatshrink_decoder_sink(&hsd, reinterpret_cast<uint8_t*>(&buffer[data_index]), length - data_index, &processed_count);
+            data_index += processed_count;
+          }
+          data_index = 0;
+          return true;
+        }
+      #endif
+      while (data_index < length) {
+        char * const out = StreamPrint::space(n);
+        if (!n) return false;
+        NOMORE(n, length - data_index);
+        memcpy(out, &buffer[data_index], n);
+        print_commit(out, n);
+        data_index += n;
+      }
+      data_index = 0;
+      return true;
+    }
+
+  #endif
+
   static bool file_close() {
     if (!dummy_transfer) {
-      #if ENABLED(BINARY_STREAM_COMPRESSION)
+      #ifdef SECTOR_BUFFERS
         // flush any buffered data
+        if (!TERN1(BINARY_STREAM_WRITE_BEHIND, write_waiting())) return false;
         if (data_waiting) {
-          if (card.write(decode_buffer, data_waiting) < 0) return false;
+          if (card.write(sector(), data_waiting) < 0) return false;
           data_waiting = 0;
         }
       #endif
@@ -111,6 +278,7 @@ private:
       card.release();
     }
     TERN_(BINARY_STREAM_COMPRESSION, heatshrink_decoder_finish(&hsd));
+    TERN_(BINARY_STREAM_PRINT, if (printing) StreamPrint::end());
     transfer_active = false;
     return true;
   }
@@ -122,6 +290,10 @@ private:
       card.release();
       TERN_(BINARY_STREAM_COMPRESSION, heatshrink_decoder_finish(&hsd));
     }
+    #if ENABLED(BINARY_STREAM_PRINT)
+      if (printing) StreamPrint::abort();
+      data_index = 0;
+    #endif
     transfer_active = false;
     return;
   }
@@ -129,11 +301,36 @@ private:
   enum class FileTransfer : uint8_t { QUERY, OPEN, CLOSE, WRITE, ABORT };
 
   static size_t data_waiting, transfer_timeout, idle_timeout;
-  static bool transfer_active, dummy_transfer, compression;
+  static bool transfer_active, dummy_transfer, compression, write_error;
+  #if ENABLED(BINARY_STREAM_WRITE_BEHIND)
+    static uint8_t fill_index;
+    static bool sector_waiting;
+  #endif
+  #if ENABLED(BINARY_STREAM_PRINT)
+    static bool printing;
+    static uint16_t data_index;
+  #endif
 
 public:
 
+  #if ENABLED(BINARY_STREAM_PRINT)
+    /**
+     * Take the data of a stream print WRITE packet before it's acknowledged.
+     * Return false while it has to wait for room in the print buffer.
+     */
+    static bool accept(const uint8_t packet_type, char *buffer, const uint16_t length) {
+      return !(transfer_active && printing && static_cast<FileTransfer>(packet_type) == FileTransfer::WRITE)
+          || print_write(buffer, length);
+    }
+
+    // An ABORT doesn't wait behind a WRITE held for the print buffer
+    static bool is_abort(const uint8_t packet_type) { return static_cast<FileTransfer>(packet_type) == FileTransfer::ABORT; }
+  #endif
+
   static void idle() {
+    // Write a full sector while the serial line is quiet
+    TERN_(BINARY_STREAM_WRITE_BEHIND, if (transfer_active && !write_waiting()) write_error = true);
+
     // If a transfer is interrupted and a file is left open, abort it after TIMEOUT ms
     const millis_t ms = millis();
     if (transfer_active && ELAPSED(ms, idle_timeout)) {
@@ -148,19 +345,24 @@ public:
       case FileTransfer::QUERY:
         SERIAL_ECHOPAIR("PFT:version:", VERSION_MAJOR, ".", VERSION_MINOR, ".", VERSION_PATCH);
         #if ENABLED(BINARY_STREAM_COMPRESSION)
-          SERIAL_ECHOLNPAIR(":compresion:heatshrink,", HEATSHRINK_STATIC_WINDOW_BITS, ",", HEATSHRINK_STATIC_LOOKAHEAD_BITS);
+          SERIAL_ECHOPAIR(":compresion:heatshrink,", HEATSHRINK_STATIC_WINDOW_BITS, ",", HEATSHRINK_STATIC_LOOKAHEAD_BITS);
         #else
-          SERIAL_ECHOLNPGM(":compresion:none");
+          SERIAL_ECHOPGM(":compresion:none");
+        #endif
+        #if ENABLED(BINARY_STREAM_PRINT)
+          SERIAL_ECHOPAIR(":print:", BINARY_STREAM_PRINT_BUFFER);
         #endif
+        SERIAL_EOL();
         break;
       case FileTransfer::OPEN:
-        if (transfer_active)
+        if (transfer_active || TERN0(BINARY_STREAM_PRINT, StreamPrint::printing()))
           SERIAL_ECHOLNPGM("PFT:busy");
         else {
           if (Packet::Open::validate(buffer, length)) {
             auto packet = Packet::Open::decode(buffer);
             compression = packet.compression_enabled();
             dummy_transfer = packet.dummy_transfer();
+            TERN_(BINARY_STREAM_PRINT, printing = packet.stream_print());
             if (file_open(packet.filename())) {
               SERIAL_ECHOLNPGM("PFT:success");
               break;
@@ -171,7 +373,7 @@ public:
         break;
       case FileTransfer::CLOSE:
         if (transfer_active) {
-          if (file_close())
+          if (file_close() && !write_error)
             SERIAL_ECHOLNPGM("PFT:success");
           else
             SERIAL_ECHOLNPGM("PFT:ioerror");
@@ -181,7 +383,7 @@ public:
       case FileTransfer::WRITE:
         if (!transfer_active)
           SERIAL_ECHOLNPGM("PFT:invalid");
-        else if (!file_write(buffer, length))
+        else if (TERN0(BINARY_STREAM_PRINT, printing) ? write_error : (!file_write(buffer, length) || write_error))
           SERIAL_ECHOLNPGM("PFT:ioerror");
         break;
       case FileTransfer::ABORT:
@@ -197,11 +399,67 @@ public:
   static const uint16_t VERSION_MAJOR = 0, VERSION_MINOR = 1, VERSION_PATCH = 0, TIMEOUT = 10000, IDLE_PERIOD = 1000;
 };
 
+#if ENABLED(BINARY_GCODE)
+
+class BinaryGCodeProtocol {
+private:
+  enum class GCodePacket : uint8_t { QUERY, COMMANDS };
+
+  static uint16_t data_index;
+
+public:
+
+  /**
+   * Queue the binary G-code records in a COMMANDS packet, continuing from the
+   * last call. Return false while the queue is too full to take them all, so
+   * the packet isn't acknowledged until its commands are queued.
+   */
+  static bool process(uint8_t packet_type, char *buffer, const uint16_t length) {
+    switch (static_cast<GCodePacket>(packet_type)) {
+      case GCodePacket::QUERY:
+        SERIAL_ECHOLNPAIR("PBG:version:", VERSION_MAJOR, ".", VERSION_MINOR, ".", VERSION_PATCH, ":commands:", MAX_QUEUED_COMMANDS, ":line:", MAX_CMD_SIZE);
+        break;
+      case GCodePacket::COMMANDS:
+        while (data_index < length) {
+          const uint8_t * const rec = reinterpret_cast<uint8_t*>(&buffer[data_index]);
+          const uint16_t left = length - data_index;
+          if (left < BinaryGCode::HEADER_SIZE || !BinaryGCode::is_record(rec[0]) || left < BinaryGCode::record_size(rec)) {
+            SERIAL_ECHOLNPGM("PBG:invalid");
+            break;
+          }
+          if (!queue.ring_buffer.enqueue_binary(rec, true OPTARG(HAS_MULTI_SERIAL, card.transfer_port_index))) return false;
+          data_index += BinaryGCode::record_size(rec);
+        }
+        break;
+      default:
+        SERIAL_ECHOLNPGM("PBG:invalid");
+        break;
+    }
+    data_index = 0;
+    return true;
+  }
+
+  static const uint16_t VERSION_MAJOR = 0, VERSION_MINOR = 1, VERSION_PATCH = 0;
+};
+
+#endif // BINARY_GCODE
+
+/**
+ * Binary stream packets
+ *
+ * The host may send up to BINARY_STREAM_WINDOW packets ahead of the ACKs.
+ * Packets are buffered by sync number and dispatched in order, each one
+ * acknowledged with "ok<sync>" when it is dispatched. A lost or corrupt
+ * packet is requested again with "rs<sync>" while the packets after it stay
+ * buffered, so only that packet has to be resent.
+ *
+ * The CONTROL QUERY packet reports the window and the largest packet payload.
+ */
 class BinaryStream {
 public:
-  enum class Protocol : uint8_t { CONTROL, FILE_TRANSFER };
+  enum class Protocol : uint8_t { CONTROL, FILE_TRANSFER, GCODE };
 
-  enum class ProtocolControl : uint8_t { SYNC = 1, CLOSE };
+  enum class ProtocolControl : uint8_t { SYNC = 1, CLOSE, QUERY };
 
   enum class StreamState : uint8_t { PACKET_RESET, PACKET_WAIT, PACKET_HEADER, PACKET_DATA, PACKET_FOOTER,
                                      PACKET_PROCESS, PACKET_RESEND, PACKET_TIMEOUT, PACKET_ERROR };
@@ -250,10 +508,50 @@ public:
     }
   } packet{};
 
+  // A received packet waiting its turn to be dispatched.
+  // STM32 (and others?) require a word-aligned buffer for SD card transfers via DMA
+  struct __attribute__((aligned(sizeof(size_t)))) Slot {
+    char data[BINARY_STREAM_PACKET_SIZE];
+    uint16_t size;
+    uint8_t meta;
+    bool ready;
+    uint8_t protocol() const { return (meta >> 4) & 0xF; }
+    uint8_t type() const { return meta & 0xF; }
+  };
+
+  // Only one port transfers at a time, so all ports share the buffers
+  static Slot window[BINARY_STREAM_WINDOW];
+
+  static Slot& slot_for(const uint8_t packet_sync) { return window[packet_sync & (BINARY_STREAM_WINDOW - 1)]; }
+
+  static void clear_window() { LOOP_L_N(i, BINARY_STREAM_WINDOW) window[i].ready = false; }
+
+  // The first packet in the window that hasn't arrived
+  uint8_t first_missing() {
+    uint8_t s = sync;
+    while (uint8_t(s - sync) < BINARY_STREAM_WINDOW - 1 && slot_for(s).ready) s++;
+    return s;
+  }
+
+  #if ENABLED(BINARY_STREAM_PRINT)
+    // The first FILE_TRANSFER ABORT buffered in order behind the next packet, or the next packet if none
+    uint8_t abort_sync() {
+      const uint8_t end = first_missing();
+      for (uint8_t s = sync + 1; s != end; s++) {
+        const Slot &slot = slot_for(s);
+        if (static_cast<Protocol>(slot.protocol()) == Protocol::FILE_TRANSFER && SDFileTransferProtocol::is_abort(slot.type()))
+          return s;
+      }
+      return sync;
+    }
+  #endif
+
   void reset() {
     sync = 0;
     packet_retries = 0;
     buffer_next_index = 0;
+    resend_requested = false;
+    clear_window();
   }
 
   // fletchers 16 checksum
@@ -265,19 +563,19 @@ public:
   // read the next byte from the data stream keeping track of
   // whether the stream times out from data starvation
   // takes the data variable by reference in order to return status
+  // (Data already waiting isn't starved, even if it sat while the printer was busy)
   bool stream_read(uint8_t& data) {
-    if (stream_state != StreamState::PACKET_WAIT && ELAPSED(millis(), packet.timeout)) {
-      stream_state = StreamState::PACKET_TIMEOUT;
+    if (!bs_serial_data_available(card.transfer_port_index)) {
+      if (stream_state != StreamState::PACKET_WAIT && ELAPSED(millis(), packet.timeout))
+        stream_state = StreamState::PACKET_TIMEOUT;
       return false;
     }
-    if (!bs_serial_data_available(card.transfer_port_index)) return false;
     data = bs_read_serial(card.transfer_port_index);
     packet.timeout = millis() + PACKET_MAX_WAIT;
     return true;
   }
 
-  template<const size_t buffer_size>
-  void receive(char (&buffer)[buffer_size]) {
+  void receive() {
     uint8_t data = 0;
     millis_t transfer_window = millis() + RX_TIMESLICE;
 
@@ -285,6 +583,9 @@ public:
       PORT_REDIRECT(SERIAL_PORTMASK(card.transfer_port_index));
     #endif
 
+    dispatch_window(); // Packets may be waiting on a full command queue
+    if (!card.flag.binary_mode) return;
+
     #pragma GCC diagnostic push
     #pragma GCC diagnostic ignored "-Warray-bounds"
 
@@ -295,6 +596,7 @@ public:
           */
         case StreamState::PACKET_RESET:
           packet.reset();
+          resend_sync = first_missing();
           stream_state = StreamState::PACKET_WAIT;
         case StreamState::PACKET_WAIT:
           if (!stream_read(data)) { idle(); return; }  // no active packet so don't wait
@@ -320,23 +622,37 @@ public:
 
           if (packet.bytes_received == sizeof(Packet::header)) {
             if (packet.header.checksum == packet.header_checksum) {
-              // The SYNC control packet is a special case in that it doesn't require the stream sync to be correct
-              if (static_cast<Protocol>(packet.header.protocol()) == Protocol::CONTROL && static_cast<ProtocolControl>(packet.header.type()) == ProtocolControl::SYNC) {
-                  SERIAL_ECHOLNPAIR("ss", sync, ",", buffer_size, ",", VERSION_MAJOR, ".", VERSION_MINOR, ".", VERSION_PATCH);
-                  stream_state = StreamState::PACKET_RESET;
-                  break;
+              // SYNC and QUERY control packets are special cases in that they don't require the stream sync to be correct
+              if (static_cast<Protocol>(packet.header.protocol()) == Protocol::CONTROL) {
+                switch (static_cast<ProtocolControl>(packet.header.type())) {
+                  case ProtocolControl::SYNC:
+                    SERIAL_ECHOLNPAIR("ss", sync, ",", BINARY_STREAM_PACKET_SIZE, ",", VERSION_MAJOR, ".", VERSION_MINOR, ".", VERSION_PATCH);
+                    stream_state = StreamState::PACKET_RESET;
+                    break;
+                  case ProtocolControl::QUERY:
+                    SERIAL_ECHOLNPAIR("PBS:version:", VERSION_MAJOR, ".", VERSION_MINOR, ".", VERSION_PATCH, ":window:", BINARY_STREAM_WINDOW, ":packet:", BINARY_STREAM_PACKET_SIZE);
+                    stream_state = StreamState::PACKET_RESET;
+                    break;
+                  default: break;
+                }
+                if (stream_state == StreamState::PACKET_RESET) break;
               }
-              if (packet.header.sync == sync) {
+              if (uint8_t(packet.header.sync - sync) < BINARY_STREAM_WINDOW) {
+                if (slot_for(packet.header.sync).ready) {
+                  stream_state = StreamState::PACKET_RESET;   // already buffered, drop the copy
+                  break;
+                }
+                resend_sync = packet.header.sync;
                 buffer_next_index = 0;
                 packet.bytes_received = 0;
                 if (packet.header.size) {
                   stream_state = StreamState::PACKET_DATA;
-                  packet.buffer = static_cast<char *>(&buffer[0]); // multipacket buffering not implemented, always allocate whole buffer to packet
+                  packet.buffer = slot_for(packet.header.sync).data;
                 }
                 else
                   stream_state = StreamState::PACKET_PROCESS;
               }
-              else if (packet.header.sync == sync - 1) {           // ok response must have been lost
+              else if (uint8_t(sync - packet.header.sync) <= BINARY_STREAM_WINDOW) { // ok response must have been lost
                 SERIAL_ECHOLNPAIR("ok", packet.header.sync);  // transmit valid packet received and drop the payload
                 stream_state = StreamState::PACKET_RESET;
               }
@@ -357,7 +673,7 @@ public:
         case StreamState::PACKET_DATA:
           if (!stream_read(data)) break;
 
-          if (buffer_next_index < buffer_size)
+          if (buffer_next_index < BINARY_STREAM_PACKET_SIZE)
             packet.buffer[buffer_next_index] = data;
           else {
             SERIAL_ECHO_MSG("Datastream packet data buffer overrun");
@@ -388,21 +704,33 @@ public:
             }
           }
           break;
-        case StreamState::PACKET_PROCESS:
-          sync++;
-          packet_retries = 0;
-          bytes_received += packet.header.size;
-
-          SERIAL_ECHOLNPAIR("ok", packet.header.sync); // transmit valid packet received
-          dispatch();
+        case StreamState::PACKET_PROCESS: {
+          Slot &slot = slot_for(packet.header.sync);
+          slot.size = packet.header.size;
+          slot.meta = packet.header.meta;
+          slot.ready = true;
           stream_state = StreamState::PACKET_RESET;
-          break;
+
+          if (packet.header.sync != sync) {
+            // A packet went missing ahead of this one. Ask for it once.
+            if (!resend_requested && !slot_for(sync).ready) {
+              SERIAL_ECHO_MSG("Datastream packet(", sync, ") missing");
+              resend_sync = sync;
+              stream_state = StreamState::PACKET_RESEND;
+            }
+            break;
+          }
+
+          dispatch_window();
+          if (!card.flag.binary_mode) return; // Back to ASCII after CLOSE
+        } break;
         case StreamState::PACKET_RESEND:
           if (packet_retries < MAX_RETRIES || MAX_RETRIES == 0) {
             packet_retries++;
+            if (resend_sync == sync) resend_requested = true;
             stream_state = StreamState::PACKET_RESET;
             SERIAL_ECHO_MSG("Resend request ", packet_retries);
-            SERIAL_ECHOLNPAIR("rs", sync);
+            SERIAL_ECHOLNPAIR("rs", resend_sync);
           }
           else
             stream_state = StreamState::PACKET_ERROR;
@@ -422,10 +750,60 @@ public:
     #pragma GCC diagnostic pop
   }
 
-  void dispatch() {
-    switch (static_cast<Protocol>(packet.header.protocol())) {
+  /**
+   * Acknowledge and dispatch the buffered packets that are next in order.
+   * Stop at a packet that has to wait for room in the command queue,
+   * unless it's a stream print WRITE with a transfer ABORT behind it.
+   */
+  void dispatch_window() {
+    for (;;) {
+      Slot &slot = slot_for(sync);
+      if (!slot.ready) return;
+
+      #if ENABLED(BINARY_GCODE)
+        // Hold the ACK until the commands are all queued
+        if (static_cast<Protocol>(slot.protocol()) == Protocol::GCODE
+          && !BinaryGCodeProtocol::process(slot.type(), slot.data, slot.size)
+        ) return;
+      #endif
+
+      #if ENABLED(BINARY_STREAM_PRINT)
+        // Hold the ACK until the print buffer takes the data
+        if (static_cast<Protocol>(slot.protocol()) == Protocol::FILE_TRANSFER
+          && !SDFileTransferProtocol::accept(slot.type(), slot.data, slot.size)
+        ) {
+          // An ABORT behind it goes ahead. Drop the held data and everything up to the ABORT.
+          const uint8_t s = abort_sync();
+          if (s == sync) return;
+          while (sync != s) acknowledge(slot_for(sync));
+          continue;
+        }
+      #endif
+
+      acknowledge(slot);
+      dispatch(slot);
+
+      if (!card.flag.binary_mode) {    // CLOSE drops anything sent after it
+        clear_window();
+        return;
+      }
+    }
+  }
+
+  // Free the slot and acknowledge the packet in it
+  void acknowledge(Slot &slot) {
+    slot.ready = false;
+    packet_retries = 0;
+    resend_requested = false;
+    bytes_received += slot.size;
+
+    SERIAL_ECHOLNPAIR("ok", sync++); // transmit valid packet received
+  }
+
+  void dispatch(Slot &slot) {
+    switch (static_cast<Protocol>(slot.protocol())) {
       case Protocol::CONTROL:
-        switch (static_cast<ProtocolControl>(packet.header.type())) {
+        switch (static_cast<ProtocolControl>(slot.type())) {
           case ProtocolControl::CLOSE: // revert back to ASCII mode
             card.flag.binary_mode = false;
             break;
@@ -434,8 +812,11 @@ public:
         }
         break;
       case Protocol::FILE_TRANSFER:
-        SDFileTransferProtocol::process(packet.header.type(), packet.buffer, packet.header.size); // send user data to be processed
+        SDFileTransferProtocol::process(slot.type(), slot.data, slot.size); // send user data to be processed
       break;
+      #if ENABLED(BINARY_GCODE)
+        case Protocol::GCODE: break; // Queued before the ACK
+      #endif
       default:
         SERIAL_ECHO_MSG("Unsupported Binary Protocol");
     }
@@ -446,8 +827,9 @@ public:
     SDFileTransferProtocol::idle();
   }
 
-  static const uint16_t PACKET_MAX_WAIT = 500, RX_TIMESLICE = 20, MAX_RETRIES = 0, VERSION_MAJOR = 0, VERSION_MINOR = 1, VERSION_PATCH = 0;
-  uint8_t  packet_retries, sync;
+  static const uint16_t PACKET_MAX_WAIT = 500, RX_TIMESLICE = 20, MAX_RETRIES = 0, VERSION_MAJOR = 0, VERSION_MINOR = 2, VERSION_PATCH = 0;
+  uint8_t  packet_retries, sync, resend_sync;
+  bool resend_requested;
   uint16_t buffer_next_index;
   uint32_t bytes_received;
   StreamState stream_state = StreamState::PACKET_RESET;
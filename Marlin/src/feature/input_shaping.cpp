@@ -0,0 +1,100 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if HAS_SHAPING
+
+#include "input_shaping.h"
+
+/**
+ * Impulse sequences, as a fraction of the damped period Td:
+ *
+ *   ZV  : 1, K                      at 0, Td/2
+ *   ZVD : 1, 2K, K²                 at 0, Td/2, Td
+ *   MZV : 1-1/√2, (√2-1)K, (1-1/√2)K²  at 0, 3Td/8, 3Td/4   (K uses 3/4 of the decay)
+ *   EI  : (1+V)/4, (1-V)K/2, (1+V)K²/4 at 0, Td/2, Td       (V = 5% tolerated vibration)
+ *
+ * Where K is the decay of the oscillation over half a period.
+ * Weights are normalized to sum to exactly SHAPING_ONE_STEP.
+ */
+void AxisShaper::set_params(const shaping_params_t &p) {
+  params = p;
+
+  float a[SHAPING_MAX_IMPULSES], t[SHAPING_MAX_IMPULSES];
+  uint8_t n;
+
+  if (p.frequency <= 0)
+    n = 1, a[0] = 1, t[0] = 0;
+  else {
+    const float zeta = constrain(p.zeta, 0, 0.99f),
+                df = SQRT(1.0f - sq(zeta)),
+                td = 1.0f / (p.frequency * df),
+                K = expf(-zeta * float(M_PI) / df);
+
+    switch (p.type) {
+      default:
+      case SHAPER_ZV:
+        n = 2;
+        a[0] = 1;    a[1] = K;
+        t[0] = 0;    t[1] = 0.5f * td;
+        break;
+
+      case SHAPER_ZVD:
+        n = 3;
+        a[0] = 1;    a[1] = 2 * K;     a[2] = sq(K);
+        t[0] = 0;    t[1] = 0.5f * td; t[2] = td;
+        break;
+
+      case SHAPER_MZV: {
+        const float k = expf(-0.75f * zeta * float(M_PI) / df),
+                    a1 = 1.0f - float(M_SQRT1_2);
+        n = 3;
+        a[0] = a1;   a[1] = (float(M_SQRT2) - 1.0f) * k; a[2] = a1 * sq(k);
+        t[0] = 0;    t[1] = 0.375f * td;                t[2] = 0.75f * td;
+      } break;
+
+      case SHAPER_EI: {
+        constexpr float v_tol = 0.05f;
+        n = 3;
+        a[0] = 0.25f * (1.0f + v_tol); a[1] = 0.5f * (1.0f - v_tol) * K; a[2] = a[0] * sq(K);
+        t[0] = 0;                      t[1] = 0.5f * td;                 t[2] = td;
+      } break;
+    }
+  }
+
+  float sum = 0;
+  LOOP_L_N(i, n) sum += a[i];
+
+  int16_t total = 0;
+  LOOP_L_N(i, n) {
+    weight[i] = (i < n - 1) ? int16_t(LROUND(a[i] / sum * SHAPING_ONE_STEP)) : int16_t(SHAPING_ONE_STEP - total);
+    total += weight[i];
+    delay[i] = uint32_t(t[i] * (STEPPER_TIMER_RATE));
+  }
+
+  impulses = n;
+  head = 0;
+  LOOP_L_N(i, SHAPING_MAX_IMPULSES) tail[i] = 0;
+}
+
+#endif // HAS_SHAPING
@@ -0,0 +1,156 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * input_shaping.h - Step stream input shaping for the X and Y axes
+ *
+ * The stepper's Bresenham tracer produces "source" steps exactly as before.
+ * Each source step on a shaped axis is split into up to three weighted
+ * impulses, released at the shaper's delays. The weighted impulses are summed
+ * into a fixed-point fractional position and a real step is output whenever
+ * it drifts more than half a step (plus a little hysteresis) from the motor.
+ *
+ * Since the impulse weights sum to exactly one step, the motor always ends up
+ * at the source position once all impulses have been released.
+ */
+
+#include "../inc/MarlinConfigPre.h"
+
+enum ShaperType : uint8_t { SHAPER_ZV, SHAPER_ZVD, SHAPER_MZV, SHAPER_EI };
+#define NUM_SHAPER_TYPES 4
+
+typedef struct {
+  float frequency;  // (Hz) Resonant frequency to cancel. 0 = Shaping disabled.
+  float zeta;       // Damping ratio, 0 (undamped) to <1 (critically damped)
+  ShaperType type;  // Shaper impulse sequence
+} shaping_params_t;
+
+#define SHAPING_MAX_IMPULSES 3
+#define SHAPING_ONE_STEP     (1L << 14)                                 // Fixed-point weight of one whole step
+#define SHAPING_THRESHOLD    (SHAPING_ONE_STEP / 2 + SHAPING_ONE_STEP / 8) // Half a step plus hysteresis against dithering
+#define SHAPING_QUEUE_MASK   ((SHAPING_BUFFER_SIZE) - 1)
+
+class AxisShaper {
+  public:
+    static constexpr uint32_t SHAPING_NEVER = 0xFFFFFFFF;
+
+    shaping_params_t params;
+
+    bool forward = true;                          // Direction of the DIR pin, as last set
+
+  private:
+    uint8_t impulses = 1;                         // Impulses in use. 1 = pass-through.
+    int16_t weight[SHAPING_MAX_IMPULSES] = { SHAPING_ONE_STEP };
+    uint32_t delay[SHAPING_MAX_IMPULSES] = { 0 }; // Impulse delays in stepper timer ticks
+
+    // Timestamps of source steps awaiting their delayed impulses. Bit 0 holds the direction.
+    uint32_t queue[SHAPING_BUFFER_SIZE];
+    uint16_t head = 0, tail[SHAPING_MAX_IMPULSES] = { 0 };
+
+    int32_t error = 0;                            // Shaped position minus motor position
+
+    // Add a weighted impulse and return the step (-1, 0, 1) needed to follow it
+    FORCE_INLINE int8_t add(const int16_t w) {
+      error += w;
+      if (error >= SHAPING_THRESHOLD)  { error -= SHAPING_ONE_STEP; return  1; }
+      if (error <= -SHAPING_THRESHOLD) { error += SHAPING_ONE_STEP; return -1; }
+      return 0;
+    }
+
+    FORCE_INLINE int32_t due_in(const uint8_t i, const uint32_t now) const {
+      return int32_t((queue[tail[i]] & ~1UL) + delay[i] - now);
+    }
+
+  public:
+
+    // Compute the impulse sequence for new parameters. Only call with an empty queue.
+    void set_params(const shaping_params_t &p);
+
+    FORCE_INLINE bool enabled() const { return impulses > 1; }
+
+    // Are there delayed impulses still to be released?
+    FORCE_INLINE bool busy() const { return head != tail[impulses - 1]; }
+
+    /**
+     * Drop the delayed impulses and any fractional position, as when a move is aborted.
+     * Return the whole steps the motor still owed, which it will now never take.
+     */
+    int32_t clear() {
+      int32_t owed = error;
+      for (uint8_t i = 1; i < impulses; ++i) {
+        for (uint16_t t = tail[i]; t != head; t = (t + 1) & SHAPING_QUEUE_MASK)
+          owed += TEST(queue[t], 0) ? weight[i] : -weight[i];
+        tail[i] = 0;
+      }
+      head = tail[0] = 0;
+      error = 0;
+      return owed / SHAPING_ONE_STEP;             // Whole, since the weights sum to one step
+    }
+
+    // Free queue entries. The slowest impulse holds entries the longest.
+    FORCE_INLINE uint16_t free_count() const {
+      return SHAPING_QUEUE_MASK - ((head - tail[impulses - 1]) & SHAPING_QUEUE_MASK);
+    }
+
+    /**
+     * Take a source step made at the given time and apply its
+     * first impulse. Return true if a motor step is needed now.
+     * The resulting step is always in the source step direction.
+     */
+    FORCE_INLINE bool source_step(const uint32_t now, const bool fwd) {
+      if (enabled()) {
+        queue[head] = (now & ~1UL) | fwd;
+        head = (head + 1) & SHAPING_QUEUE_MASK;
+      }
+      return add(fwd ? weight[0] : -weight[0]) != 0;
+    }
+
+    /**
+     * Release delayed impulses that have come due, stopping at the
+     * first one that needs a motor step. Return the step direction
+     * (-1 or 1) or 0 if no step is needed.
+     */
+    FORCE_INLINE int8_t release(const uint32_t now) {
+      for (uint8_t i = 1; i < impulses; ++i) {
+        while (tail[i] != head && due_in(i, now) <= 0) {
+          const bool fwd = TEST(queue[tail[i]], 0);
+          tail[i] = (tail[i] + 1) & SHAPING_QUEUE_MASK;
+          const int8_t s = add(fwd ? weight[i] : -weight[i]);
+          if (s) return s;
+        }
+      }
+      return 0;
+    }
+
+    // Ticks until the next delayed impulse is due, or SHAPING_NEVER
+    FORCE_INLINE uint32_t next_due(const uint32_t now) const {
+      uint32_t next = SHAPING_NEVER;
+      for (uint8_t i = 1; i < impulses; ++i) {
+        if (tail[i] != head) {
+          const int32_t d = due_in(i, now);
+          NOMORE(next, uint32_t(_MAX(d, int32_t(0))));
+        }
+      }
+      return next;
+    }
+};
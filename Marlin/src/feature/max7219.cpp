@@ -555,7 +555,8 @@ void Max7219::init() {
  */
 
 // Apply changes to update a marker
-void Max7219::mark16(const uint8_t pos, const uint8_t v1, const uint8_t v2) {
+// Positions may be planner indexes (up to 1023), shown modulo 16
+void Max7219::mark16(const uint8_t pos, const uint16_t v1, const uint16_t v2) {
   #if MAX7219_X_LEDS > 8    // At least 16 LEDs on the X-Axis. Use single line.
     led_off(v1 & 0xF, pos);
      led_on(v2 & 0xF, pos);
@@ -563,13 +564,13 @@ void Max7219::mark16(const uint8_t pos, const uint8_t v1, const uint8_t v2) {
     led_off(pos, v1 & 0xF);
      led_on(pos, v2 & 0xF);
   #else                     // Single 8x8 LED matrix. Use two lines to get 16 LEDs.
-    led_off(v1 & 0x7, pos + (v1 >= 8));
-     led_on(v2 & 0x7, pos + (v2 >= 8));
+    led_off(v1 & 0x7, pos + TEST(v1, 3));
+     led_on(v2 & 0x7, pos + TEST(v2, 3));
   #endif
 }
 
 // Apply changes to update a tail-to-head range
-void Max7219::range16(const uint8_t y, const uint8_t ot, const uint8_t nt, const uint8_t oh, const uint8_t nh) {
+void Max7219::range16(const uint8_t y, const uint16_t ot, const uint16_t nt, const uint16_t oh, const uint16_t nh) {
   #if MAX7219_X_LEDS > 8    // At least 16 LEDs on the X-Axis. Use single line.
     if (ot != nt) for (uint8_t n = ot & 0xF; n != (nt & 0xF) && n != (nh & 0xF); n = (n + 1) & 0xF)
       led_off(n & 0xF, y);
@@ -609,10 +610,10 @@ void Max7219::idle_tasks() {
   #if MAX7219_USE_HEAD || MAX7219_USE_TAIL
     CRITICAL_SECTION_START();
     #if MAX7219_USE_HEAD
-      const uint8_t head = planner.block_buffer_head;
+      const block_index_t head = planner.block_buffer_head;
     #endif
     #if MAX7219_USE_TAIL
-      const uint8_t tail = planner.block_buffer_tail;
+      const block_index_t tail = planner.block_buffer_tail;
     #endif
     CRITICAL_SECTION_END();
   #endif
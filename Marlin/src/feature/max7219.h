@@ -145,8 +145,8 @@ private:
   static void set(const uint8_t line, const uint8_t bits);
   static void send_row(const uint8_t row);
   static void send_column(const uint8_t col);
-  static void mark16(const uint8_t y, const uint8_t v1, const uint8_t v2);
-  static void range16(const uint8_t y, const uint8_t ot, const uint8_t nt, const uint8_t oh, const uint8_t nh);
+  static void mark16(const uint8_t y, const uint16_t v1, const uint16_t v2);
+  static void range16(const uint8_t y, const uint16_t ot, const uint16_t nt, const uint16_t oh, const uint16_t nh);
   static void quantity16(const uint8_t y, const uint8_t ov, const uint8_t nv);
 
   #ifdef MAX7219_INIT_TEST
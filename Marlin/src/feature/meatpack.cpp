@@ -39,11 +39,12 @@
 
 #include "../inc/MarlinConfig.h"
 
-#if HAS_MEATPACK
+#if HAS_MEATPACK || ENABLED(MEATPACK_SD_FILES)
 
 #include "meatpack.h"
 
 #define MeatPack_ProtocolVersion "PV01"
+#define MeatPack_ProtocolVersion2 "PV02"
 //#define MP_DEBUG
 
 #define DEBUG_OUT ENABLED(MP_DEBUG)
@@ -57,6 +58,24 @@ uint8_t meatPackLookupTable[16] = {
   '\0' // Unused. 0b1111 indicates a literal character
 };
 
+#if ENABLED(MEATPACK_V2)
+
+  /**
+   * Default v2 tables. The symbols are the v1 table. The tokens are the
+   * words that start most lines from a slicer, and the parameter letters
+   * that v1 had to send as literals, with the space before them.
+   */
+  static const char meatPackV2Symbols[15] PROGMEM = {
+    '0', '1', '2', '3', '4', '5', '6', '7', '8', '9',
+    '.', ' ', '\n', 'G', 'X'
+  };
+  static const char meatPackV2Tokens[15][MEATPACK_TOKEN_SIZE] PROGMEM = {
+    "G1 X", " Y", " E", " F", " Z", "G1 ", "G0 ", "-",
+    "E", "Y", "F", "Z", "M", "S", "T"
+  };
+
+#endif
+
 #if ENABLED(MP_DEBUG)
   uint8_t chars_decoded = 0;  // Log the first 64 bytes after each reset
 #endif
@@ -66,9 +85,101 @@ void MeatPack::reset_state() {
   cmd_is_next = false;
   second_char = 0;
   cmd_count = full_char_count = char_out_count = 0;
+  #if ENABLED(MEATPACK_V2)
+    nibble_state = kNibbleSymbol;
+    arg_command = MPCommand_None;
+    load_tables();
+  #endif
   TERN_(MP_DEBUG, chars_decoded = 0);
 }
 
+#if ENABLED(MEATPACK_V2)
+
+  void MeatPack::load_tables() {
+    memcpy_P(symbols, meatPackV2Symbols, sizeof(symbols));
+    memcpy_P(tokens, meatPackV2Tokens, sizeof(tokens));
+  }
+
+  void MeatPack::begin_packed() {
+    reset_state();
+    state = _BV(MPConfig_Bit_Active) | _BV(MPConfig_Bit_Version2);
+  }
+
+  /**
+   * Interpret one v2 nibble: a symbol, an escape, a token index,
+   * or half of a literal byte.
+   */
+  void MeatPack::handle_nibble(const uint8_t n) {
+    switch (nibble_state) {
+      case kNibbleSymbol:
+        if (n == kEscape)
+          nibble_state = kNibbleToken;
+        else
+          handle_output_char(symbols[n]);
+        break;
+
+      case kNibbleToken:
+        if (n == kEscape) {                               // Two escapes in a row start a literal byte
+          nibble_state = kNibbleLiteralLow;
+          break;
+        }
+        LOOP_L_N(i, MEATPACK_TOKEN_SIZE) {
+          const char c = tokens[n][i];
+          if (!c) break;
+          handle_output_char(c);
+        }
+        nibble_state = kNibbleSymbol;
+        break;
+
+      case kNibbleLiteralLow:
+        literal = n;
+        nibble_state = kNibbleLiteralHigh;
+        break;
+
+      case kNibbleLiteralHigh:
+        handle_output_char(literal | (n << 4));
+        nibble_state = kNibbleSymbol;
+        break;
+    }
+  }
+
+  /**
+   * Take one argument byte of a v2 command
+   */
+  void MeatPack::handle_argument(const uint8_t c) {
+    const uint16_t i = arg_index++;
+    switch (arg_command) {
+      case MPCommand_SelectVersion:
+        SET_BIT_TO(state, MPConfig_Bit_Version2, c == 2);
+        nibble_state = kNibbleSymbol;
+        full_char_count = 0;
+        second_char = 0;
+        break;
+
+      case MPCommand_SetSymbols:
+        symbols[i] = c;
+        break;
+
+      case MPCommand_SetToken:
+        // Index, then length, then the characters. Characters past MEATPACK_TOKEN_SIZE
+        // are still read, so any length byte consumes all of its argument bytes.
+        if (i == 0) token_index = c;
+        else if (i == 1) {
+          arg_count = 2 + c;
+          if (token_index < kTableSize) memset(tokens[token_index], 0, MEATPACK_TOKEN_SIZE);
+        }
+        else if (token_index < kTableSize && i - 2 < MEATPACK_TOKEN_SIZE)
+          tokens[token_index][i - 2] = c;
+        break;
+    }
+    if (arg_index >= arg_count) {
+      arg_command = MPCommand_None;
+      DEBUG_ECHOLNPGM("[MPDBG] ARGS DONE");
+    }
+  }
+
+#endif // MEATPACK_V2
+
 /**
  * Unpack one or two characters from a packed byte into a buffer.
  * Return flags indicating whether any literal bytes follow.
@@ -100,6 +211,15 @@ uint8_t MeatPack::unpack_chars(const uint8_t pk, uint8_t* __restrict const chars
  * according to the current MeatPack state.
  */
 void MeatPack::handle_rx_char_inner(const uint8_t c) {
+  #if ENABLED(MEATPACK_V2)
+    if (TEST(state, MPConfig_Bit_Active) && TEST(state, MPConfig_Bit_Version2)) {
+      handle_nibble(c & 0x0F);
+      // A newline ends the byte, so every line starts on a byte boundary
+      if (char_out_count && char_out_buf[char_out_count - 1] == '\n' && nibble_state == kNibbleSymbol) return;
+      handle_nibble(c >> 4);
+      return;
+    }
+  #endif
   if (TEST(state, MPConfig_Bit_Active)) {                   // Is MeatPack active?
     if (!full_char_count) {                                 // No literal characters to fetch?
       uint8_t buf[2] = { 0, 0 };
@@ -161,16 +281,21 @@ void MeatPack::handle_command(const MeatPack_Command c) {
     case MPCommand_DisableNoSpaces:
       CBI(state, MPConfig_Bit_NoSpaces);
       meatPackLookupTable[kSpaceCharIdx] = ' ';                        DEBUG_ECHOLNPGM("[MPDBG] DIS NSP");   break;
+    #if ENABLED(MEATPACK_V2)
+      // Commands with arguments take the next bytes as they come
+      case MPCommand_SelectVersion: start_arguments(c, 1);             DEBUG_ECHOLNPGM("[MPDBG] VER REC");   break;
+      case MPCommand_SetSymbols:    start_arguments(c, kTableSize);    DEBUG_ECHOLNPGM("[MPDBG] SYM REC");   break;
+      case MPCommand_SetToken:      start_arguments(c, 2);             DEBUG_ECHOLNPGM("[MPDBG] TOK REC");   break; // Index and length, then the length is added
+    #endif
     default:                                                           DEBUG_ECHOLNPGM("[MPDBG] UNK CMD REC");
   }
-  report_state();
 }
 
 void MeatPack::report_state() {
   // NOTE: if any configuration vars are added below, the outgoing sync text for host plugin
   // should not contain the "PV' substring, as this is used to indicate protocol version
   SERIAL_ECHOPGM("[MP] ");
-  SERIAL_ECHOPGM(MeatPack_ProtocolVersion " ");
+  SERIAL_ECHOPGM_P(TERN0(MEATPACK_V2, TEST(state, MPConfig_Bit_Version2)) ? PSTR(MeatPack_ProtocolVersion2 " ") : PSTR(MeatPack_ProtocolVersion " "));
   serialprint_onoff(TEST(state, MPConfig_Bit_Active));
   SERIAL_ECHOPGM_P(TEST(state, MPConfig_Bit_NoSpaces) ? PSTR(" NSP\n") : PSTR(" ESP\n"));
 }
@@ -180,6 +305,17 @@ void MeatPack::report_state() {
  * according to the current meatpack state.
  */
 void MeatPack::handle_rx_char(const uint8_t c, const serial_index_t serial_ind) {
+  #if ENABLED(MEATPACK_V2)
+    if (arg_command) {                    // Command arguments may be any byte
+      handle_argument(c);
+      if (!arg_command && serial_ind.valid()) {
+        PORT_REDIRECT(SERIAL_PORTMASK(serial_ind));
+        report_state();
+      }
+      return;
+    }
+  #endif
+
   if (c == kCommandByte) {                // A command (0xFF) byte?
     if (cmd_count) {                      // In fact, two in a row?
       cmd_is_next = true;                 // Then a MeatPack command follows
@@ -191,9 +327,12 @@ void MeatPack::handle_rx_char(const uint8_t c, const serial_index_t serial_ind)
   }
 
   if (cmd_is_next) {                      // Were two command bytes received?
-    PORT_REDIRECT(SERIAL_PORTMASK(serial_ind));
-    handle_command((MeatPack_Command)c);  // Then the byte is a MeatPack command
     cmd_is_next = false;
+    handle_command((MeatPack_Command)c);  // Then the byte is a MeatPack command
+    if (TERN1(MEATPACK_V2, !arg_command) && serial_ind.valid()) {
+      PORT_REDIRECT(SERIAL_PORTMASK(serial_ind));
+      report_state();                     // Report the new state unless arguments are still to come
+    }
     return;
   }
 
@@ -216,4 +355,4 @@ uint8_t MeatPack::get_result_char(char * const __restrict out) {
   return res;
 }
 
-#endif // HAS_MEATPACK
+#endif // HAS_MEATPACK || MEATPACK_SD_FILES
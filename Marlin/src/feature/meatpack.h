@@ -45,10 +45,19 @@
  * baud rate provided by Prusa's Atmega2560-based boards, over the USB serial connection. So soft-
  * ware like OctoPrint would also suffer this same micro-stuttering and poor print quality issue.
  *
+ * Version 2 (MEATPACK_V2)
+ *
+ * The stream is a run of nibbles, low nibble first. Nibbles 0-14 are symbols from a 15-character
+ * table. Nibble 15 is an escape, and the nibble after it picks one of 15 tokens of up to
+ * MEATPACK_TOKEN_SIZE characters, such as "G1 X" or " E". An escape followed by a second
+ * escape means the next two nibbles are a literal byte. A newline ends its byte, so every
+ * line starts on a byte boundary. The host can replace both tables to suit the G-code it sends,
+ * and a file packed with the same commands at its head can be printed from SD as a *.MP file.
+ *
  */
 #pragma once
 
-#include <stdint.h>
+#include "../inc/MarlinConfigPre.h"
 #include "../core/serial_hook.h"
 
 /**
@@ -70,12 +79,16 @@ enum MeatPack_Command : uint8_t {
   MPCommand_ResetAll        = 0xF9,
   MPCommand_QueryConfig     = 0xF8,
   MPCommand_EnableNoSpaces  = 0xF7,
-  MPCommand_DisableNoSpaces = 0xF6
+  MPCommand_DisableNoSpaces = 0xF6,
+  MPCommand_SelectVersion   = 0xF5, // + Version (1 or 2)
+  MPCommand_SetSymbols      = 0xF4, // + 15 symbol characters (v2)
+  MPCommand_SetToken        = 0xF3  // + Token index (0-14), length, characters (v2)
 };
 
 enum MeatPack_ConfigStateBits : uint8_t {
   MPConfig_Bit_Active   = 0,
-  MPConfig_Bit_NoSpaces = 1
+  MPConfig_Bit_NoSpaces = 1,
+  MPConfig_Bit_Version2 = 2
 };
 
 class MeatPack {
@@ -90,13 +103,42 @@ class MeatPack {
   static const uint8_t kSpaceCharIdx = 11;
   static const char kSpaceCharReplace = 'E';
 
+  #if ENABLED(MEATPACK_V2)
+    static const uint8_t kEscape    = 0x0F,
+                         kTableSize = 15;
+
+    // How the next v2 nibble is read
+    enum NibbleState : uint8_t { kNibbleSymbol, kNibbleToken, kNibbleLiteralLow, kNibbleLiteralHigh };
+  #endif
+
+public:
+  // The most characters one stream byte can produce
+  static const uint8_t kMaxOutput = TERN(MEATPACK_V2, _MAX(2, MEATPACK_TOKEN_SIZE + 1), 2);
+
+private:
   bool cmd_is_next;        // A command is pending
   uint8_t state;           // Configuration state
   uint8_t second_char;     // Buffers a character if dealing with out-of-sequence pairs
   uint8_t cmd_count,       // Counter of command bytes received (need 2)
           full_char_count, // Counter for full-width characters to be received
           char_out_count;  // Stores number of characters to be read out.
-  uint8_t char_out_buf[2]; // Output buffer for caching up to 2 characters
+  uint8_t char_out_buf[kMaxOutput]; // Output buffer for the characters from one stream byte
+
+  #if ENABLED(MEATPACK_V2)
+    uint8_t nibble_state,  // NibbleState of the v2 decoder
+            literal,       // Low nibble of a v2 literal byte
+            arg_command,   // Command still reading its argument bytes
+            token_index;   // Token being set by MPCommand_SetToken
+    uint16_t arg_index,    // Argument bytes read so far
+             arg_count;    // Argument bytes expected. A token length byte allows up to 2 + 255.
+    char symbols[kTableSize],                     // v2 symbol table
+         tokens[kTableSize][MEATPACK_TOKEN_SIZE]; // v2 token table. Short tokens end with a nul.
+
+    void load_tables();
+    inline void start_arguments(const uint8_t c, const uint8_t count) { arg_command = c; arg_index = 0; arg_count = count; }
+    void handle_nibble(const uint8_t n);
+    void handle_argument(const uint8_t c);
+  #endif
 
 public:
   // Pass in a character rx'd by SD card or serial. Automatically parses command/ctrl sequences,
@@ -105,9 +147,9 @@ public:
 
   /**
    * After passing in rx'd char using above method, call this to get characters out.
-   * Can return from 0 to 2 characters at once.
+   * Can return from 0 to kMaxOutput characters at once.
    * @param out [in] Output pointer for unpacked/processed data.
-   * @return Number of characters returned. Range from 0 to 2.
+   * @return Number of characters returned. Range from 0 to kMaxOutput.
    */
   uint8_t get_result_char(char * const __restrict out);
 
@@ -118,7 +160,17 @@ public:
   void handle_output_char(const uint8_t c);
   void handle_rx_char_inner(const uint8_t c);
 
-  MeatPack() : cmd_is_next(false), state(0), second_char(0), cmd_count(0), full_char_count(0), char_out_count(0) {}
+  #if ENABLED(MEATPACK_V2)
+    // Reset to v2 with packing on and the default tables, as a packed file begins
+    void begin_packed();
+    inline bool is_packing() const { return TEST(state, MPConfig_Bit_Active); }
+  #endif
+
+  MeatPack() : cmd_is_next(false), state(0), second_char(0), cmd_count(0), full_char_count(0), char_out_count(0)
+    #if ENABLED(MEATPACK_V2)
+      , nibble_state(kNibbleSymbol), literal(0), arg_command(MPCommand_None), token_index(0), arg_index(0), arg_count(0)
+    #endif
+  { TERN_(MEATPACK_V2, load_tables()); }
 };
 
 // Implement the MeatPack serial class so it's transparent to rest of the code
@@ -129,7 +181,7 @@ struct MeatpackSerial : public SerialBase <MeatpackSerial < SerialT >> {
   SerialT & out;
   MeatPack meatpack;
 
-  char serialBuffer[2];
+  char serialBuffer[MeatPack::kMaxOutput];
   uint8_t charCount;
   uint8_t readIndex;
 
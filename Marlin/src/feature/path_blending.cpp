@@ -0,0 +1,138 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(PATH_BLENDING)
+
+#include "path_blending.h"
+#include "../module/planner.h"
+
+PathBlender blender;
+
+float PathBlender::tolerance; // = 0
+uint32_t PathBlender::merged; // = 0
+
+uint8_t PathBlender::count; // = 0
+abce_pos_t PathBlender::start, PathBlender::points[PATH_BLENDING_MAX_SEGMENTS];
+feedRate_t PathBlender::feedrate;
+uint8_t PathBlender::extruder;
+bool PathBlender::printing;
+
+/**
+ * Can the held move be extended to the given target?
+ * Every point of the held move must lie within the tolerance of the
+ * new line, in order, with extrusion keeping pace with the motion.
+ */
+bool PathBlender::can_merge(const abce_pos_t &target) {
+  if (count >= PATH_BLENDING_MAX_SEGMENTS) return false;
+
+  #if HAS_EXTRUDERS
+    // Travel must stay travel, and printing must keep extruding
+    const float last_e = points[count - 1].e;
+    if (printing ? target.e <= last_e : target.e != last_e) return false;
+  #endif
+
+  xyz_float_t dist;
+  float len_sq = 0;
+  LOOP_LINEAR_AXES(i) {
+    dist[i] = target[i] - start[i];
+    len_sq += sq(dist[i]);
+  }
+  if (!len_sq) return false;
+
+  #if HAS_EXTRUDERS
+    // Allow the same relative deviation in E, but never less than one step
+    const float de = target.e - start.e,
+                e_tol = _MAX(tolerance * de / SQRT(len_sq), planner.steps_to_mm[E_AXIS_N(extruder)]);
+  #endif
+
+  const float tol_sq = sq(tolerance);
+  float last_t = 0;
+  LOOP_L_N(n, count) {
+    const abce_pos_t &p = points[n];
+    float dot = 0, dist_sq = 0;
+    LOOP_LINEAR_AXES(i) {
+      const float v = p[i] - start[i];
+      dot += v * dist[i];
+      dist_sq += sq(v);
+    }
+
+    // Points must be passed in order and lie within the new move
+    const float t = dot / len_sq;
+    if (t <= last_t || t >= 1) return false;
+
+    // Distance of the point from the new line
+    if (dist_sq - t * dot > tol_sq) return false;
+
+    #if HAS_EXTRUDERS
+      if (ABS(p.e - (start.e + t * de)) > e_tol) return false;
+    #endif
+
+    last_t = t;
+  }
+
+  return true;
+}
+
+bool PathBlender::add(const abce_pos_t &target, const_feedRate_t fr_mm_s, const uint8_t ext) {
+  if (!tolerance) return false;
+
+  if (count) {
+    if (fr_mm_s == feedrate && ext == extruder && can_merge(target)) {
+      points[count++] = target;
+      merged++;
+      return true;
+    }
+    _flush();
+  }
+
+  // Only hold moves that travel or print. Others go straight to the planner.
+  bool moves = false;
+  LOOP_LINEAR_AXES(i)
+    if (LROUND(target[i] * planner.settings.axis_steps_per_mm[i]) != planner.position[i]) moves = true;
+  if (!moves) return false;
+
+  #if HAS_EXTRUDERS
+    const int32_t de_steps = LROUND(target.e * planner.settings.axis_steps_per_mm[E_AXIS_N(ext)]) - planner.position.e;
+    if (de_steps < 0) return false;
+    printing = de_steps > 0;
+  #endif
+
+  // The held move starts where the planner left off
+  LOOP_LINEAR_AXES(i) start[i] = planner.position[i] * planner.steps_to_mm[i];
+  TERN_(HAS_EXTRUDERS, start.e = planner.position.e * planner.steps_to_mm[E_AXIS_N(ext)]);
+
+  feedrate = fr_mm_s;
+  extruder = ext;
+  points[0] = target;
+  count = 1;
+  return true;
+}
+
+void PathBlender::_flush() {
+  const abce_pos_t &target = points[count - 1];
+  count = 0; // Clear first. The planner flushes before queueing.
+  planner.buffer_segment(target, feedrate, extruder);
+}
+
+#endif // PATH_BLENDING
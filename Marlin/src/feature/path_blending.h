@@ -0,0 +1,64 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * path_blending.h - Merge runs of nearly collinear moves (G64)
+ *
+ * The last linear move given to the planner is held back. Each following move
+ * with the same feedrate and kind (printing or travel) is merged into it, as
+ * long as every point along the way stays within the tolerance of the longer
+ * straight line. The held move is queued as soon as a move can't be merged,
+ * any other command arrives, or the planner is about to run out of moves.
+ */
+
+#include "../inc/MarlinConfigPre.h"
+#include "../core/types.h"
+
+class PathBlender {
+  public:
+    static float tolerance;       // (mm) Allowed deviation from the original path. 0 = Off.
+    static uint32_t merged;       // Segments merged into a previous move
+
+    static void set_tolerance(const_float_t mm) { flush(); tolerance = mm; }
+
+    // Hold or merge a move to the given machine position. Return false if the planner should take it.
+    static bool add(const abce_pos_t &target, const_feedRate_t fr_mm_s, const uint8_t extruder);
+
+    // Queue the held move, if any
+    static void flush() { if (count) _flush(); }
+
+    // Forget the held move, as on quick stop
+    static void discard() { count = 0; }
+
+  private:
+    static uint8_t count;         // Points in the held move. The last one is its end.
+    static abce_pos_t start, points[PATH_BLENDING_MAX_SEGMENTS];
+    static feedRate_t feedrate;
+    static uint8_t extruder;
+    static bool printing;         // The held move extrudes
+
+    static bool can_merge(const abce_pos_t &target);
+    static void _flush();
+};
+
+extern PathBlender blender;
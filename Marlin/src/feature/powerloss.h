@@ -143,7 +143,7 @@ class PrintJobRecovery {
 
     static uint8_t queue_index_r;     //!< Queue index of the active command
     static uint32_t cmd_sdpos,        //!< SD position of the next command
-                    sdpos[BUFSIZE];   //!< SD positions of queued commands
+                    sdpos[MAX_QUEUED_COMMANDS]; //!< SD positions of queued commands
 
     static void init();
     static void prepare();
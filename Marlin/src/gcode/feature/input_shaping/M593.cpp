@@ -0,0 +1,87 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../../inc/MarlinConfig.h"
+
+#if HAS_SHAPING
+
+#include "../../gcode.h"
+#include "../../../module/stepper.h"
+
+static void report_shaping(const AxisEnum axis) {
+  const shaping_params_t p = stepper.get_shaping_params(axis);
+  SERIAL_ECHO_START();
+  SERIAL_ECHOLNPAIR("  M593 ", AS_CHAR(AXIS_CHAR(axis)), " F", p.frequency, " D", p.zeta, " T", int(p.type));
+}
+
+/**
+ * M593: Get or Set Input Shaping Parameters
+ *
+ *  X          Apply the given parameters to the X axis
+ *  Y          Apply the given parameters to the Y axis
+ *             (With no axis given, apply to all shaped axes)
+ *  F<hz>      Resonant frequency to cancel. 0 disables shaping.
+ *  D<zeta>    Damping ratio (0.0 - 0.99)
+ *  T<type>    Shaper type: 0=ZV 1=ZVD 2=MZV 3=EI
+ *
+ *  With no parameters, report the current settings.
+ */
+void GcodeSuite::M593() {
+  if (!parser.seen("FDT")) {
+    TERN_(INPUT_SHAPING_X, report_shaping(X_AXIS));
+    TERN_(INPUT_SHAPING_Y, report_shaping(Y_AXIS));
+    return;
+  }
+
+  const bool seen_x = parser.seen_test('X'), seen_y = parser.seen_test('Y'),
+             for_x = TERN0(INPUT_SHAPING_X, seen_x || !seen_y),
+             for_y = TERN0(INPUT_SHAPING_Y, seen_y || !seen_x);
+
+  if (parser.seenval('F')) {
+    const float f = parser.value_float();
+    if (f != 0 && !WITHIN(f, SHAPING_MIN_FREQ, SHAPING_MAX_FREQ)) {
+      SERIAL_ECHO_MSG("?F must be 0 or from ", SHAPING_MIN_FREQ, " to ", SHAPING_MAX_FREQ, " Hz.");
+      return;
+    }
+  }
+  if (parser.seenval('D') && !WITHIN(parser.value_float(), 0, 0.99f)) {
+    SERIAL_ECHO_MSG("?D (zeta) must be from 0 to 0.99.");
+    return;
+  }
+  if (parser.seenval('T') && !WITHIN(parser.value_int(), 0, NUM_SHAPER_TYPES - 1)) {
+    SERIAL_ECHO_MSG("?T (type) must be from 0 to ", NUM_SHAPER_TYPES - 1, ".");
+    return;
+  }
+
+  auto set_axis = [](const AxisEnum axis) {
+    shaping_params_t p = stepper.get_shaping_params(axis);
+    if (parser.seenval('F')) p.frequency = parser.value_float();
+    if (parser.seenval('D')) p.zeta = parser.value_float();
+    if (parser.seenval('T')) p.type = (ShaperType)parser.value_int();
+    stepper.set_shaping_params(axis, p);
+  };
+
+  if (for_x) set_axis(X_AXIS);
+  if (for_y) set_axis(Y_AXIS);
+}
+
+#endif // HAS_SHAPING
@@ -19,31 +19,27 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  *
  */
-#ifdef __PLAT_LINUX__
 
-#include "IOLoggerCSV.h"
+#include "../../../inc/MarlinConfig.h"
 
-IOLoggerCSV::IOLoggerCSV(std::string filename) {
-  file.open(filename);
-}
-
-IOLoggerCSV::~IOLoggerCSV() {
-  file.close();
-}
+#if ENABLED(PATH_BLENDING)
 
-void IOLoggerCSV::log(GpioEvent ev) {
-  std::lock_guard<std::mutex> lock(vector_lock);
-  events.push_back(ev); //minimal impact to signal handler
-}
+#include "../../gcode.h"
+#include "../../../feature/path_blending.h"
 
-void IOLoggerCSV::flush() {
-  { std::lock_guard<std::mutex> lock(vector_lock);
-    while (!events.empty()) {
-      file << events.front().timestamp << ", "<< events.front().pin_id << ", " << events.front().event << std::endl;
-      events.pop_front();
-    }
+/**
+ * G64: Set the path blending tolerance
+ *
+ *  P<mm>   Allowed deviation from the programmed path. 0 disables blending.
+ *          With no P, use the default PATH_BLENDING_TOLERANCE.
+ */
+void GcodeSuite::G64() {
+  const float p = parser.linearval('P', PATH_BLENDING_TOLERANCE);
+  if (p < 0) {
+    SERIAL_ECHO_MSG("?P must be 0 or more.");
+    return;
   }
-  file.flush();
+  blender.set_tolerance(p);
 }
 
-#endif // __PLAT_LINUX__
+#endif // PATH_BLENDING
@@ -19,22 +19,23 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  *
  */
-#pragma once
 
-#include <mutex>
-#include <list>
-#include <fstream>
-#include "Gpio.h"
+#include "../../../inc/MarlinConfig.h"
 
-class IOLoggerCSV: public IOLogger {
-public:
-  IOLoggerCSV(std::string filename);
-  virtual ~IOLoggerCSV();
-  void flush();
-  void log(GpioEvent ev);
+#if ENABLED(PATH_BLENDING)
 
-private:
-  std::ofstream file;
-  std::list<GpioEvent> events;
-  std::mutex vector_lock;
-};
+#include "../../gcode.h"
+#include "../../../feature/path_blending.h"
+
+/**
+ * M415: Report path blending statistics
+ *
+ *  R   Reset the merge count
+ */
+void GcodeSuite::M415() {
+  SERIAL_ECHO_START();
+  SERIAL_ECHOLNPAIR("G64 P", blender.tolerance, " Merged:", blender.merged);
+  if (parser.seen_test('R')) blender.merged = 0;
+}
+
+#endif // PATH_BLENDING
@@ -65,6 +65,10 @@ GcodeSuite gcode;
   #include "../feature/password/password.h"
 #endif
 
+#if ENABLED(PATH_BLENDING)
+  #include "../feature/path_blending.h"
+#endif
+
 #include "../MarlinCore.h" // for idle, kill
 
 // Inactivity shutdown
@@ -298,6 +302,11 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
     }
   #endif
 
+  // A held move must be queued before any other command acts
+  #if ENABLED(PATH_BLENDING)
+    if (!(parser.command_letter == 'G' && parser.codenum <= 1)) blender.flush();
+  #endif
+
   // Handle a known command or reply "unknown command"
 
   switch (parser.command_letter) {
@@ -405,6 +414,10 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
         case 61: G61(); break;                                    // G61:  Apply/restore saved coordinates.
       #endif
 
+      #if ENABLED(PATH_BLENDING)
+        case 64: G64(); break;                                    // G64: Set path blending tolerance
+      #endif
+
       #if ENABLED(PROBE_TEMP_COMPENSATION)
         case 76: G76(); break;                                    // G76: Calibrate first layer compensation values
       #endif
@@ -495,6 +508,10 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
           case 34: M34(); break;                                  // M34: Set SD card sorting options
         #endif
 
+        #if HAS_SD_BLOCK_CACHE
+          case 35: M35(); break;                                  // M35: Report SD block cache statistics
+        #endif
+
         case 928: M928(); break;                                  // M928: Start SD write
       #endif // SDSUPPORT
 
@@ -750,6 +767,10 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
         case 305: M305(); break;                                  // M305: Set user thermistor parameters
       #endif
 
+      #if ENABLED(MPCTEMP)
+        case 306: M306(); break;                                  // M306: MPC autotune / set model constants
+      #endif
+
       #if ENABLED(REPETIER_GCODE_M360)
         case 360: M360(); break;                                  // M360: Firmware settings
       #endif
@@ -793,6 +814,10 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
         case 414: M414(); break;                                  // M414: Select multi language menu
       #endif
 
+      #if ENABLED(PATH_BLENDING)
+        case 415: M415(); break;                                  // M415: Report path blending statistics
+      #endif
+
       #if HAS_LEVELING
         case 420: M420(); break;                                  // M420: Enable/Disable Bed Leveling
       #endif
@@ -855,6 +880,14 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
         case 575: M575(); break;                                  // M575: Set serial baudrate
       #endif
 
+      #if ENABLED(SERIAL_CREDITS)
+        case 577: M577(); break;                                  // M577: Serial credit flow control
+      #endif
+
+      #if HAS_SHAPING
+        case 593: M593(); break;                                  // M593: Set Input Shaping parameters
+      #endif
+
       #if ENABLED(ADVANCED_PAUSE_FEATURE)
         case 600: M600(); break;                                  // M600: Pause for Filament Change
         case 603: M603(); break;                                  // M603: Configure Filament Change
@@ -1054,15 +1087,17 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
  * This is called from the main loop()
  */
 void GcodeSuite::process_next_command() {
-  GCodeQueue::CommandLine &command = queue.ring_buffer.peek_next_command();
+  TERN_(PLANNER_BENCHMARK, BENCHMARK_BUSY_SCOPE(command));
+
+  char * const command_string = queue.ring_buffer.peek_next_command_string();
 
-  PORT_REDIRECT(SERIAL_PORTMASK(command.port));
+  PORT_REDIRECT(SERIAL_PORTMASK(queue.ring_buffer.command_port()));
 
   TERN_(POWER_LOSS_RECOVERY, recovery.queue_index_r = queue.ring_buffer.index_r);
 
   if (DEBUGGING(ECHO)) {
     SERIAL_ECHO_START();
-    SERIAL_ECHOLN(command.buffer);
+    SERIAL_ECHOLN(command_string);
     #if ENABLED(M100_FREE_MEMORY_DUMPER)
       SERIAL_ECHOPAIR("slot:", queue.ring_buffer.index_r);
       M100_dump_routine(PSTR("   Command Queue:"), (const char*)&queue.ring_buffer, sizeof(queue.ring_buffer));
@@ -1070,7 +1105,23 @@ void GcodeSuite::process_next_command() {
   }
 
   // Parse the next command in the queue
-  parser.parse(command.buffer);
+  #if ENABLED(PARSE_AT_ENQUEUE)
+    GCodeQueue::CommandLine &command = queue.ring_buffer.peek_next_command();
+    if (command.parsed.command_letter) {  // Parsed when it was queued
+      #if ENABLED(G0_G1_FAST_PATH)
+        // Plain G0 / G1 moves go straight to the planner
+        if (command.parsed.command_letter == 'G' && command.parsed.codenum <= 1 && G0_G1_fast(command.parsed)) {
+          queue.ok_to_send();
+          SERIAL_OUT(msgDone);
+          return;
+        }
+      #endif
+      parser.load_preparsed(command_string, command.parsed);
+      TERN_(SDSUPPORT, if (parser.is_command('M', 28)) queue.ring_buffer.hold_parsing = false);
+    }
+    else
+  #endif
+      parser.parse(command_string);
   process_parsed_command();
 }
 
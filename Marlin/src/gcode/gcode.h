@@ -70,6 +70,7 @@
  * G42  - Coordinated move to a mesh point (Requires MESH_BED_LEVELING, AUTO_BED_LEVELING_BLINEAR, or AUTO_BED_LEVELING_UBL)
  * G60  - Save current position. (Requires SAVED_POSITIONS)
  * G61  - Apply/restore saved coordinates. (Requires SAVED_POSITIONS)
+ * G64  - Set path blending tolerance: "G64 P<mm>". G64 P0 to disable. (Requires PATH_BLENDING)
  * G76  - Calibrate first layer temperature offsets. (Requires PROBE_TEMP_COMPENSATION)
  * G80  - Cancel current motion mode (Requires GCODE_MOTION_MODES)
  * G90  - Use Absolute Coordinates
@@ -111,6 +112,7 @@
  *        The '#' is necessary when calling from within sd files, as it stops buffer prereading
  * M33  - Get the longname version of a path. (Requires LONG_FILENAME_HOST_SUPPORT)
  * M34  - Set SD Card sorting options. (Requires SDCARD_SORT_ALPHA)
+ * M35  - Report SD block cache hits and misses. Use R to reset the counters. (Requires SD_CACHE_BLOCKS)
  * M42  - Change pin status via gcode: M42 P<pin> S<value>. LED pin assumed if P is omitted. (Requires DIRECT_PIN_CONTROL)
  * M43  - Display pin status, watch pins for changes, watch endstops & toggle LED, Z servo probe test, toggle pins
  * M48  - Measure Z Probe repeatability: M48 P<points> X<pos> Y<pos> V<level> E<engage> L<legs> S<chizoid>. (Requires Z_MIN_PROBE_REPEATABILITY_TEST)
@@ -203,6 +205,7 @@
  * M303 - PID relay autotune S<temperature> sets the target temperature. Default 150C. (Requires PIDTEMP)
  * M304 - Set bed PID parameters P I and D. (Requires PIDTEMPBED)
  * M305 - Set user thermistor parameters R T and P. (Requires TEMP_SENSOR_x 1000)
+ * M306 - MPC autotune (T) or set model constants E P C R A F H. (Requires MPCTEMP)
  * M309 - Set chamber PID parameters P I and D. (Requires PIDTEMPCHAMBER)
  * M350 - Set microstepping mode. (Requires digital microstepping pins.)
  * M351 - Toggle MS1 MS2 pins directly. (Requires digital microstepping pins.)
@@ -221,6 +224,7 @@
  * M412 - Enable / Disable Filament Runout Detection. (Requires FILAMENT_RUNOUT_SENSOR)
  * M413 - Enable / Disable Power-Loss Recovery. (Requires POWER_LOSS_RECOVERY)
  * M414 - Set language by index. (Requires LCD_LANGUAGE_2...)
+ * M415 - Report path blending statistics. "M415 R" to reset the merge count. (Requires PATH_BLENDING)
  * M420 - Enable/Disable Leveling (with current values) S1=enable S0=disable (Requires MESH_BED_LEVELING or ABL)
  * M421 - Set a single Z coordinate in the Mesh Leveling grid. X<units> Y<units> Z<units> (Requires MESH_BED_LEVELING, AUTO_BED_LEVELING_BILINEAR, or AUTO_BED_LEVELING_UBL)
  * M422 - Set Z Stepper automatic alignment position using probe. X<units> Y<units> A<axis> (Requires Z_STEPPER_AUTO_ALIGN)
@@ -243,6 +247,8 @@
  * M554 - Get or set IP gateway. (Requires enabled Ethernet port)
  * M569 - Enable stealthChop on an axis. (Requires at least one _DRIVER_TYPE to be TMC2130/2160/2208/2209/5130/5160)
  * M575 - Change the serial baud rate. (Requires BAUD_RATE_GCODE)
+ * M577 - Get or set serial credit flow control: "M577 S<bool>". (Requires SERIAL_CREDITS)
+ * M593 - Get or Set Input Shaping parameters: "M593 X<bool> Y<bool> F<hz> D<zeta> T<type>". (Requires INPUT_SHAPING_X or INPUT_SHAPING_Y)
  * M600 - Pause for filament change: "M600 X<pos> Y<pos> Z<raise> E<first_retract> L<later_retract>". (Requires ADVANCED_PAUSE_FEATURE)
  * M603 - Configure filament change: "M603 T<tool> U<unload_length> L<load_length>". (Requires ADVANCED_PAUSE_FEATURE)
  * M605 - Set Dual X-Carriage movement mode: "M605 S<mode> [X<x_offset>] [R<temp_offset>]". (Requires DUAL_X_CARRIAGE)
@@ -443,6 +449,9 @@ private:
   #endif
 
   static void G0_G1(TERN_(HAS_FAST_MOVES, const bool fast_move=false));
+  #if ENABLED(G0_G1_FAST_PATH)
+    static bool G0_G1_fast(const parsed_command_t &cmd);
+  #endif
 
   #if ENABLED(ARC_SUPPORT)
     static void G2_G3(const bool clockwise);
@@ -551,6 +560,10 @@ private:
     static void G61();
   #endif
 
+  #if ENABLED(PATH_BLENDING)
+    static void G64();
+  #endif
+
   #if ENABLED(GCODE_MOTION_MODES)
     static void G80();
   #endif
@@ -625,6 +638,9 @@ private:
     #if BOTH(SDCARD_SORT_ALPHA, SDSORT_GCODE)
       static void M34();
     #endif
+    #if HAS_SD_BLOCK_CACHE
+      static void M35();
+    #endif
   #endif
 
   #if ENABLED(DIRECT_PIN_CONTROL)
@@ -865,6 +881,10 @@ private:
     static void M305();
   #endif
 
+  #if ENABLED(MPCTEMP)
+    static void M306();
+  #endif
+
   #if ENABLED(PIDTEMPCHAMBER)
     static void M309();
   #endif
@@ -921,6 +941,10 @@ private:
     static void M414();
   #endif
 
+  #if ENABLED(PATH_BLENDING)
+    static void M415();
+  #endif
+
   #if HAS_LEVELING
     static void M420();
     static void M421();
@@ -980,6 +1004,14 @@ private:
     static void M575();
   #endif
 
+  #if ENABLED(SERIAL_CREDITS)
+    static void M577();
+  #endif
+
+  #if HAS_SHAPING
+    static void M593();
+  #endif
+
   #if ENABLED(ADVANCED_PAUSE_FEATURE)
     static void M600();
     static void M603();
@@ -76,9 +76,18 @@ void GcodeSuite::M115() {
     // SERIAL_XON_XOFF
     cap_line(PSTR("SERIAL_XON_XOFF"), ENABLED(SERIAL_XON_XOFF));
 
+    // SERIAL_CREDITS (M577)
+    cap_line(PSTR("SERIAL_CREDITS"), ENABLED(SERIAL_CREDITS));
+
     // BINARY_FILE_TRANSFER (M28 B1)
     cap_line(PSTR("BINARY_FILE_TRANSFER"), ENABLED(BINARY_FILE_TRANSFER)); // TODO: Use SERIAL_IMPL.has_feature(port, SerialFeature::BinaryFileTransfer) once implemented
 
+    // BINARY_STREAM_PRINT (M28 B1 transfers printed as they arrive)
+    cap_line(PSTR("BINARY_STREAM_PRINT"), ENABLED(BINARY_STREAM_PRINT));
+
+    // BINARY_GCODE (pre-tokenized commands)
+    cap_line(PSTR("BINARY_GCODE"), ENABLED(BINARY_GCODE));
+
     // EEPROM (M500, M501)
     cap_line(PSTR("EEPROM"), ENABLED(EEPROM_SETTINGS));
 
@@ -164,6 +173,12 @@ void GcodeSuite::M115() {
     // MEATPACK Compression
     cap_line(PSTR("MEATPACK"), SERIAL_IMPL.has_feature(port, SerialFeature::MeatPack));
 
+    // MEATPACK_V2 (symbol and token tables set by the host)
+    cap_line(PSTR("MEATPACK_V2"), TERN0(MEATPACK_V2, SERIAL_IMPL.has_feature(port, SerialFeature::MeatPack)));
+
+    // MEATPACK_SD_FILES (print packed *.MP files)
+    cap_line(PSTR("MEATPACK_SD_FILES"), ENABLED(MEATPACK_SD_FILES));
+
     // Machine Geometry
     #if ENABLED(M115_GEOMETRY_REPORT)
       const xyz_pos_t dmin = { X_MIN_POS, Y_MIN_POS, Z_MIN_POS },
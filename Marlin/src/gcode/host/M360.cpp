@@ -61,7 +61,7 @@ void GcodeSuite::M360() {
   //
   config_line(PSTR("Baudrate"),                   BAUDRATE);
   config_line(PSTR("InputBuffer"),                MAX_CMD_SIZE);
-  config_line(PSTR("PrintlineCache"),             BUFSIZE);
+  config_line(PSTR("PrintlineCache"),             MAX_QUEUED_COMMANDS);
   config_line(PSTR("MixingExtruder"),             ENABLED(MIXING_EXTRUDER));
   config_line(PSTR("SDCard"),                     ENABLED(SDSUPPORT));
   config_line(PSTR("Fan"),                        ENABLED(HAS_FAN));
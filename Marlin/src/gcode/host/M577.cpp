@@ -0,0 +1,53 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(SERIAL_CREDITS)
+
+#include "../gcode.h"
+#include "../queue.h"
+
+/**
+ * M577: Get or set serial credit flow control for the port that sent the command
+ *
+ *   S<bool> Optional. 1 to use credits instead of "ok", 0 to go back to "ok".
+ *
+ * With credits on, the port gets "credit L<lines> B<bytes>" reports instead of an
+ * "ok" per command. The host may send newline-terminated lines while it has sent
+ * fewer than L lines and at most B bytes, both counted from the end of the M577 line.
+ * Counts are cumulative and wrap at 2^32, so only the latest report matters.
+ *
+ * After "M577 S1" the host waits for the first report before sending again.
+ * While credits are on an "ok" (e.g., from M105) has no flow control meaning.
+ * A binary file transfer doesn't count bytes, so send "M577 S1" again after one.
+ */
+void GcodeSuite::M577() {
+
+  if (parser.seen('S'))
+    queue.set_credits(parser.value_bool());
+  else
+    SERIAL_ECHO_MSG("M577 S", queue.credits_enabled());
+
+}
+
+#endif // SERIAL_CREDITS
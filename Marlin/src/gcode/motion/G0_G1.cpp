@@ -35,6 +35,26 @@
   #include "../../module/stepper.h"
 #endif
 
+#if ENABLED(G0_G1_FAST_PATH)
+  #include "../../module/planner.h"
+  #include "../../module/temperature.h"
+  #if ENABLED(PRINTCOUNTER)
+    #include "../../module/printcounter.h"
+  #endif
+  #if ENABLED(POWER_LOSS_RECOVERY)
+    #include "../../feature/powerloss.h"
+  #endif
+  #if ENABLED(CANCEL_OBJECTS)
+    #include "../../feature/cancel_object.h"
+  #endif
+  #if ENABLED(PASSWORD_FEATURE)
+    #include "../../feature/password/password.h"
+  #endif
+  #if ENABLED(FLOWMETER_SAFETY)
+    #include "../../feature/cooler.h"
+  #endif
+#endif
+
 extern xyze_pos_t destination;
 
 #if ENABLED(VARIABLE_G0_FEEDRATE)
@@ -130,3 +150,92 @@ void GcodeSuite::G0_G1(TERN_(HAS_FAST_MOVES, const bool fast_move/*=false*/)) {
     #endif
   }
 }
+
+#if ENABLED(G0_G1_FAST_PATH)
+
+  /**
+   * G0, G1 for a command parsed when it was queued, taking the values
+   * converted then straight to the planner. This skips the command switch,
+   * the parser lookups, and the layers for features the move doesn't use.
+   *
+   * Return false, having changed nothing, for a move that needs G0_G1():
+   * other parameters, inch units, active mesh leveling, a cold or lengthy
+   * extrusion, and so on.
+   */
+  bool GcodeSuite::G0_G1_fast(const parsed_command_t &cmd) {
+    if (cmd.subcode
+      || TERN0(HAS_FAST_MOVES, cmd.codenum == 0)                  // G0 has its own feedrate
+      || !IsRunning()
+      || DEBUGGING(DRYRUN)
+      || TERN0(NO_MOTION_BEFORE_HOMING, axes_should_home())
+      || TERN0(INCH_MODE_SUPPORT, parser.using_inch_units())
+      || TERN0(HAS_MESH, planner.leveling_active)                 // Mesh moves are segmented
+      || TERN0(CANCEL_OBJECTS, cancelable.skipping)
+      || TERN0(FWRETRACT_AUTORETRACT, fwretract.autoretract_enabled)
+      || TERN0(PASSWORD_FEATURE, password.is_locked)
+      || TERN0(FLOWMETER_SAFETY, cooler.flowfault)
+    ) return false;
+
+    xyze_pos_t target = current_position;
+    feedRate_t fr_mm_s = feedrate_mm_s;
+    #if ENABLED(POWER_LOSS_RECOVERY)
+      bool seen_xy = false, seen_e = false;
+    #endif
+
+    #define _FAST_AXIS(a,A) target.a = axis_is_relative(A##_AXIS) ? current_position.a + v : LOGICAL_TO_NATIVE(v, A##_AXIS)
+
+    LOOP_L_N(i, cmd.count) {
+      if (!cmd.param[i]) return false;                            // No value
+      const float v = cmd.value[i];
+      switch (cmd.letter[i]) {
+        case 'X' - 'A': _FAST_AXIS(x, X); TERN_(POWER_LOSS_RECOVERY, seen_xy = true); break;
+        #if HAS_Y_AXIS
+          case 'Y' - 'A': _FAST_AXIS(y, Y); TERN_(POWER_LOSS_RECOVERY, seen_xy = true); break;
+        #endif
+        #if HAS_Z_AXIS
+          case 'Z' - 'A': _FAST_AXIS(z, Z); break;
+        #endif
+        #if HAS_EXTRUDERS
+          case 'E' - 'A':
+            target.e = axis_is_relative(E_AXIS) ? current_position.e + v : v;
+            TERN_(POWER_LOSS_RECOVERY, seen_e = true);
+            break;
+        #endif
+        case 'F' - 'A': if (v > 0) fr_mm_s = MMM_TO_MMS(v); break;
+        default: return false;                                    // Let G0_G1 deal with it
+      }
+    }
+
+    #undef _FAST_AXIS
+
+    #if HAS_EXTRUDERS && EITHER(PREVENT_COLD_EXTRUSION, PREVENT_LENGTHY_EXTRUDE)
+      // G0_G1 reports the error and drops the E move
+      if (target.e != current_position.e && (
+           TERN0(PREVENT_COLD_EXTRUSION, thermalManager.tooColdToExtrude(active_extruder))
+        || TERN0(PREVENT_LENGTHY_EXTRUDE, ABS(target.e - current_position.e) * planner.e_factor[active_extruder] > (EXTRUDE_MAXLENGTH))
+      )) return false;
+    #endif
+
+    KEEPALIVE_STATE(IN_HANDLER);
+    TERN_(FULL_REPORT_TO_HOST_FEATURE, set_and_report_grblstate(M_RUNNING));
+
+    destination = target;
+
+    #if ENABLED(POWER_LOSS_RECOVERY) && !PIN_EXISTS(POWER_LOSS)
+      if (recovery.enabled && IS_SD_PRINTING() && seen_e && seen_xy)
+        recovery.save();
+    #endif
+
+    feedrate_mm_s = fr_mm_s;
+
+    TERN_(PRINTCOUNTER, print_job_timer.incFilamentUsed(destination.e - current_position.e));
+
+    apply_motion_limits(destination);
+    planner.buffer_line(destination, MMS_SCALED(feedrate_mm_s));
+    current_position = destination;
+
+    TERN_(FULL_REPORT_TO_HOST_FEATURE, report_current_grblstate_moving());
+    return true;
+  }
+
+#endif // G0_G1_FAST_PATH
@@ -40,6 +40,24 @@
   #define N_ARC_CORRECTION 1
 #endif
 
+#if ENABLED(ARC_BLOCKS)
+
+  // Can the arc go to the planner as-is? Only its end point gets leveled and clipped.
+  static bool can_buffer_arc(const AxisEnum p_axis, const AxisEnum q_axis, const float center_P, const float center_Q, const float radius) {
+    if (radius < 0.01f || TERN0(HAS_LEVELING, planner.leveling_active)) return false;
+    #if HAS_SOFTWARE_ENDSTOPS
+      if (soft_endstop.enabled() && !(
+           WITHIN(center_P - radius, soft_endstop.min[p_axis], soft_endstop.max[p_axis])
+        && WITHIN(center_P + radius, soft_endstop.min[p_axis], soft_endstop.max[p_axis])
+        && WITHIN(center_Q - radius, soft_endstop.min[q_axis], soft_endstop.max[q_axis])
+        && WITHIN(center_Q + radius, soft_endstop.min[q_axis], soft_endstop.max[q_axis])
+      )) return false;
+    #endif
+    return true;
+  }
+
+#endif
+
 /**
  * Plan an arc in 2 dimensions, with optional linear motion in a 3rd dimension
  *
@@ -47,6 +65,8 @@
  * MM_PER_ARC_SEGMENT (Default 1mm). In the future we hope more slicers will include
  * an option to generate G2/G3 arcs for curved surfaces, as this will allow faster
  * boards to produce much smoother curved surfaces.
+ *
+ * With ARC_BLOCKS the whole arc is a single planner block, traced by the stepper.
  */
 void plan_arc(
   const xyze_pos_t &cart,   // Destination position
@@ -147,6 +167,18 @@ void plan_arc(
 
   const feedRate_t scaled_fr_mm_s = MMS_SCALED(feedrate_mm_s);
 
+  #if ENABLED(ARC_BLOCKS)
+    // Let the stepper trace the whole arc as a single planner block, unless bed
+    // leveling would bend it, or software endstops might need to clip it.
+    if (can_buffer_arc(p_axis, q_axis, center_P, center_Q, radius)) {
+      xyze_pos_t raw = cart;
+      apply_motion_limits(raw);
+      planner.buffer_arc(raw, p_axis, q_axis, rvec, angular_travel, scaled_fr_mm_s, active_extruder, mm_of_travel);
+      current_position = raw;
+      return;
+    }
+  #endif
+
   // Start with a nominal segment length
   float seg_length = (
     #ifdef ARC_SEGMENTS_PER_R
@@ -66,6 +66,10 @@ uint16_t GCodeParser::codenum;
   char *GCodeParser::command_args; // start of parameters
 #endif
 
+#if ENABLED(PARSE_AT_ENQUEUE)
+  const parsed_command_t *GCodeParser::parsed; // = nullptr
+#endif
+
 // Create a global instance of the GCode parser singleton
 GCodeParser parser;
 
@@ -84,6 +88,7 @@ void GCodeParser::reset() {
     codebits = 0;                       // No codes yet
     //ZERO(param);                      // No parameters (should be safe to comment out this line)
   #endif
+  TERN_(PARSE_AT_ENQUEUE, parsed = nullptr); // Values come from the line
 }
 
 #if ENABLED(GCODE_QUOTED_STRINGS)
@@ -267,13 +272,9 @@ void GCodeParser::parse(char *p) {
   IF_DISABLED(FASTER_GCODE_PARSER, command_args = p); // Scan for parameters in seen()
 
   // Only use string_arg for these M codes
-  if (letter == 'M') switch (codenum) {
-    TERN_(GCODE_MACROS, case 810 ... 819:)
-    TERN_(EXPECTED_PRINTER_CHECK, case 16:)
-    case 23: case 28: case 30: case 117 ... 118: case 928:
-      string_arg = unescape_string(p);
-      return;
-    default: break;
+  if (letter == 'M' && is_string_mcode(codenum)) {
+    string_arg = unescape_string(p);
+    return;
   }
 
   #if ENABLED(DEBUG_GCODE_PARSER)
@@ -363,6 +364,92 @@ void GCodeParser::parse(char *p) {
   }
 }
 
+// Exact powers of ten for the float scanner
+static const float pow10_P[] PROGMEM = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+
+/**
+ * Convert a G-code decimal number like "-12.345" to float.
+ *
+ * The digits are gathered into an integer and divided by a power of ten.
+ * Up to 2^24 both are exact floats, so the single division rounds just as
+ * strtof does. Longer numbers (rare in G-code) fall back to strtof, with the
+ * 'E' hidden to prevent scientific notation.
+ */
+float GCodeParser::scan_float(char * const p) {
+  const char *s = p;
+  const bool neg = (*s == '-');
+  if (neg || *s == '+') s++;
+
+  uint32_t mant = 0;
+  uint8_t frac = 0, zeros = 0;
+  for (; NUMERIC(*s); s++) {
+    mant = mant * 10 + (*s - '0');
+    if (mant > _BV32(24)) goto SLOW;
+  }
+  if (*s == '.') {
+    for (s++; NUMERIC(*s); s++) {
+      if (*s == '0') { zeros++; continue; }   // Trailing zeros don't count
+      for (zeros++; zeros; zeros--) {         // Apply held zeros and this digit
+        mant *= 10;
+        if (mant > _BV32(24) || ++frac >= COUNT(pow10_P)) goto SLOW;
+      }
+      mant += *s - '0';
+      if (mant > _BV32(24)) goto SLOW;
+    }
+  }
+  if (*s == 'x' || *s == 'X') goto SLOW;      // Hexadecimal
+
+  {
+    const float f = float_from_decimal(mant, frac);
+    return neg ? -f : f;
+  }
+
+  SLOW:
+  for (char *e = p; ; ++e) {
+    const char c = *e;
+    if (c == '\0' || c == ' ') break;
+    if (c == 'E' || c == 'e') {
+      *e = '\0';
+      const float ret = strtof(p, nullptr);
+      *e = c;
+      return ret;
+    }
+  }
+  return strtof(p, nullptr);
+}
+
+float GCodeParser::float_from_decimal(const uint32_t mant, const uint8_t frac) {
+  return frac ? float(mant) / pgm_read_float(&pow10_P[frac]) : float(mant);
+}
+
+/**
+ * Convert a G-code integer, falling back to strtol / strtoul for values
+ * with more than 9 digits, which might overflow.
+ */
+int32_t GCodeParser::scan_long(const char * const p) {
+  const char *s = p;
+  const bool neg = (*s == '-');
+  if (neg || *s == '+') s++;
+  int32_t v = 0;
+  for (uint8_t n = 0; NUMERIC(*s); s++) {
+    if (++n > 9) return strtol(p, nullptr, 10);
+    v = v * 10 + (*s - '0');
+  }
+  return neg ? -v : v;
+}
+
+uint32_t GCodeParser::scan_ulong(const char * const p) {
+  if (*p == '-') return strtoul(p, nullptr, 10);  // strtoul wraps "-N" around
+  const char *s = p;
+  if (*s == '+') s++;
+  uint32_t v = 0;
+  for (uint8_t n = 0; NUMERIC(*s); s++) {
+    if (++n > 9) return strtoul(p, nullptr, 10);
+    v = v * 10 + (*s - '0');
+  }
+  return v;
+}
+
 #if ENABLED(CNC_COORDINATE_SYSTEMS)
 
   // Parse the next parameter as a new command
@@ -383,6 +470,72 @@ void GCodeParser::parse(char *p) {
 
 #endif // CNC_COORDINATE_SYSTEMS
 
+#if ENABLED(PARSE_AT_ENQUEUE)
+
+  /**
+   * Parse a line into a compact record as it goes into the command queue.
+   * This may happen in idle() while another command runs, so the current
+   * command state is saved and restored around the parse.
+   */
+  void GCodeParser::preparse(char * const line, parsed_command_t &out) {
+    char * const old_command_ptr = command_ptr,
+         * const old_string_arg = string_arg,
+         * const old_value_ptr = value_ptr;
+    const char old_command_letter = command_letter;
+    const uint16_t old_codenum = codenum;
+    #if USE_GCODE_SUBCODES
+      const uint8_t old_subcode = subcode;
+    #endif
+    const uint32_t old_codebits = codebits;
+    uint8_t old_param[COUNT(param)];
+    COPY(old_param, param);
+    const parsed_command_t * const old_parsed = parsed;
+
+    parse(line);
+
+    out.codebits = codebits;
+    out.codenum = codenum;
+    out.command_letter = command_letter;
+    out.subcode = TERN0(USE_GCODE_SUBCODES, subcode);
+    out.command_offset = command_ptr - line;
+    out.string_offset = string_arg ? string_arg - line + 1 : 0;
+    out.count = 0;
+    LOOP_L_N(ind, COUNT(param)) {
+      if (!TEST32(codebits, ind)) continue;
+      if (out.count >= PARSED_PARAMS) {   // Too many to keep. Parse again when it runs.
+        out.command_letter = '\0';
+        break;
+      }
+      out.letter[out.count] = ind;
+      out.param[out.count] = param[ind];
+      out.value[out.count] = seenval('A' + ind) ? value_float() : 0;
+      out.count++;
+    }
+
+    command_ptr = old_command_ptr;
+    string_arg = old_string_arg;
+    value_ptr = old_value_ptr;
+    command_letter = old_command_letter;
+    codenum = old_codenum;
+    TERN_(USE_GCODE_SUBCODES, subcode = old_subcode);
+    codebits = old_codebits;
+    COPY(param, old_param);
+    parsed = old_parsed;
+  }
+
+  void GCodeParser::load_preparsed(char * const line, const parsed_command_t &in) {
+    command_ptr = line + in.command_offset;
+    string_arg = in.string_offset ? line + in.string_offset - 1 : nullptr;
+    command_letter = in.command_letter;
+    codenum = in.codenum;
+    TERN_(USE_GCODE_SUBCODES, subcode = in.subcode);
+    codebits = in.codebits;
+    LOOP_L_N(i, in.count) param[in.letter[i]] = in.param[i];
+    parsed = &in;
+  }
+
+#endif // PARSE_AT_ENQUEUE
+
 void GCodeParser::unknown_command_warning() {
   SERIAL_ECHO_MSG(STR_UNKNOWN_COMMAND, command_ptr, "\"");
 }
@@ -42,6 +42,28 @@
   typedef enum : uint8_t { LINEARUNIT_MM, LINEARUNIT_INCH } LinearUnit;
 #endif
 
+#if ENABLED(PARSE_AT_ENQUEUE)
+
+  #define PARSED_PARAMS 6 // Commands with more parameters are parsed again when they run
+
+  /**
+   * A command line that was parsed when it was queued
+   */
+  typedef struct {
+    uint32_t codebits;              // Parameters seen
+    uint16_t codenum;               // 123
+    char command_letter;            // G, M, or T. nul for a line that still needs parsing.
+    uint8_t subcode,                // .1
+            command_offset,         // Offset of the command in the line, after any line number
+            string_offset,          // Offset of string_arg in the line + 1, or 0 for none
+            count;                  // Number of parameters
+    uint8_t letter[PARSED_PARAMS],  // Parameter letter (0-25)
+            param[PARSED_PARAMS];   // Parameter offset from the command, or 0 for no value
+    float value[PARSED_PARAMS];     // Parameter value, already converted
+  } parsed_command_t;
+
+#endif
+
 /**
  * GCode parser
  *
@@ -66,6 +88,10 @@ private:
     static char *command_args;      // Args start here, for slow scan
   #endif
 
+  #if ENABLED(PARSE_AT_ENQUEUE)
+    static const parsed_command_t *parsed; // Values of a command parsed when it was queued
+  #endif
+
 public:
 
   // Global states for GCode-level units features
@@ -244,9 +270,28 @@ public:
     static bool chain();
   #endif
 
+  #if ENABLED(PARSE_AT_ENQUEUE)
+    // Parse a line as it's queued, leaving the state of the running command alone
+    static void preparse(char * const line, parsed_command_t &out);
+
+    // Restore the state of a line parsed by preparse()
+    static void load_preparsed(char * const line, const parsed_command_t &in);
+  #endif
+
   // Test whether the parsed command matches the input
   static inline bool is_command(const char ltr, const uint16_t num) { return command_letter == ltr && codenum == num; }
 
+  // M-codes that take the rest of the line as string_arg
+  static inline bool is_string_mcode(const uint16_t num) {
+    switch (num) {
+      TERN_(GCODE_MACROS, case 810 ... 819:)
+      TERN_(EXPECTED_PRINTER_CHECK, case 16:)
+      case 23: case 28: case 30: case 117 ... 118: case 928:
+        return true;
+      default: return false;
+    }
+  }
+
   // The code value pointer was set
   FORCE_INLINE static bool has_value() { return !!value_ptr; }
 
@@ -256,29 +301,32 @@ public:
   // The value as a string
   static inline char* value_string() { return value_ptr; }
 
-  // Float removes 'E' to prevent scientific notation interpretation
+  // Decimal number scanners giving the same results as strtof / strtol / strtoul
+  // for G-code values. 'E' ends a float, so there's no scientific notation.
+  static float scan_float(char * const p);
+  static int32_t scan_long(const char * const p);
+  static uint32_t scan_ulong(const char * const p);
+
+  // mant / 10^frac, rounded as strtof would, for mant <= 2^24 and frac <= 10
+  static float float_from_decimal(const uint32_t mant, const uint8_t frac);
+
+  // Float value of the current parameter
   static inline float value_float() {
     if (value_ptr) {
-      char *e = value_ptr;
-      for (;;) {
-        const char c = *e;
-        if (c == '\0' || c == ' ') break;
-        if (c == 'E' || c == 'e') {
-          *e = '\0';
-          const float ret = strtof(value_ptr, nullptr);
-          *e = c;
-          return ret;
+      #if ENABLED(PARSE_AT_ENQUEUE)
+        if (parsed) {                   // Use the value converted when the command was queued
+          const uint8_t off = value_ptr - command_ptr;
+          LOOP_L_N(i, parsed->count) if (parsed->param[i] == off) return parsed->value[i];
         }
-        ++e;
-      }
-      return strtof(value_ptr, nullptr);
+      #endif
+      return scan_float(value_ptr);
     }
     return 0;
   }
 
   // Code value as a long or ulong
-  static inline int32_t value_long() { return value_ptr ? strtol(value_ptr, nullptr, 10) : 0L; }
-  static inline uint32_t value_ulong() { return value_ptr ? strtoul(value_ptr, nullptr, 10) : 0UL; }
+  static inline int32_t value_long() { return value_ptr ? scan_long(value_ptr) : 0L; }
+  static inline uint32_t value_ulong() { return value_ptr ? scan_ulong(value_ptr) : 0UL; }
 
   // Code value for use as time
   static inline millis_t value_millis() { return value_ulong(); }
@@ -57,6 +57,10 @@ GCodeQueue queue;
   #include "../feature/repeat.h"
 #endif
 
+#if ENABLED(BINARY_GCODE)
+  #include "../feature/binary_gcode.h"
+#endif
+
 // Frequently used G-code strings
 PGMSTR(G28_STR, "G28");
 
@@ -99,12 +103,46 @@ PGM_P GCodeQueue::injected_commands_P; // = nullptr
  */
 char GCodeQueue::injected_commands[64]; // = { 0 }
 
-void GCodeQueue::RingBuffer::commit_command(bool skip_ok
+/**
+ * Find room for a command of 'size' bytes. Commands never wrap around the end
+ * of the arena, so a command that doesn't fit after the newest one goes to the front.
+ */
+char* GCodeQueue::RingBuffer::reserve(const uint16_t size) {
+  if (length >= MAX_QUEUED_COMMANDS) return nullptr;
+  if (!length) return arena;                        // Start over at the front of an empty arena
+
+  const uint16_t arena_r = commands[index_r].offset;
+  if (arena_w > arena_r) {                          // Free space after the newest and before the oldest
+    if (sizeof(arena) - arena_w >= size) return &arena[arena_w];
+    return arena_r >= size ? arena : nullptr;       // Wrap, leaving the tail end unused
+  }
+  return arena_r - arena_w >= size ? &arena[arena_w] : nullptr;
+}
+
+/**
+ * Add a command placed by reserve() to the queue.
+ * 'len' is the length of the command string, not counting the terminator.
+ */
+void GCodeQueue::RingBuffer::commit_command(const char *cmd, const uint16_t len, bool skip_ok
   OPTARG(HAS_MULTI_SERIAL, serial_index_t serial_ind/*=-1*/)
+  OPTARG(PARSE_AT_ENQUEUE, const bool preparsed/*=false*/)
 ) {
-  commands[index_w].skip_ok = skip_ok;
-  TERN_(HAS_MULTI_SERIAL, commands[index_w].port = serial_ind);
+  CommandLine &command = commands[index_w];
+  command.offset = cmd - arena;
+  command.skip_ok = skip_ok;
+  TERN_(HAS_MULTI_SERIAL, command.port = serial_ind);
+  #if ENABLED(PARSE_AT_ENQUEUE)
+    // Parse now, while the planner is busy. Lines going into a file must stay as they are.
+    // A 'preparsed' command already has its record filled in by the caller.
+    if (TERN0(SDSUPPORT, card.flag.saving || hold_parsing))
+      command.parsed.command_letter = '\0';
+    else if (!preparsed) {
+      parser.preparse(&arena[command.offset], command.parsed);
+      TERN_(SDSUPPORT, hold_parsing = command.parsed.command_letter == 'M' && command.parsed.codenum == 28);
+    }
+  #endif
   TERN_(POWER_LOSS_RECOVERY, recovery.commit_sdpos(index_w));
+  arena_w = command.offset + len + 1;
   advance_pos(index_w, 1);
 }
 
@@ -116,9 +154,13 @@ void GCodeQueue::RingBuffer::commit_command(bool skip_ok
 bool GCodeQueue::RingBuffer::enqueue(const char *cmd, bool skip_ok/*=true*/
   OPTARG(HAS_MULTI_SERIAL, serial_index_t serial_ind/*=-1*/)
 ) {
-  if (*cmd == ';' || length >= BUFSIZE) return false;
-  strcpy(commands[index_w].buffer, cmd);
-  commit_command(skip_ok
+  if (*cmd == ';') return false;
+  const uint16_t len = _MIN(strlen(cmd), size_t(MAX_CMD_SIZE - 1));
+  char * const buff = reserve(len + 1);
+  if (!buff) return false;
+  memcpy(buff, cmd, len);
+  buff[len] = '\0';
+  commit_command(buff, len, skip_ok
     #if HAS_MULTI_SERIAL
       , serial_ind
     #endif
@@ -126,6 +168,30 @@ bool GCodeQueue::RingBuffer::enqueue(const char *cmd, bool skip_ok/*=true*/
   return true;
 }
 
+#if ENABLED(BINARY_GCODE)
+
+  /**
+   * Decode a binary G-code record into the main command buffer.
+   * Return false if the buffer is full. A bad record is dropped with an error.
+   */
+  bool GCodeQueue::RingBuffer::enqueue_binary(const uint8_t * const rec, bool skip_ok/*=true*/
+    OPTARG(HAS_MULTI_SERIAL, serial_index_t serial_ind/*=-1*/)
+  ) {
+    char * const buff = reserve(MAX_CMD_SIZE);
+    if (!buff) return false;
+    const int16_t len = BinaryGCode::decode(rec, buff, MAX_CMD_SIZE OPTARG(PARSE_AT_ENQUEUE, next_parsed()));
+    if (len < 0)
+      SERIAL_ERROR_MSG(STR_ERR_BINARY_GCODE);
+    else if (len)
+      commit_command(buff, len, skip_ok
+        OPTARG(HAS_MULTI_SERIAL, serial_ind)
+        OPTARG(PARSE_AT_ENQUEUE, next_parsed().command_letter != '\0')
+      );
+    return true;
+  }
+
+#endif
+
 /**
  * Enqueue with Serial Echo
  * Return true if the command was consumed
@@ -249,23 +315,26 @@ void GCodeQueue::RingBuffer::ok_to_send() {
     // Start counting from the last command's execution
     last_command_time = millis();
   #endif
-  CommandLine &command = commands[index_r];
+  const CommandLine &command = commands[index_r];
   #if HAS_MULTI_SERIAL
     const serial_index_t serial_ind = command.port;
     if (!serial_ind.valid()) return;              // Optimization here, skip processing if it's not going anywhere
     PORT_REDIRECT(SERIAL_PORTMASK(serial_ind));   // Reply to the serial port that sent the command
   #endif
   if (command.skip_ok) return;
+  #if ENABLED(SERIAL_CREDITS)
+    if (serial_state[command_port().index].credits) return; // Credit reports take the place of "ok"
+  #endif
   SERIAL_ECHOPGM(STR_OK);
   #if ENABLED(ADVANCED_OK)
-    char* p = command.buffer;
+    const char *p = &arena[command.offset];
     if (*p == 'N') {
       SERIAL_CHAR(' ', *p++);
       while (NUMERIC_SIGNED(*p))
         SERIAL_CHAR(*p++);
     }
     SERIAL_ECHOPAIR_P(SP_P_STR, planner.moves_free(),
-                      SP_B_STR, BUFSIZE - length);
+                      SP_B_STR, free_commands());
   #endif
   SERIAL_EOL();
 }
@@ -281,6 +350,9 @@ void GCodeQueue::flush_and_request_resend(const serial_index_t serial_ind) {
   #endif
   SERIAL_FLUSH();
   SERIAL_ECHOLNPAIR(STR_RESEND, serial_state[serial_ind.index].last_N + 1);
+  #if ENABLED(SERIAL_CREDITS)
+    if (serial_state[serial_ind.index].credits) return report_credits(serial_ind, true);
+  #endif
   SERIAL_ECHOLNPGM(STR_OK);
 }
 
@@ -305,7 +377,68 @@ static bool serial_data_available(serial_index_t index) {
   }
 #endif
 
-inline int read_serial(const serial_index_t index) { return SERIAL_IMPL.read(index); }
+#if ENABLED(SERIAL_CREDITS)
+
+  // Count every byte and line taken from a port, so credits can be granted against them
+  inline int read_serial(const serial_index_t index) {
+    const int c = SERIAL_IMPL.read(index);
+    if (c >= 0) {
+      GCodeQueue::SerialState &serial = GCodeQueue::serial_state[index.index];
+      serial.bytes_read++;
+      if (c == '\n') serial.lines_read++;
+    }
+    return c;
+  }
+
+  /**
+   * Grant a host on credit flow control room for as many lines as the
+   * command queue can take and as many bytes as the RX buffer can hold.
+   * Limits are cumulative counts since "M577 S1", so a lost report costs
+   * nothing and a grant can never be taken back.
+   *
+   * To save bandwidth a report waits until a batch of lines or half the
+   * RX buffer has been freed, unless the planner is running low.
+   */
+  void GCodeQueue::report_credits(const serial_index_t serial_ind, const bool force/*=false*/) {
+    SerialState &serial = serial_state[serial_ind.index];
+    if (!serial.credits) return;
+
+    const uint32_t lines = serial.lines_read + ring_buffer.free_commands(),
+                   bytes = serial.bytes_read + RX_BUFFER_SIZE - 1;
+    const int32_t more_lines = int32_t(lines - serial.lines_granted),
+                  more_bytes = int32_t(bytes - serial.bytes_granted);
+
+    if (!force) {
+      if (more_lines <= 0 && more_bytes <= 0) return;
+      if (more_lines < (SERIAL_CREDITS_BATCH) && more_bytes < (RX_BUFFER_SIZE) / 2
+        && planner.movesplanned() >= (BLOCK_BUFFER_SIZE) / 4
+      ) return;
+    }
+
+    if (more_lines > 0) serial.lines_granted = lines;
+    if (more_bytes > 0) serial.bytes_granted = bytes;
+
+    PORT_REDIRECT(SERIAL_PORTMASK(serial_ind));
+    SERIAL_ECHOLNPAIR("credit L", serial.lines_granted, " B", serial.bytes_granted);
+  }
+
+  void GCodeQueue::set_credits(const bool on) {
+    const serial_index_t serial_ind = ring_buffer.command_port();
+    if (!serial_ind.valid()) return;
+    SerialState &serial = serial_state[serial_ind.index];
+    serial.credits = on;
+    if (on) {
+      // The host counts from the end of the M577 line and waits for the first report
+      serial.lines_read = serial.bytes_read = serial.lines_granted = serial.bytes_granted = 0;
+      report_credits(serial_ind, true);
+    }
+  }
+
+#else
+
+  inline int read_serial(const serial_index_t index) { return SERIAL_IMPL.read(index); }
+
+#endif
 
 void GCodeQueue::gcode_line_error(PGM_P const err, const serial_index_t serial_ind) {
   PORT_REDIRECT(SERIAL_PORTMASK(serial_ind)); // Reply to the serial port that sent the command
@@ -327,7 +460,7 @@ FORCE_INLINE bool is_M29(const char * const cmd) {  // matches "M29" & "M29 ", b
 #define PS_PAREN  3
 #define PS_ESC    4
 
-inline void process_stream_char(const char c, uint8_t &sis, char (&buff)[MAX_CMD_SIZE], int &ind) {
+inline void process_stream_char(const char c, uint8_t &sis, char * const buff, int &ind) {
 
   if (sis == PS_EOL) return;    // EOL comment or overflow
 
@@ -383,7 +516,7 @@ inline void process_stream_char(const char c, uint8_t &sis, char (&buff)[MAX_CMD
  * Handle a line being completed. For an empty line
  * keep sensor readings going and watchdog alive.
  */
-inline bool process_line_done(uint8_t &sis, char (&buff)[MAX_CMD_SIZE], int &ind) {
+inline bool process_line_done(uint8_t &sis, char * const buff, int &ind) {
   sis = PS_NORMAL;                    // "Normal" Serial Input State
   buff[ind] = '\0';                   // Of course, I'm a Terminator.
   const bool is_empty = (ind == 0);   // An empty line?
@@ -403,15 +536,19 @@ void GCodeQueue::get_serial_commands() {
   #if ENABLED(BINARY_FILE_TRANSFER)
     if (card.flag.binary_mode) {
       /**
-       * For binary stream file transfer, use serial_line_buffer as the working
-       * receive buffer (which limits the packet size to MAX_CMD_SIZE).
-       * The receive buffer also limits the packet size for reliable transmission.
+       * Binary stream packets are received into their own buffers, up to
+       * BINARY_STREAM_WINDOW packets of BINARY_STREAM_PACKET_SIZE bytes.
        */
-      binaryStream[card.transfer_port_index.index].receive(serial_state[card.transfer_port_index.index].line_buffer);
+      binaryStream[card.transfer_port_index.index].receive();
       return;
     }
   #endif
 
+  // Tell hosts on credit flow control about freed space
+  #if ENABLED(SERIAL_CREDITS)
+    LOOP_L_N(p, NUM_SERIAL) report_credits(p);
+  #endif
+
   // If the command buffer is empty for too long,
   // send "wait" to indicate Marlin is still waiting.
   #if NO_TIMEOUTS > 0
@@ -553,6 +690,75 @@ void GCodeQueue::get_serial_commands() {
 
 #if ENABLED(SDSUPPORT)
 
+  /**
+   * Put a line from the SD Card into the buffer (no "ok" sent)
+   */
+  inline void commit_sd_command(char * const command, const int len
+    OPTARG(PARSE_AT_ENQUEUE, const bool preparsed=false)
+  ) {
+    // M808 L saves the sdpos of the next line. M808 loops to a new sdpos.
+    TERN_(GCODE_REPEAT_MARKERS, repeat.early_parse_M808(command));
+
+    #if DISABLED(PARK_HEAD_ON_PAUSE)
+      // When M25 is non-blocking it can still suspend SD commands
+      // Otherwise the M125 handler needs to know SD printing is active
+      if (command[0] == 'M' && command[1] == '2' && command[2] == '5' && !NUMERIC(command[3]))
+        card.pauseSDPrint();
+    #endif
+
+    queue.ring_buffer.commit_command(command, len, true
+      OPTARG(HAS_MULTI_SERIAL, serial_index_t())
+      OPTARG(PARSE_AT_ENQUEUE, preparsed)
+    );
+
+    // Prime Power-Loss Recovery for the NEXT commit_command
+    TERN_(POWER_LOSS_RECOVERY, recovery.cmd_sdpos = card.getIndex());
+  }
+
+  #if ENABLED(BINARY_GCODE)
+
+    /**
+     * Read a binary command record from the SD Card and decode it into 'command'.
+     * Return the length of the line, or -1 for a bad record.
+     */
+    inline int16_t get_sd_binary_command(char * const command OPTARG(PARSE_AT_ENQUEUE, parsed_command_t &parsed)) {
+      uint8_t * const rec = BinaryGCode::record;
+      uint16_t size = BinaryGCode::HEADER_SIZE;
+      for (uint16_t i = 0; i < size; i++) {
+        const int16_t c = card.get();
+        if (c < 0) return -1;                         // Cut short by the end of the file
+        if (i < sizeof(BinaryGCode::record)) rec[i] = c;
+        if (i == 1) size = BinaryGCode::record_size(rec);
+      }
+      if (size > sizeof(BinaryGCode::record)) return -1;
+      return BinaryGCode::decode(rec, command, MAX_CMD_SIZE OPTARG(PARSE_AT_ENQUEUE, parsed));
+    }
+
+  #endif
+
+  #if ENABLED(MEATPACK_SD_FILES)
+
+    /**
+     * Unpack bytes from a MeatPack file into 'command' up to the end of a line.
+     * Return 1 at the end of the line, 0 at the end of the file, or -1 on a read error.
+     */
+    inline int8_t get_sd_packed_line(char * const command, uint8_t &sis, int &count) {
+      char chars[MeatPack::kMaxOutput];
+      while (!card.eof()) {
+        const int16_t n = card.get();
+        if (n < 0) return -1;
+        card.meatpack.handle_rx_char(uint8_t(n), serial_index_t());
+        const uint8_t got = card.meatpack.get_result_char(chars);
+        LOOP_L_N(i, got) {
+          if (ISEOL(chars[i])) return 1;              // The rest of the byte is padding
+          process_stream_char(chars[i], sis, command, count);
+        }
+      }
+      return 0;
+    }
+
+  #endif
+
   /**
    * Get lines from the SD Card until the command buffer is full
    * or until the end of the file is reached. Because this method
@@ -567,50 +773,142 @@ void GCodeQueue::get_serial_commands() {
 
     int sd_count = 0;
     while (!ring_buffer.full() && !card.eof()) {
-      const int16_t n = card.get();
-      const bool card_eof = card.eof();
-      if (n < 0 && !card_eof) { SERIAL_ERROR_MSG(STR_SD_ERR_READ); continue; }
+      // Read the line straight into the queue
+      char * const command = ring_buffer.reserve(MAX_CMD_SIZE);
+
+      #if ENABLED(MEATPACK_SD_FILES)
+        if (card.flag.packed) {
+          if (get_sd_packed_line(command, sd_input_state, sd_count) < 0) {
+            SERIAL_ERROR_MSG(STR_SD_ERR_READ);
+            continue;
+          }
+          const int len = sd_count;
+          if (!process_line_done(sd_input_state, command, sd_count))
+            commit_sd_command(command, len);
+          if (card.eof()) card.fileHasFinished();
+          continue;
+        }
+      #endif
+
+      #if ENABLED(BINARY_GCODE)
+        // A line starting with a byte over 127 is a binary command record
+        if (!sd_count && sd_input_state == PS_NORMAL && BinaryGCode::is_record(card.peek())) {
+          const int16_t len = get_sd_binary_command(command OPTARG(PARSE_AT_ENQUEUE, ring_buffer.next_parsed()));
+          if (len < 0)
+            SERIAL_ERROR_MSG(STR_ERR_BINARY_GCODE);
+          else if (len)
+            commit_sd_command(command, len OPTARG(PARSE_AT_ENQUEUE, ring_buffer.next_parsed().command_letter != '\0'));
+          if (card.eof()) card.fileHasFinished();
+          continue;
+        }
+      #endif
+
+      #if HAS_SD_READ_AHEAD
+
+        // Scan the line in place in the read-ahead buffer
+        const char *line;
+        const int16_t n = card.peekLine(line);
+        if (n < 0) { SERIAL_ERROR_MSG(STR_SD_ERR_READ); continue; }
+
+        const bool is_eol = n && ISEOL(line[n - 1]);
+        for (int16_t i = 0; i < n - is_eol; i++)
+          process_stream_char(line[i], sd_input_state, command, sd_count);
+        card.consume(n);
+
+        if (!is_eol && !card.eof()) continue;         // The line goes on past the buffered data
 
-      CommandLine &command = ring_buffer.commands[ring_buffer.index_w];
-      const char sd_char = (char)n;
-      const bool is_eol = ISEOL(sd_char);
-      if (is_eol || card_eof) {
+      #else
+
+        const int16_t n = card.get();
+        const bool card_eof = card.eof();
+        if (n < 0 && !card_eof) { SERIAL_ERROR_MSG(STR_SD_ERR_READ); continue; }
+
+        const char sd_char = (char)n;
+        const bool is_eol = ISEOL(sd_char);
+        if (!is_eol && !card_eof) {
+          process_stream_char(sd_char, sd_input_state, command, sd_count);
+          continue;
+        }
 
-        // Reset stream state, terminate the buffer, and commit a non-empty command
         if (!is_eol && sd_count) ++sd_count;          // End of file with no newline
-        if (!process_line_done(sd_input_state, command.buffer, sd_count)) {
 
-          // M808 L saves the sdpos of the next line. M808 loops to a new sdpos.
-          TERN_(GCODE_REPEAT_MARKERS, repeat.early_parse_M808(command.buffer));
+      #endif
 
-          #if DISABLED(PARK_HEAD_ON_PAUSE)
-            // When M25 is non-blocking it can still suspend SD commands
-            // Otherwise the M125 handler needs to know SD printing is active
-            if (command.buffer[0] == 'M' && command.buffer[1] == '2' && command.buffer[2] == '5' && !NUMERIC(command.buffer[3]))
-              card.pauseSDPrint();
-          #endif
+      // Reset stream state, terminate the buffer, and commit a non-empty command
+      const int len = sd_count;
+      if (!process_line_done(sd_input_state, command, sd_count))
+        commit_sd_command(command, len);
 
-          // Put the new command into the buffer (no "ok" sent)
-          ring_buffer.commit_command(true);
+      if (card.eof()) card.fileHasFinished();         // Handle end of file reached
+    }
+  }
+
+#endif // SDSUPPORT
 
-          // Prime Power-Loss Recovery for the NEXT commit_command
-          TERN_(POWER_LOSS_RECOVERY, recovery.cmd_sdpos = card.getIndex());
+#if ENABLED(BINARY_STREAM_PRINT)
+
+  /**
+   * Get lines from a stream print until the command buffer is full or the
+   * print buffer runs dry. A line can arrive over several packets, so it's
+   * collected apart from the queue, as with serial input.
+   */
+  inline void GCodeQueue::get_stream_commands() {
+    while (!ring_buffer.full()) {
+
+      #if ENABLED(BINARY_GCODE)
+        // A line starting with a byte over 127 is a binary command record
+        if (!StreamPrint::count && StreamPrint::input_state == PS_NORMAL
+          && StreamPrint::available() && BinaryGCode::is_record(StreamPrint::peek())
+        ) {
+          const uint16_t used = StreamPrint::used();
+          if (used < BinaryGCode::HEADER_SIZE || used < BinaryGCode::HEADER_SIZE + StreamPrint::peek(1)) {
+            if (StreamPrint::active) return;          // Wait for the rest of the record
+            SERIAL_ERROR_MSG(STR_ERR_BINARY_GCODE);   // Cut short by the end of the file
+            StreamPrint::clear();
+            return;
+          }
+          uint8_t * const rec = BinaryGCode::record;
+          const uint16_t size = BinaryGCode::HEADER_SIZE + StreamPrint::peek(1);
+          for (uint16_t i = 0; i < size; i++) {
+            const char c = StreamPrint::read();
+            if (i < sizeof(BinaryGCode::record)) rec[i] = c;
+          }
+          if (size > sizeof(BinaryGCode::record))
+            SERIAL_ERROR_MSG(STR_ERR_BINARY_GCODE);
+          else
+            ring_buffer.enqueue_binary(rec, true OPTARG(HAS_MULTI_SERIAL, card.transfer_port_index));
+          continue;
         }
+      #endif
 
-        if (card.eof()) card.fileHasFinished();         // Handle end of file reached
+      if (StreamPrint::available()) {
+        const char c = StreamPrint::read();
+        if (!ISEOL(c)) {
+          process_stream_char(c, StreamPrint::input_state, StreamPrint::line, StreamPrint::count);
+          continue;
+        }
       }
-      else
-        process_stream_char(sd_char, sd_input_state, command.buffer, sd_count);
+      else if (StreamPrint::active)
+        return;                                       // Wait for more of the line
+      else if (!StreamPrint::count) {
+        StreamPrint::input_state = PS_NORMAL;         // End of the print
+        return;
+      }
+
+      // Reset stream state, terminate the buffer, and queue a non-empty command
+      if (!process_line_done(StreamPrint::input_state, StreamPrint::line, StreamPrint::count))
+        ring_buffer.enqueue(StreamPrint::line, true OPTARG(HAS_MULTI_SERIAL, card.transfer_port_index));
     }
   }
 
-#endif // SDSUPPORT
+#endif // BINARY_STREAM_PRINT
 
 /**
  * Add to the circular command queue the next command from:
  *  - The command-injection queues (injected_commands_P, injected_commands)
  *  - The active serial input (usually USB)
  *  - The SD card file being actively printed
+ *  - The file being stream printed
  */
 void GCodeQueue::get_available_commands() {
   if (ring_buffer.full()) return;
@@ -618,6 +916,8 @@ void GCodeQueue::get_available_commands() {
   get_serial_commands();
 
   TERN_(SDSUPPORT, get_sdcard_commands());
+
+  TERN_(BINARY_STREAM_PRINT, get_stream_commands());
 }
 
 /**
@@ -703,7 +1003,7 @@ void GCodeQueue::advance() {
   void GCodeQueue::report_buffer_statistics() {
     SERIAL_ECHOLNPAIR("D576"
       " P:", planner.moves_free(),         " ", -queue.planner_buffer_underruns, " (", queue.max_planner_buffer_empty_duration, ")"
-      " B:", BUFSIZE - ring_buffer.length, " ", -queue.command_buffer_underruns, " (", queue.max_command_buffer_empty_duration, ")"
+      " B:", ring_buffer.free_commands(), " ", -queue.command_buffer_underruns, " (", queue.max_command_buffer_empty_duration, ")"
     );
     command_buffer_underruns = planner_buffer_underruns = 0;
     max_command_buffer_empty_duration = max_planner_buffer_empty_duration = 0;
@@ -28,6 +28,10 @@
 
 #include "../inc/MarlinConfig.h"
 
+#if ENABLED(PARSE_AT_ENQUEUE)
+  #include "parser.h"
+#endif
+
 class GCodeQueue {
 public:
   /**
@@ -43,25 +47,37 @@ public:
     int count;                      //!< Number of characters read in the current line of serial input
     char line_buffer[MAX_CMD_SIZE]; //!< The current line accumulator
     uint8_t input_state;            //!< The input state
+    #if ENABLED(SERIAL_CREDITS)
+      bool credits;                 //!< Credit flow control is on (M577 S1)
+      uint32_t lines_read,          //!< Newlines read from the port since M577 S1
+               bytes_read,          //!< Bytes read from the port since M577 S1
+               lines_granted,       //!< Line limit sent in the last credit report
+               bytes_granted;       //!< Byte limit sent in the last credit report
+    #endif
   };
 
   static SerialState serial_state[NUM_SERIAL]; //!< Serial states for each serial port
 
   /**
    * GCode Command Queue
-   * A simple (circular) ring buffer of BUFSIZE command strings.
+   * A (circular) ring buffer of up to MAX_QUEUED_COMMANDS command strings,
+   * packed end-to-end in an arena of BUFSIZE * MAX_CMD_SIZE bytes.
    *
    * Commands are copied into this buffer by the command injectors
-   * (immediate, serial, sd card) and they are processed sequentially by
-   * the main loop. The gcode.process_next_command method parses the next
-   * command and hands off execution to individual handler functions.
+   * (immediate, serial) or written in place (sd card) and they are processed
+   * sequentially by the main loop. The gcode.process_next_command method
+   * parses the next command and hands off execution to individual handler
+   * functions.
    */
   struct CommandLine {
-    char buffer[MAX_CMD_SIZE];      //!< The command buffer
+    uint16_t offset;                //!< The command's position in the arena
     bool skip_ok;                   //!< Skip sending ok when command is processed?
     #if HAS_MULTI_SERIAL
       serial_index_t port;          //!< Serial port the command was received on
     #endif
+    #if ENABLED(PARSE_AT_ENQUEUE)
+      parsed_command_t parsed;      //!< The command, parsed when it was queued
+    #endif
   };
 
   /**
@@ -71,25 +87,57 @@ public:
     uint8_t length,                 //!< Number of commands in the queue
             index_r,                //!< Ring buffer's read position
             index_w;                //!< Ring buffer's write position
-    CommandLine commands[BUFSIZE];  //!< The ring buffer of commands
+    uint16_t arena_w;               //!< Arena position after the newest command
+    CommandLine commands[MAX_QUEUED_COMMANDS]; //!< The ring buffer of commands
+    char arena[BUFSIZE * MAX_CMD_SIZE];        //!< The command strings
+    #if BOTH(PARSE_AT_ENQUEUE, SDSUPPORT)
+      bool hold_parsing;            //!< An M28 is queued, so keep the following lines raw for the file
+    #endif
 
     inline serial_index_t command_port() const { return TERN0(HAS_MULTI_SERIAL, commands[index_r].port); }
 
-    inline void clear() { length = index_r = index_w = 0; }
+    inline void clear() {
+      length = index_r = index_w = 0;
+      arena_w = 0;
+      #if BOTH(PARSE_AT_ENQUEUE, SDSUPPORT)
+        hold_parsing = false;
+      #endif
+    }
 
-    void advance_pos(uint8_t &p, const int inc) { if (++p >= BUFSIZE) p = 0; length += inc; }
+    void advance_pos(uint8_t &p, const int inc) { if (++p >= MAX_QUEUED_COMMANDS) p = 0; length += inc; }
 
-    void commit_command(bool skip_ok
+    /**
+     * Get space for a command of 'size' bytes (including the terminator)
+     * or nullptr if it doesn't fit. The space is claimed by commit_command.
+     */
+    char* reserve(const uint16_t size);
+
+    void commit_command(const char *cmd, const uint16_t len, bool skip_ok
       OPTARG(HAS_MULTI_SERIAL, serial_index_t serial_ind = serial_index_t())
+      OPTARG(PARSE_AT_ENQUEUE, const bool preparsed = false)
     );
 
     bool enqueue(const char *cmd, bool skip_ok = true
       OPTARG(HAS_MULTI_SERIAL, serial_index_t serial_ind = serial_index_t())
     );
 
+    #if ENABLED(BINARY_GCODE)
+      bool enqueue_binary(const uint8_t * const rec, bool skip_ok = true
+        OPTARG(HAS_MULTI_SERIAL, serial_index_t serial_ind = serial_index_t())
+      );
+
+      #if ENABLED(PARSE_AT_ENQUEUE)
+        // The parsed record of the next command, for a decoder to fill in
+        inline parsed_command_t& next_parsed() { return commands[index_w].parsed; }
+      #endif
+    #endif
+
     void ok_to_send();
 
-    inline bool full(uint8_t cmdCount=1) const { return length > (BUFSIZE - cmdCount); }
+    // Full when there are no free commands or no room for a full-length line
+    inline bool full(uint8_t cmdCount=1) { return length > (MAX_QUEUED_COMMANDS - cmdCount) || !reserve(MAX_CMD_SIZE); }
+
+    inline uint8_t free_commands() const { return MAX_QUEUED_COMMANDS - length; }
 
     inline bool occupied() const { return length != 0; }
 
@@ -97,7 +145,7 @@ public:
 
     inline CommandLine& peek_next_command() { return commands[index_r]; }
 
-    inline char* peek_next_command_string() { return peek_next_command().buffer; }
+    inline char* peek_next_command_string() { return &arena[peek_next_command().offset]; }
   };
 
   /**
@@ -172,6 +220,7 @@ public:
    *  - The command-injection queue (injected_commands_P)
    *  - The active serial input (usually USB)
    *  - The SD card file being actively printed
+   *  - The file being stream printed
    */
   static void get_available_commands();
 
@@ -192,6 +241,23 @@ public:
    */
   static void flush_and_request_resend(const serial_index_t serial_ind);
 
+  #if ENABLED(SERIAL_CREDITS)
+    /**
+     * Send "credit L<lines> B<bytes>" to a port using credit flow control,
+     * unless the limits have grown too little to be worth a report.
+     */
+    static void report_credits(const serial_index_t serial_ind, const bool force=false);
+
+    /**
+     * Turn credit flow control on or off for the port that sent the current command
+     */
+    static void set_credits(const bool on);
+    static inline bool credits_enabled() {
+      const serial_index_t serial_ind = ring_buffer.command_port();
+      return serial_ind.valid() && serial_state[serial_ind.index].credits;
+    }
+  #endif
+
   /**
    * (Re)Set the current line number for the last received command
    */
@@ -245,6 +311,10 @@ private:
     static void get_sdcard_commands();
   #endif
 
+  #if ENABLED(BINARY_STREAM_PRINT)
+    static void get_stream_commands();
+  #endif
+
   // Process the next "immediate" command (PROGMEM)
   static bool process_injected_command_P();
 
@@ -0,0 +1,52 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../inc/MarlinConfig.h"
+
+#if HAS_SD_BLOCK_CACHE
+
+#include "../gcode.h"
+#include "../../sd/cardreader.h"
+
+static void report_cache_stat(PGM_P const label, const uint32_t hits, const uint32_t misses) {
+  SERIAL_ECHOPGM_P(label);
+  SERIAL_ECHOPAIR(" hits:", hits, " misses:", misses);
+  if (hits + misses) SERIAL_ECHOPAIR(" (", int(hits * 100.0f / (hits + misses)), "%)");
+  SERIAL_EOL();
+}
+
+/**
+ * M35: Report SD block cache statistics
+ *
+ *   R  Reset the counters after reporting
+ */
+void GcodeSuite::M35() {
+  const cache_stats_t &stats = card.cacheStats();
+  SERIAL_ECHOLNPAIR("SD cache blocks:", SD_CACHE_BLOCKS);
+  report_cache_stat(PSTR(" FAT "), stats.hits[SdVolume::CACHE_PRIORITY_FAT], stats.misses[SdVolume::CACHE_PRIORITY_FAT]);
+  report_cache_stat(PSTR(" Dir "), stats.hits[SdVolume::CACHE_PRIORITY_DIR], stats.misses[SdVolume::CACHE_PRIORITY_DIR]);
+  report_cache_stat(PSTR(" Data"), stats.hits[SdVolume::CACHE_PRIORITY_DATA], stats.misses[SdVolume::CACHE_PRIORITY_DATA]);
+  SERIAL_ECHOLNPAIR(" Writes:", stats.writes);
+  if (parser.seen('R')) card.resetCacheStats();
+}
+
+#endif // HAS_SD_BLOCK_CACHE
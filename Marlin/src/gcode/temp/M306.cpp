@@ -0,0 +1,109 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(MPCTEMP)
+
+#include "../gcode.h"
+#include "../../lcd/marlinui.h"
+#include "../../module/motion.h"
+#include "../../module/temperature.h"
+
+/**
+ * M306: MPC settings and autotune
+ *
+ *  E<extruder>   Extruder index. (Default: Active extruder)
+ *
+ *  P<watts>      Heater power
+ *  C<joules/kelvin>            Block heat capacity
+ *  R<kelvin/second/kelvin>     Sensor responsiveness
+ *  A<watts/kelvin>             Ambient heat transfer coefficient with no fan
+ *  F<watts/kelvin>             Ambient heat transfer coefficient with fan on full
+ *  H<joules/kelvin/millimeter> Filament heat capacity per mm
+ *
+ *  T             Autotune the active extruder
+ *
+ * With no parameters, report the settings of the given extruder.
+ */
+void GcodeSuite::M306() {
+
+  if (parser.seen_test('T')) {
+    #if DISABLED(BUSY_WHILE_HEATING)
+      KEEPALIVE_STATE(NOT_BUSY);
+    #endif
+
+    #ifdef MPC_TUNING_POS
+      // Tune at the print surface, in the air flow of a print
+      if (homing_needed()) home_all_axes();
+      constexpr xyz_pos_t tuning_pos = MPC_TUNING_POS;
+      do_blocking_move_to(tuning_pos);
+    #endif
+
+    LCD_MESSAGEPGM(MSG_MPC_AUTOTUNE);
+    thermalManager.MPC_autotune();
+    ui.reset_status();
+
+    #ifdef MPC_TUNING_POS
+      do_z_clearance(MPC_TUNING_END_Z);
+    #endif
+    return;
+  }
+
+  const uint8_t e = parser.seenval('E') ? parser.value_byte() : active_extruder;
+  if (e >= HOTENDS) {
+    SERIAL_ERROR_MSG(STR_INVALID_EXTRUDER);
+    return;
+  }
+
+  // The model divides by the power and heat capacity, and steps by the responsiveness
+  LOOP_L_N(i, 3) {
+    const char p = "PCR"[i];
+    if (parser.seenval(p) && parser.value_float() <= 0) {
+      SERIAL_ERROR_MSG("?", AS_CHAR(p), " must be positive");
+      return;
+    }
+  }
+
+  MPC_t &constants = thermalManager.temp_hotend[e].constants;
+  if (parser.seenval('P')) constants.heater_power = parser.value_float();
+  if (parser.seenval('C')) constants.block_heat_capacity = parser.value_float();
+  if (parser.seenval('R')) constants.sensor_responsiveness = parser.value_float();
+  if (parser.seenval('A')) constants.ambient_xfer_coeff_fan0 = parser.value_float();
+  #if ENABLED(MPC_INCLUDE_FAN)
+    if (parser.seenval('F')) constants.fan255_adjustment = parser.value_float() - constants.ambient_xfer_coeff_fan0;
+  #endif
+  if (parser.seenval('H')) constants.filament_heat_capacity_permm = parser.value_float();
+
+  SERIAL_ECHO_START();
+  SERIAL_ECHOPAIR(" e:", e);
+  SERIAL_ECHOPAIR_F(" p:", constants.heater_power, 2);
+  SERIAL_ECHOPAIR_F(" c:", constants.block_heat_capacity, 2);
+  SERIAL_ECHOPAIR_F(" r:", constants.sensor_responsiveness, 4);
+  SERIAL_ECHOPAIR_F(" a:", constants.ambient_xfer_coeff_fan0, 4);
+  #if ENABLED(MPC_INCLUDE_FAN)
+    SERIAL_ECHOPAIR_F(" f:", constants.ambient_xfer_coeff_fan0 + constants.fan255_adjustment, 4);
+  #endif
+  SERIAL_ECHOLNPAIR_F(" h:", constants.filament_heat_capacity_permm, 4);
+}
+
+#endif // MPCTEMP
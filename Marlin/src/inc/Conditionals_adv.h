@@ -573,6 +573,23 @@
   #define HAS_MEDIA_SUBCALLS 1
 #endif
 
+#if ENABLED(SDSUPPORT) && SD_READ_AHEAD_BLOCKS
+  #define HAS_SD_READ_AHEAD 1
+#endif
+
+#if ENABLED(SDSUPPORT) && SD_CACHE_BLOCKS > 1
+  #define HAS_SD_BLOCK_CACHE 1
+#endif
+
+#if ENABLED(SDSUPPORT) && SD_PREALLOCATE_CLUSTERS > 1
+  #define HAS_SD_PREALLOCATE 1
+#endif
+
+// Commands in the packed command queue
+#ifndef MAX_QUEUED_COMMANDS
+  #define MAX_QUEUED_COMMANDS BUFSIZE
+#endif
+
 #if HAS_PRINT_PROGRESS && EITHER(PRINT_PROGRESS_SHOW_DECIMALS, SHOW_REMAINING_TIME)
   #define HAS_PRINT_PROGRESS_PERMYRIAD 1
 #endif
@@ -891,6 +908,17 @@
   #endif
 #endif
 
+// Input Shaping
+#if LINEAR_AXES < 2
+  #undef INPUT_SHAPING_Y
+#endif
+#if EITHER(INPUT_SHAPING_X, INPUT_SHAPING_Y)
+  #define HAS_SHAPING 1
+  #ifndef SHAPING_BUFFER_SIZE
+    #define SHAPING_BUFFER_SIZE 512
+  #endif
+#endif
+
 // Remove unused STEALTHCHOP flags
 #if LINEAR_AXES < 6
   #undef STEALTHCHOP_K
@@ -981,3 +1009,25 @@
 #if EITHER(MEATPACK_ON_SERIAL_PORT_1, MEATPACK_ON_SERIAL_PORT_2)
   #define HAS_MEATPACK 1
 #endif
+#if ENABLED(MEATPACK_SD_FILES)
+  #define MEATPACK_V2
+#endif
+#if ENABLED(MEATPACK_V2) && !defined(MEATPACK_TOKEN_SIZE)
+  #define MEATPACK_TOKEN_SIZE 6
+#endif
+
+#if ENABLED(SERIAL_CREDITS) && !defined(SERIAL_CREDITS_BATCH)
+  #define SERIAL_CREDITS_BATCH (((MAX_QUEUED_COMMANDS) + 3) / 4)
+#endif
+
+#if ENABLED(BINARY_FILE_TRANSFER)
+  #ifndef BINARY_STREAM_WINDOW
+    #define BINARY_STREAM_WINDOW 1
+  #endif
+  #ifndef BINARY_STREAM_PACKET_SIZE
+    #define BINARY_STREAM_PACKET_SIZE MAX_CMD_SIZE
+  #endif
+  #if ENABLED(BINARY_STREAM_PRINT) && !defined(BINARY_STREAM_PRINT_BUFFER)
+    #define BINARY_STREAM_PRINT_BUFFER 1024
+  #endif
+#endif
@@ -671,6 +671,15 @@ static_assert(COUNT(arm) == LOGICAL_AXES, "AXIS_RELATIVE_MODES must contain " _L
 #elif ANY(SERIAL_XON_XOFF, SERIAL_STATS_MAX_RX_QUEUED, SERIAL_STATS_DROPPED_RX)
   #error "SERIAL_XON_XOFF and SERIAL_STATS_* features not supported on USB-native AVR devices."
 #endif
+#if ENABLED(SERIAL_CREDITS)
+  #if defined(__AVR__) && defined(USBCON)
+    #error "SERIAL_CREDITS is not supported on USB-native AVR devices."
+  #elif RX_BUFFER_SIZE < 32
+    #error "SERIAL_CREDITS requires an RX_BUFFER_SIZE of at least 32."
+  #elif SERIAL_CREDITS_BATCH < 1 || SERIAL_CREDITS_BATCH > MAX_QUEUED_COMMANDS
+    #error "SERIAL_CREDITS_BATCH must be from 1 to MAX_QUEUED_COMMANDS."
+  #endif
+#endif
 
 /**
  * Multiple Stepper Drivers Per Axis
@@ -1200,6 +1209,85 @@ static_assert(Y_MAX_LENGTH >= Y_BED_SIZE, "Movement bounds (Y_MIN_POS, Y_MAX_POS
   #endif
 #endif
 
+/**
+ * Input Shaping requirements
+ */
+#if HAS_SHAPING
+  #if IS_KINEMATIC
+    #error "Input Shaping is not compatible with DELTA, SCARA, or other kinematic machines."
+  #elif ENABLED(DUAL_X_CARRIAGE)
+    #error "Input Shaping is not compatible with DUAL_X_CARRIAGE."
+  #elif ENABLED(DIRECT_STEPPING)
+    #error "Input Shaping is not compatible with DIRECT_STEPPING."
+  #elif ENABLED(I2S_STEPPER_STREAM)
+    #error "Input Shaping is not compatible with I2S_STEPPER_STREAM."
+  #elif !WITHIN(SHAPING_BUFFER_SIZE, 16, 16384) || (SHAPING_BUFFER_SIZE & (SHAPING_BUFFER_SIZE - 1))
+    #error "SHAPING_BUFFER_SIZE must be a power of 2 from 16 to 16384."
+  #endif
+  #if ENABLED(INPUT_SHAPING_X)
+    static_assert(SHAPING_FREQ_X == 0 || WITHIN(SHAPING_FREQ_X, SHAPING_MIN_FREQ, SHAPING_MAX_FREQ), "SHAPING_FREQ_X must be 0 or from SHAPING_MIN_FREQ to SHAPING_MAX_FREQ.");
+    static_assert(WITHIN(SHAPING_ZETA_X, 0, 0.99), "SHAPING_ZETA_X must be from 0 to 0.99.");
+  #endif
+  #if ENABLED(INPUT_SHAPING_Y)
+    static_assert(SHAPING_FREQ_Y == 0 || WITHIN(SHAPING_FREQ_Y, SHAPING_MIN_FREQ, SHAPING_MAX_FREQ), "SHAPING_FREQ_Y must be 0 or from SHAPING_MIN_FREQ to SHAPING_MAX_FREQ.");
+    static_assert(WITHIN(SHAPING_ZETA_Y, 0, 0.99), "SHAPING_ZETA_Y must be from 0 to 0.99.");
+  #endif
+#endif
+
+/**
+ * Step Segment Buffer requirements
+ */
+#if ENABLED(STEP_SEGMENT_BUFFER)
+  #if !WITHIN(STEP_SEGMENT_BUFFER_SIZE, 4, 128) || (STEP_SEGMENT_BUFFER_SIZE & (STEP_SEGMENT_BUFFER_SIZE - 1))
+    #error "STEP_SEGMENT_BUFFER_SIZE must be a power of 2 from 4 to 128."
+  #elif !WITHIN(STEP_SEGMENT_TIME, 100, 10000)
+    #error "STEP_SEGMENT_TIME must be from 100 to 10000 (µs)."
+  #endif
+#endif
+
+/**
+ * Arc Blocks requirements
+ */
+#if ENABLED(ARC_BLOCKS)
+  #if DISABLED(ARC_SUPPORT)
+    #error "ARC_BLOCKS requires ARC_SUPPORT."
+  #elif IS_KINEMATIC || IS_CORE || ENABLED(MARKFORGED_XY)
+    #error "ARC_BLOCKS is only compatible with Cartesian machines."
+  #elif ENABLED(SKEW_CORRECTION)
+    #error "ARC_BLOCKS is not compatible with SKEW_CORRECTION."
+  #elif ENABLED(BACKLASH_COMPENSATION)
+    #error "ARC_BLOCKS is not compatible with BACKLASH_COMPENSATION."
+  #endif
+#endif
+
+/**
+ * Path Blending requirements
+ */
+#if ENABLED(PATH_BLENDING)
+  #if IS_KINEMATIC
+    #error "PATH_BLENDING is only compatible with Cartesian machines."
+  #elif ENABLED(LASER_POWER_INLINE)
+    #error "PATH_BLENDING is not compatible with LASER_POWER_INLINE."
+  #elif !WITHIN(PATH_BLENDING_MAX_SEGMENTS, 2, 32)
+    #error "PATH_BLENDING_MAX_SEGMENTS must be from 2 to 32."
+  #endif
+#endif
+
+/**
+ * SD read-ahead buffer, block cache, and cluster pre-allocation sizes
+ */
+#if HAS_SD_READ_AHEAD && !WITHIN(SD_READ_AHEAD_BLOCKS, 1, 32)
+  #error "SD_READ_AHEAD_BLOCKS must be from 1 to 32."
+#endif
+#if HAS_SD_BLOCK_CACHE && SD_CACHE_BLOCKS > 16
+  #error "SD_CACHE_BLOCKS must be from 1 to 16."
+#endif
+#if HAS_SD_PREALLOCATE && SD_PREALLOCATE_CLUSTERS > 255
+  #error "SD_PREALLOCATE_CLUSTERS must be from 2 to 255."
+#elif HAS_SD_PREALLOCATE && ENABLED(SDCARD_READONLY)
+  #error "SD_PREALLOCATE_CLUSTERS is not compatible with SDCARD_READONLY."
+#endif
+
 /**
  * Special tool-changing options
  */
@@ -1322,6 +1410,33 @@ static_assert(Y_MAX_LENGTH >= Y_BED_SIZE, "Movement bounds (Y_MIN_POS, Y_MAX_POS
   #error "You must set DISPLAY_CHARSET_HD44780 to JAPANESE, WESTERN or CYRILLIC for your LCD controller."
 #endif
 
+/**
+ * Hotend Heating Options - PID vs Model Predictive Control
+ */
+#if BOTH(PIDTEMP, MPCTEMP)
+  #error "Only enable PIDTEMP or MPCTEMP, but not both."
+#elif ENABLED(MPCTEMP)
+  #if !HAS_HOTEND
+    #error "MPCTEMP requires at least one hotend."
+  #elif ENABLED(DWIN_CREALITY_LCD)
+    #error "MPCTEMP is not yet supported by DWIN_CREALITY_LCD."
+  #elif !defined(MPC_HEATER_POWER) || !defined(MPC_BLOCK_HEAT_CAPACITY) || !defined(MPC_SENSOR_RESPONSIVENESS) || !defined(MPC_AMBIENT_XFER_COEFF) || !defined(FILAMENT_HEAT_CAPACITY_PERMM)
+    #error "MPCTEMP requires MPC_HEATER_POWER, MPC_BLOCK_HEAT_CAPACITY, MPC_SENSOR_RESPONSIVENESS, MPC_AMBIENT_XFER_COEFF, and FILAMENT_HEAT_CAPACITY_PERMM."
+  #elif !defined(MPC_MAX) || !WITHIN(MPC_MAX, 1, 255)
+    #error "MPC_MAX must be set from 1 to 255."
+  #elif !defined(MPC_SMOOTHING_FACTOR) || !defined(MPC_MIN_AMBIENT_CHANGE) || !defined(MPC_STEADYSTATE)
+    #error "MPCTEMP requires MPC_SMOOTHING_FACTOR, MPC_MIN_AMBIENT_CHANGE, and MPC_STEADYSTATE."
+  #elif ENABLED(MPC_INCLUDE_FAN)
+    #if !HAS_FAN
+      #error "MPC_INCLUDE_FAN requires at least one fan."
+    #elif !defined(MPC_AMBIENT_XFER_COEFF_FAN255)
+      #error "MPC_INCLUDE_FAN requires MPC_AMBIENT_XFER_COEFF_FAN255."
+    #elif FAN_COUNT < HOTENDS && DISABLED(MPC_FAN_0_ACTIVE_HOTEND)
+      #error "MPC_INCLUDE_FAN requires a fan for each hotend, or MPC_FAN_0_ACTIVE_HOTEND."
+    #endif
+  #endif
+#endif
+
 /**
  * Bed Heating Options - PID vs Limit Switching
  */
@@ -1958,6 +2073,32 @@ static_assert(Y_MAX_LENGTH >= Y_BED_SIZE, "Movement bounds (Y_MIN_POS, Y_MAX_POS
   #error "TEMP_SENSOR_REDUNDANT 1000 requires REDUNDANT_PULLUP_RESISTOR_OHMS, REDUNDANT_RESISTANCE_25C_OHMS and REDUNDANT_BETA in Configuration_adv.h."
 #endif
 
+#if HAS_USER_THERMISTORS && defined(USER_THERMISTOR_TABLE_STEP) && !WITHIN(USER_THERMISTOR_TABLE_STEP, 2, 50)
+  #error "USER_THERMISTOR_TABLE_STEP must be between 2 and 50."
+#endif
+
+/**
+ * Thermistor Direct Index builds its tables with C++14 constexpr functions
+ */
+#if ENABLED(THERMISTOR_DIRECT_INDEX) && __cplusplus < 201402L
+  #error "THERMISTOR_DIRECT_INDEX requires C++14 or newer (e.g., -std=gnu++14). AVR builds use C++11."
+#endif
+
+/**
+ * ADC scan mode requirements
+ */
+#if ENABLED(ADC_SCAN_MODE)
+  #ifndef HAL_ADC_SCAN
+    #error "ADC_SCAN_MODE is not supported on the selected MOTHERBOARD."
+  #elif !WITHIN(ADC_SCAN_OVERSAMPLE, 1, 16) || (ADC_SCAN_OVERSAMPLE & (ADC_SCAN_OVERSAMPLE - 1))
+    #error "ADC_SCAN_OVERSAMPLE must be 1, 2, 4, 8, or 16."
+  #elif !WITHIN(ADC_SCAN_INTERVAL, 1, 255)
+    #error "ADC_SCAN_INTERVAL must be between 1 and 255."
+  #elif !WITHIN(ADC_SCAN_IIR_SHIFT, 0, 8)
+    #error "ADC_SCAN_IIR_SHIFT must be between 0 and 8."
+  #endif
+#endif
+
 /**
  * Pins and Sensor IDs must be set for each heater
  */
@@ -3265,8 +3406,44 @@ static_assert(   _ARR_TEST(3,0) && _ARR_TEST(3,1) && _ARR_TEST(3,2)
 
 #if !BLOCK_BUFFER_SIZE || !IS_POWER_OF_2(BLOCK_BUFFER_SIZE)
   #error "BLOCK_BUFFER_SIZE must be a power of 2."
-#elif BLOCK_BUFFER_SIZE > 64
+#elif BLOCK_BUFFER_SIZE > 64 && !defined(CPU_32_BIT)
   #error "A very large BLOCK_BUFFER_SIZE is not needed and takes longer to drain the buffer on pause / cancel."
+#elif BLOCK_BUFFER_SIZE > 1024
+  #error "BLOCK_BUFFER_SIZE must be 1024 or less."
+#endif
+
+#if MAX_QUEUED_COMMANDS < BUFSIZE
+  #error "MAX_QUEUED_COMMANDS must be at least BUFSIZE."
+#elif MAX_QUEUED_COMMANDS > 255
+  #error "MAX_QUEUED_COMMANDS must be 255 or less."
+#elif BUFSIZE * MAX_CMD_SIZE > 32767
+  #error "BUFSIZE * MAX_CMD_SIZE must be 32767 or less."
+#endif
+
+#if ENABLED(PARSE_AT_ENQUEUE)
+  #if DISABLED(FASTER_GCODE_PARSER)
+    #error "PARSE_AT_ENQUEUE requires FASTER_GCODE_PARSER."
+  #elif ENABLED(GCODE_MOTION_MODES)
+    #error "PARSE_AT_ENQUEUE is incompatible with GCODE_MOTION_MODES."
+  #elif ENABLED(GCODE_QUOTED_STRINGS)
+    #error "PARSE_AT_ENQUEUE is incompatible with GCODE_QUOTED_STRINGS."
+  #elif MAX_CMD_SIZE > 255
+    #error "PARSE_AT_ENQUEUE requires a MAX_CMD_SIZE of 255 or less."
+  #endif
+#endif
+
+#if ENABLED(G0_G1_FAST_PATH)
+  #if DISABLED(PARSE_AT_ENQUEUE)
+    #error "G0_G1_FAST_PATH requires PARSE_AT_ENQUEUE."
+  #elif IS_KINEMATIC
+    #error "G0_G1_FAST_PATH is only for Cartesian machines."
+  #elif ANY(DUAL_X_CARRIAGE, NANODLP_Z_SYNC, LASER_MOVE_POWER) || BOTH(MIXING_EXTRUDER, DIRECT_MIXING_IN_G1)
+    #error "G0_G1_FAST_PATH is incompatible with DUAL_X_CARRIAGE, NANODLP_Z_SYNC, LASER_MOVE_POWER, and DIRECT_MIXING_IN_G1."
+  #endif
+#endif
+
+#if ENABLED(PLANNER_BENCHMARK) && !defined(__PLAT_LINUX__)
+  #error "PLANNER_BENCHMARK is only for the LINUX HAL (linux_native_benchmark)."
 #endif
 
 #if ENABLED(LED_CONTROL_MENU) && !IS_ULTIPANEL
@@ -3612,6 +3789,23 @@ static_assert(   _ARR_TEST(3,0) && _ARR_TEST(3,1) && _ARR_TEST(3,2)
 #if BOTH(HAS_MEATPACK, BINARY_FILE_TRANSFER)
   #error "Either enable MEATPACK_ON_SERIAL_PORT_* or BINARY_FILE_TRANSFER, not both."
 #endif
+#if ENABLED(MEATPACK_SD_FILES) && DISABLED(SDSUPPORT)
+  #error "MEATPACK_SD_FILES requires SDSUPPORT."
+#elif ENABLED(MEATPACK_V2) && !HAS_MEATPACK && DISABLED(MEATPACK_SD_FILES)
+  #error "MEATPACK_V2 requires MEATPACK_ON_SERIAL_PORT_* or MEATPACK_SD_FILES."
+#elif ENABLED(MEATPACK_V2) && !WITHIN(MEATPACK_TOKEN_SIZE, 5, 16)
+  #error "MEATPACK_TOKEN_SIZE must be from 5 to 16."
+#endif
+
+#if ENABLED(BINARY_FILE_TRANSFER)
+  #if !WITHIN(BINARY_STREAM_WINDOW, 1, 16) || (BINARY_STREAM_WINDOW & (BINARY_STREAM_WINDOW - 1))
+    #error "BINARY_STREAM_WINDOW must be 1, 2, 4, 8, or 16."
+  #elif BINARY_STREAM_PACKET_SIZE < 64
+    #error "BINARY_STREAM_PACKET_SIZE must be at least 64."
+  #elif ENABLED(BINARY_STREAM_PRINT) && (!WITHIN(BINARY_STREAM_PRINT_BUFFER, 512, 16384) || (BINARY_STREAM_PRINT_BUFFER & (BINARY_STREAM_PRINT_BUFFER - 1)))
+    #error "BINARY_STREAM_PRINT_BUFFER must be a power of 2 from 512 to 16384."
+  #endif
+#endif
 
 /**
  * Sanity Check for Slim LCD Menus and Probe Offset Wizard
@@ -107,6 +107,10 @@
   #include "../feature/powerloss.h"
 #endif
 
+#if ENABLED(PATH_BLENDING)
+  #include "../feature/path_blending.h"
+#endif
+
 #if HAS_CUTTER
   #include "../feature/spindle_laser.h"
 #endif
@@ -123,10 +127,10 @@ Planner planner;
  * A ring buffer of moves described in steps
  */
 block_t Planner::block_buffer[BLOCK_BUFFER_SIZE];
-volatile uint8_t Planner::block_buffer_head,    // Index of the next block to be pushed
-                 Planner::block_buffer_nonbusy, // Index of the first non-busy block
-                 Planner::block_buffer_planned, // Index of the optimally planned block
-                 Planner::block_buffer_tail;    // Index of the busy block, if any
+volatile block_index_t Planner::block_buffer_head,    // Index of the next block to be pushed
+                       Planner::block_buffer_nonbusy, // Index of the first non-busy block
+                       Planner::block_buffer_planned, // Index of the optimally planned block
+                       Planner::block_buffer_tail;    // Index of the busy block, if any
 uint16_t Planner::cleaning_buffer_counter;      // A counter to disable queuing of blocks
 uint8_t Planner::delay_before_delivering;       // This counter delays delivery of blocks when queue becomes empty to allow the opportunity of merging blocks
 
@@ -725,7 +729,7 @@ void Planner::init() {
  */
 block_t* Planner::get_current_block() {
   // Get the number of moves in the planner queue so far
-  const uint8_t nr_moves = movesplanned();
+  const block_index_t nr_moves = movesplanned();
 
   // If there are any moves queued ...
   if (nr_moves) {
@@ -749,7 +753,10 @@ block_t* Planner::get_current_block() {
     TERN_(HAS_WIRED_LCD, block_buffer_runtime_us -= block->segment_time_us);
 
     // As this block is busy, advance the nonbusy block pointer
-    block_buffer_nonbusy = next_block_index(block_buffer_tail);
+    #if ENABLED(STEP_SEGMENT_BUFFER)
+      if (block_buffer_nonbusy == block_buffer_tail) // ...unless it was claimed for segment preparation
+    #endif
+        block_buffer_nonbusy = next_block_index(block_buffer_tail);
 
     // Push block_buffer_planned pointer, if encountered.
     if (block_buffer_tail == block_buffer_planned)
@@ -765,6 +772,59 @@ block_t* Planner::get_current_block() {
   return nullptr;
 }
 
+#if ENABLED(MPCTEMP)
+
+  float Planner::get_current_e_speed() {
+    // The Stepper moves the non-busy index past the block it takes
+    const block_index_t tail = block_buffer_tail;
+    if (tail == block_buffer_head || tail == block_buffer_nonbusy) return 0;
+
+    const block_t * const block = &block_buffer[tail];
+    if (TEST(block->flag, BLOCK_BIT_SYNC_POSITION) || IS_PAGE(block)) return 0;
+    #if ENABLED(LASER_SYNCHRONOUS_M106_M107)
+      if (TEST(block->flag, BLOCK_BIT_SYNC_FANS)) return 0;
+    #endif
+    if (!block->steps.e || TEST(block->direction_bits, E_AXIS)) return 0;
+
+    return block->steps.e * steps_to_mm[E_AXIS_N(block->extruder)] * SQRT(block->nominal_speed_sqr) / block->millimeters;
+  }
+
+#endif
+
+#if ENABLED(STEP_SEGMENT_BUFFER)
+
+  /**
+   * Get the next block for step segment preparation and mark it as busy,
+   * so its trapezoid is no longer altered. The newest block is left to the
+   * planner as the next move may still raise its exit speed.
+   * Return nullptr if no block is ready.
+   */
+  block_t* Planner::get_prep_block() {
+    // Let the first move wait for more moves, as the ISR does
+    if (delay_before_delivering) return nullptr;
+
+    const block_index_t index = block_buffer_nonbusy;
+    if (BLOCK_MOD(block_buffer_head - index) < 2) return nullptr;
+
+    block_t * const block = &block_buffer[index];
+
+    // Sync and page blocks are only for the ISR. Skip a block that's being recalculated.
+    if ((block->flag & BLOCK_MASK_SYNC) || IS_PAGE(block) || TEST(block->flag, BLOCK_BIT_RECALCULATE)) return nullptr;
+
+    // The ISR could take the block at any moment, so claim it in a critical section
+    const bool was_enabled = stepper.suspend();
+    const bool claimed = (index == block_buffer_nonbusy);
+    if (claimed) {
+      block_buffer_nonbusy = next_block_index(index);
+      if (block_buffer_planned == index) block_buffer_planned = block_buffer_nonbusy;
+    }
+    if (was_enabled) stepper.wake_up();
+
+    return claimed ? block : nullptr;
+  }
+
+#endif
+
 /**
  * Calculate trapezoid parameters, multiplying the entry- and exit-speeds
  * by the provided factors.
@@ -995,11 +1055,11 @@ void Planner::reverse_pass_kernel(block_t * const current, const block_t * const
  */
 void Planner::reverse_pass() {
   // Initialize block index to the last block in the planner buffer.
-  uint8_t block_index = prev_block_index(block_buffer_head);
+  block_index_t block_index = prev_block_index(block_buffer_head);
 
   // Read the index of the last buffer planned block.
   // The ISR may change it so get a stable local copy.
-  uint8_t planned_block_index = block_buffer_planned;
+  block_index_t planned_block_index = block_buffer_planned;
 
   // If there was a race condition and block_buffer_planned was incremented
   //  or was pointing at the head (queue empty) break loop now and avoid
@@ -1039,7 +1099,7 @@ void Planner::reverse_pass() {
 }
 
 // The kernel called by recalculate() when scanning the plan from first to last entry.
-void Planner::forward_pass_kernel(const block_t * const previous, block_t * const current, const uint8_t block_index) {
+void Planner::forward_pass_kernel(const block_t * const previous, block_t * const current, const block_index_t block_index) {
   if (previous) {
     // If the previous block is an acceleration block, too short to complete the full speed
     // change, adjust the entry speed accordingly. Entry speeds have already been reset,
@@ -1101,7 +1161,7 @@ void Planner::forward_pass() {
   //  by the stepper ISR,  so read it ONCE. It it guaranteed that block_buffer_planned
   //  will never lead head, so the loop is safe to execute. Also note that the forward
   //  pass will never modify the values at the tail.
-  uint8_t block_index = block_buffer_planned;
+  block_index_t block_index = block_buffer_planned;
 
   block_t *block;
   const block_t * previous = nullptr;
@@ -1130,18 +1190,28 @@ void Planner::forward_pass() {
  * Recalculate the trapezoid speed profiles for all blocks in the plan
  * according to the entry_factor for each junction. Must be called by
  * recalculate() after updating the blocks.
+ *
+ * Only blocks from the planned pointer onward may have changed during
+ * the passes, so start from the block before the given planned index.
+ * This keeps the work independent of the size of the buffer.
  */
-void Planner::recalculate_trapezoids() {
+void Planner::recalculate_trapezoids(const block_index_t planned_index) {
   // The tail may be changed by the ISR so get a local copy.
-  uint8_t block_index = block_buffer_tail,
-          head_block_index = block_buffer_head;
+  const block_index_t tail_index = block_buffer_tail;
+  block_index_t head_block_index = block_buffer_head,
+                block_index = planned_index == tail_index ? tail_index : prev_block_index(planned_index);
+
+  // If the ISR already consumed that block, start at the tail
+  if (BLOCK_MOD(block_index - tail_index) >= BLOCK_MOD(head_block_index - tail_index))
+    block_index = tail_index;
+
   // Since there could be a sync block in the head of the queue, and the
   // next loop must not recalculate the head block (as it needs to be
   // specially handled), scan backwards to the first non-SYNC block.
   while (head_block_index != block_index) {
 
     // Go back (head always point to the first free block)
-    const uint8_t prev_index = prev_block_index(head_block_index);
+    const block_index_t prev_index = prev_block_index(head_block_index);
 
     // Get the pointer to the block
     block_t *prev = &block_buffer[prev_index];
@@ -1238,14 +1308,18 @@ void Planner::recalculate_trapezoids() {
 }
 
 void Planner::recalculate() {
+  TERN_(PLANNER_BENCHMARK, BENCHMARK_SCOPE(recalculate));
+
+  // Blocks before the planned pointer are already optimal. Get a copy before the passes move it.
+  const block_index_t planned_index = block_buffer_planned;
   // Initialize block index to the last block in the planner buffer.
-  const uint8_t block_index = prev_block_index(block_buffer_head);
+  const block_index_t block_index = prev_block_index(block_buffer_head);
   // If there is just one block, no planning can be done. Avoid it!
-  if (block_index != block_buffer_planned) {
+  if (block_index != planned_index) {
     reverse_pass();
     forward_pass();
   }
-  recalculate_trapezoids();
+  recalculate_trapezoids(planned_index);
 }
 
 #if HAS_FAN && DISABLED(LASER_SYNCHRONOUS_M106_M107)
@@ -1343,7 +1417,7 @@ void Planner::check_axes_activity() {
     #endif
 
     #if ANY(DISABLE_X, DISABLE_Y, DISABLE_Z, DISABLE_I, DISABLE_J, DISABLE_K, DISABLE_E)
-      for (uint8_t b = block_buffer_tail; b != block_buffer_head; b = next_block_index(b)) {
+      for (block_index_t b = block_buffer_tail; b != block_buffer_head; b = next_block_index(b)) {
         block_t *block = &block_buffer[b];
         LOGICAL_AXIS_CODE(
           if (TERN0(DISABLE_E, block->steps.e)) axis_active.e = true,
@@ -1449,7 +1523,7 @@ void Planner::check_axes_activity() {
     if (thermalManager.degTargetHotend(active_extruder) < autotemp_min - 2) return; // Below the min?
 
     float high = 0.0;
-    for (uint8_t b = block_buffer_tail; b != block_buffer_head; b = next_block_index(b)) {
+    for (block_index_t b = block_buffer_tail; b != block_buffer_head; b = next_block_index(b)) {
       block_t *block = &block_buffer[b];
       if (LINEAR_AXIS_GANG(block->steps.x, || block->steps.y, || block->steps.z, || block->steps.i, || block->steps.j, || block->steps.k)) {
         const float se = (float)block->steps.e / block->step_event_count * SQRT(block->nominal_speed_sqr); // mm/sec;
@@ -1666,9 +1740,15 @@ void Planner::quick_stop() {
 
   const bool was_enabled = stepper.suspend();
 
+  // Drop the move held for blending
+  TERN_(PATH_BLENDING, blender.discard());
+
   // Drop all queue entries
   block_buffer_nonbusy = block_buffer_planned = block_buffer_head = block_buffer_tail;
 
+  // Drop all segments prepared from them
+  TERN_(STEP_SEGMENT_BUFFER, stepper.reset_segments());
+
   // Restart the block delay for the first movement - As the queue was
   // forced to empty, there's no risk the ISR will touch this.
   delay_before_delivering = BLOCK_DELAY_FOR_1ST_MOVE;
@@ -1716,6 +1796,7 @@ float Planner::triggered_position_mm(const AxisEnum axis) {
 }
 
 void Planner::finish_and_disable() {
+  TERN_(PLANNER_BENCHMARK, BENCHMARK_IDLE_SCOPE());
   while (has_blocks_queued() || cleaning_buffer_counter) idle();
   disable_all_steppers();
 }
@@ -1776,8 +1857,11 @@ float Planner::get_axis_position_mm(const AxisEnum axis) {
  * Block until all buffered steps are executed / cleaned
  */
 void Planner::synchronize() {
+  TERN_(PATH_BLENDING, blender.flush());
+  TERN_(PLANNER_BENCHMARK, BENCHMARK_IDLE_SCOPE());
   while (has_blocks_queued() || cleaning_buffer_counter
       || TERN0(EXTERNAL_CLOSED_LOOP_CONTROLLER, CLOSED_LOOP_WAITING())
+      || TERN0(HAS_SHAPING, stepper.shaping_busy())
   ) idle();
 }
 
@@ -1798,10 +1882,11 @@ bool Planner::_buffer_steps(const xyze_long_t &target
   OPTARG(HAS_POSITION_FLOAT, const xyze_pos_t &target_float)
   OPTARG(HAS_DIST_MM_ARG, const xyze_float_t &cart_dist_mm)
   , feedRate_t fr_mm_s, const uint8_t extruder, const_float_t millimeters
+  OPTARG(ARC_BLOCKS, const arc_plan_t * const arc)
 ) {
 
   // Wait for the next available block
-  uint8_t next_buffer_head;
+  block_index_t next_buffer_head;
   block_t * const block = get_next_free_block(next_buffer_head);
 
   // If we are cleaning, do not accept queuing of movements
@@ -1818,6 +1903,7 @@ bool Planner::_buffer_steps(const xyze_long_t &target
       , cart_dist_mm
     #endif
     , fr_mm_s, extruder, millimeters
+    OPTARG(ARC_BLOCKS, arc)
   )) {
     // Movement was not queued, probably because it was too short.
     //  Simply accept that as movement queued and done
@@ -1852,6 +1938,7 @@ bool Planner::_buffer_steps(const xyze_long_t &target
  *  target      - target position in steps units
  *  fr_mm_s     - (target) speed of the move
  *  extruder    - target extruder
+ *  arc         - arc geometry, to trace an arc instead of a line
  *
  * Returns true if movement is acceptable, false otherwise
  */
@@ -1860,7 +1947,10 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
   OPTARG(HAS_POSITION_FLOAT, const xyze_pos_t &target_float)
   OPTARG(HAS_DIST_MM_ARG, const xyze_float_t &cart_dist_mm)
   , feedRate_t fr_mm_s, const uint8_t extruder, const_float_t millimeters/*=0.0*/
+  OPTARG(ARC_BLOCKS, const arc_plan_t * const arc/*=nullptr*/)
 ) {
+  TERN_(PLANNER_BENCHMARK, BENCHMARK_SCOPE(populate));
+
   int32_t LOGICAL_AXIS_LIST(
     de = target.e - position.e,
     da = target.a - position.a,
@@ -1994,6 +2084,37 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
     block->steps.set(LINEAR_AXIS_LIST(ABS(da), ABS(db), ABS(dc), ABS(di), ABS(dj), ABS(dk)));
   #endif
 
+  #if ENABLED(ARC_BLOCKS)
+    if (arc) {
+      // Spread the step events evenly along the arc. Each chord needs at least as
+      // many events as the steps taken by any axis over the chord, allowing for
+      // rounding. Only the last chord has to make up for a target off the arc.
+      // The planar axes may move at the full rate. Their directions are set by
+      // the stepper chord by chord.
+      const uint16_t chords = arc->chords;
+      const xy_float_t spm = { settings.axis_steps_per_mm[arc->p], settings.axis_steps_per_mm[arc->q] };
+      uint32_t chord_events = uint32_t(CEIL(arc->chord_mm * _MAX(spm.x, spm.y))) + 2;
+      LOOP_LINEAR_AXES(i) if (i != arc->p && i != arc->q) NOLESS(chord_events, (block->steps[i] + chords - 1) / chords);
+      NOLESS(chord_events, (esteps + chords - 1) / chords);
+      block->steps[arc->p] = block->steps[arc->q] = chord_events * chords + arc->end_error;
+
+      block_arc_t &ba = block->arc;
+      ba.p = arc->p;
+      ba.q = arc->q;
+      ba.chords = chords;
+      ba.chord_events = chord_events;
+      ba.end_events = arc->end_error;
+      ba.theta = arc->theta;
+      ba.cos_T = arc->cos_T;
+      ba.sin_T = arc->sin_T;
+      ba.rvec = arc->rvec;
+      ba.center.set(position[arc->p] - arc->rvec.x * spm.x, position[arc->q] - arc->rvec.y * spm.y);
+      ba.steps_per_mm = spm;
+      ba.end.set(target[arc->p], target[arc->q]);
+      block->flag |= BLOCK_FLAG_ARC;
+    }
+  #endif
+
   /**
    * This part of the code calculates the total length of the movement.
    * For cartesian bots, the X_AXIS is the real X movement and same for Y_AXIS.
@@ -2048,6 +2169,13 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
     steps_dist_mm.e = esteps_float * steps_to_mm[E_AXIS_N(extruder)];
   #endif
 
+  #if ENABLED(ARC_BLOCKS)
+    if (arc) { // An arc starts out along its tangent
+      steps_dist_mm[arc->p] = arc->start_dir.x * arc->flat_mm;
+      steps_dist_mm[arc->q] = arc->start_dir.y * arc->flat_mm;
+    }
+  #endif
+
   TERN_(LCD_SHOW_E_TOTAL, e_move_accumulator += steps_dist_mm.e);
 
   if (true LINEAR_AXIS_GANG(
@@ -2226,7 +2354,7 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
   float inverse_secs = fr_mm_s * inverse_millimeters;
 
   // Get the number of non busy movements in queue (non busy means that they can be altered)
-  const uint8_t moves_queued = nonbusy_movesplanned();
+  const block_index_t moves_queued = nonbusy_movesplanned();
 
   // Slow down when the buffer starts to empty, rather than wait at the corner for a buffer refill
   #if EITHER(SLOWDOWN, HAS_WIRED_LCD) || defined(XY_FREQUENCY_LIMIT)
@@ -2282,6 +2410,21 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
     if (cs > max_fr) NOMORE(speed_factor, max_fr / cs);
   }
 
+  #if ENABLED(ARC_BLOCKS)
+    if (arc) {
+      // Either planar axis may carry the full speed somewhere along the arc
+      const feedRate_t cs = arc->flat_mm * inverse_secs,
+                   max_fr = _MIN(settings.max_feedrate_mm_s[arc->p], settings.max_feedrate_mm_s[arc->q]);
+      if (cs > max_fr) NOMORE(speed_factor, max_fr / cs);
+
+      // Keep the centripetal acceleration (v^2 / r) within the acceleration limits
+      const float max_accel = _MIN(esteps ? settings.acceleration : settings.travel_acceleration,
+                                   settings.max_acceleration_mm_per_s2[arc->p], settings.max_acceleration_mm_per_s2[arc->q]),
+                  max_cs_sqr = max_accel * arc->radius;
+      if (sq(cs) > max_cs_sqr) NOMORE(speed_factor, SQRT(max_cs_sqr) / cs);
+    }
+  #endif
+
   // Limit speed on extruders, if any
   #if HAS_EXTRUDERS
     {
@@ -2410,9 +2553,10 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
           #if IS_KINEMATIC
             block->millimeters
           #else
-            SQRT(sq(target_float.x - position_float.x)
-               + sq(target_float.y - position_float.y)
-               + sq(target_float.z - position_float.z))
+            (TERN_(ARC_BLOCKS, arc ? block->millimeters :)
+              SQRT(sq(target_float.x - position_float.x)
+                 + sq(target_float.y - position_float.y)
+                 + sq(target_float.z - position_float.z)))
           #endif
         ;
 
@@ -2657,6 +2801,14 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
 
     prev_unit_vec = unit_vec;
 
+    #if ENABLED(ARC_BLOCKS)
+      if (arc) { // The next block joins the arc at its exit tangent
+        const float m = HYPOT(unit_vec[arc->p], unit_vec[arc->q]);
+        prev_unit_vec[arc->p] = arc->end_dir.x * m;
+        prev_unit_vec[arc->q] = arc->end_dir.y * m;
+      }
+    #endif
+
   #endif
 
   #ifdef USE_CACHED_SQRT
@@ -2792,6 +2944,14 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
   previous_speed = current_speed;
   previous_nominal_speed_sqr = block->nominal_speed_sqr;
 
+  #if ENABLED(ARC_BLOCKS)
+    if (arc) { // Leave the arc along its exit tangent
+      const float v = HYPOT(current_speed[arc->p], current_speed[arc->q]);
+      previous_speed[arc->p] = arc->end_dir.x * v;
+      previous_speed[arc->q] = arc->end_dir.y * v;
+    }
+  #endif
+
   position = target;  // Update the position
 
   TERN_(HAS_POSITION_FLOAT, position_float = target_float);
@@ -2812,8 +2972,10 @@ void Planner::buffer_sync_block(TERN_(LASER_SYNCHRONOUS_M106_M107, uint8_t sync_
     constexpr uint8_t sync_flag = BLOCK_FLAG_SYNC_POSITION;
   #endif
 
+  TERN_(PATH_BLENDING, blender.flush());
+
   // Wait for the next available block
-  uint8_t next_buffer_head;
+  block_index_t next_buffer_head;
   block_t * const block = get_next_free_block(next_buffer_head);
 
   // Clear block
@@ -2859,11 +3021,15 @@ void Planner::buffer_sync_block(TERN_(LASER_SYNCHRONOUS_M106_M107, uint8_t sync_
 bool Planner::buffer_segment(const abce_pos_t &abce
   OPTARG(HAS_DIST_MM_ARG, const xyze_float_t &cart_dist_mm)
   , const_feedRate_t fr_mm_s, const uint8_t extruder/*=active_extruder*/, const_float_t millimeters/*=0.0*/
+  OPTARG(ARC_BLOCKS, const arc_plan_t * const arc/*=nullptr*/)
 ) {
 
   // If we are cleaning, do not accept queuing of movements
   if (cleaning_buffer_counter) return false;
 
+  // Queue a held move ahead of this one
+  TERN_(PATH_BLENDING, blender.flush());
+
   // When changing extruders recalculate steps corresponding to the E position
   #if ENABLED(DISTINCT_E_FACTORS)
     if (last_extruder != extruder && settings.axis_steps_per_mm[E_AXIS_N(extruder)] != settings.axis_steps_per_mm[E_AXIS_N(last_extruder)]) {
@@ -2950,7 +3116,8 @@ bool Planner::buffer_segment(const abce_pos_t &abce
       #if HAS_DIST_MM_ARG
         , cart_dist_mm
       #endif
-      , fr_mm_s, extruder, millimeters)
+      , fr_mm_s, extruder, millimeters
+      OPTARG(ARC_BLOCKS, arc))
   ) return false;
 
   stepper.wake_up();
@@ -3010,10 +3177,71 @@ bool Planner::buffer_line(const xyze_pos_t &cart, const_feedRate_t fr_mm_s, cons
     }
     return false;
   #else
+    // Hold the move to merge it with the next one
+    if (TERN0(PATH_BLENDING, !millimeters && blender.add(machine, fr_mm_s, extruder))) return true;
     return buffer_segment(machine, fr_mm_s, extruder, millimeters);
   #endif
 } // buffer_line()
 
+#if ENABLED(ARC_BLOCKS)
+
+  /**
+   * Add an arc to the buffer as a single block, traced by the stepper.
+   *
+   *  cart           - target position in mm
+   *  p, q           - the axes of the arc plane
+   *  rvec           - radius vector from the arc center to the current position
+   *  angular_travel - (radians) rotation around the center. Positive is counter-clockwise.
+   *  fr_mm_s        - (target) speed of the move (mm/s)
+   *  extruder       - target extruder
+   *  millimeters    - the length of the movement along the arc
+   */
+  bool Planner::buffer_arc(const xyze_pos_t &cart, const AxisEnum p, const AxisEnum q, const xy_float_t &rvec,
+    const_float_t angular_travel, const_feedRate_t fr_mm_s, const uint8_t extruder, const_float_t millimeters
+  ) {
+    TERN_(PATH_BLENDING, blender.flush()); // The arc starts at the planner position
+
+    arc_plan_t arc;
+    arc.p = p;
+    arc.q = q;
+    arc.rvec = rvec;
+    arc.radius = rvec.magnitude();
+
+    // Use chords short enough to stay within half a step of the true arc.
+    // The sagitta of a chord is r * (1 - cos(theta / 2)), about r * theta^2 / 8.
+    // Beyond 1024 chords the error from the arc is far below one step anyway.
+    const float abs_angular_travel = ABS(angular_travel),
+                max_theta = SQRT(4.0f * _MIN(steps_to_mm[p], steps_to_mm[q]) / arc.radius),
+                chords = CEIL(abs_angular_travel / max_theta);
+    arc.chords = constrain(chords, 1, 1024);
+
+    arc.theta = angular_travel / arc.chords;
+    arc.cos_T = cos(arc.theta);
+    arc.sin_T = sin(arc.theta);
+    arc.chord_mm = 2.0f * arc.radius * sin(0.5f * ABS(arc.theta));
+    arc.flat_mm = arc.radius * abs_angular_travel;
+
+    // Unit tangents in the direction of travel, at both ends of the arc
+    const float cos_A = cos(angular_travel), sin_A = sin(angular_travel),
+                dir = (angular_travel < 0 ? -1.0f : 1.0f) / arc.radius;
+    const xy_float_t end_rvec = { rvec.x * cos_A - rvec.y * sin_A, rvec.x * sin_A + rvec.y * cos_A };
+    arc.start_dir.set(-rvec.y * dir, rvec.x * dir);
+    arc.end_dir.set(-end_rvec.y * dir, end_rvec.x * dir);
+
+    xyze_pos_t machine = cart;
+    TERN_(HAS_POSITION_MODIFIERS, apply_modifiers(machine));
+
+    // The last chord ends on the target, even if it strays from the arc
+    const xy_float_t spm = { settings.axis_steps_per_mm[p], settings.axis_steps_per_mm[q] };
+    const float end_p = position[p] + (end_rvec.x - rvec.x) * spm.x,
+                end_q = position[q] + (end_rvec.y - rvec.y) * spm.y;
+    arc.end_error = CEIL(_MAX(ABS(machine[p] * spm.x - end_p), ABS(machine[q] * spm.y - end_q)));
+
+    return buffer_segment(machine, fr_mm_s, extruder, millimeters, &arc);
+  }
+
+#endif // ARC_BLOCKS
+
 #if ENABLED(DIRECT_STEPPING)
 
   void Planner::buffer_page(const page_idx_t page_idx, const uint8_t extruder, const uint16_t num_steps) {
@@ -3022,7 +3250,9 @@ bool Planner::buffer_line(const xyze_pos_t &cart, const_feedRate_t fr_mm_s, cons
       return;
     }
 
-    uint8_t next_buffer_head;
+    TERN_(PATH_BLENDING, blender.flush());
+
+    block_index_t next_buffer_head;
     block_t * const block = get_next_free_block(next_buffer_head);
 
     block->flag = BLOCK_FLAG_IS_PAGE;
@@ -3080,6 +3310,7 @@ bool Planner::buffer_line(const xyze_pos_t &cart, const_feedRate_t fr_mm_s, cons
  * The provided ABCE position is in machine units.
  */
 void Planner::set_machine_position_mm(const abce_pos_t &abce) {
+  TERN_(PATH_BLENDING, blender.flush());
   TERN_(DISTINCT_E_FACTORS, last_extruder = active_extruder);
   TERN_(HAS_POSITION_FLOAT, position_float = abce);
   position.set(
@@ -3121,6 +3352,7 @@ void Planner::set_position_mm(const xyze_pos_t &xyze) {
    * Setters for planner position (also setting stepper position).
    */
   void Planner::set_e_position_mm(const_float_t e) {
+    TERN_(PATH_BLENDING, blender.flush());
     const uint8_t axis_index = E_AXIS_N(active_extruder);
     TERN_(DISTINCT_E_FACTORS, last_extruder = active_extruder);
 
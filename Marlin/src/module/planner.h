@@ -109,6 +109,11 @@ enum BlockFlagBit : char {
   #if ENABLED(LASER_SYNCHRONOUS_M106_M107)
     , BLOCK_BIT_SYNC_FANS
   #endif
+
+  // The block is an arc traced by the stepper
+  #if ENABLED(ARC_BLOCKS)
+    , BLOCK_BIT_ARC
+  #endif
 };
 
 enum BlockFlag : char {
@@ -122,10 +127,19 @@ enum BlockFlag : char {
   #if ENABLED(LASER_SYNCHRONOUS_M106_M107)
     , BLOCK_FLAG_SYNC_FANS          = _BV(BLOCK_BIT_SYNC_FANS)
   #endif
+  #if ENABLED(ARC_BLOCKS)
+    , BLOCK_FLAG_ARC                = _BV(BLOCK_BIT_ARC)
+  #endif
 };
 
 #define BLOCK_MASK_SYNC ( BLOCK_FLAG_SYNC_POSITION | TERN0(LASER_SYNCHRONOUS_M106_M107, BLOCK_FLAG_SYNC_FANS) )
 
+#if ENABLED(ARC_BLOCKS)
+  #define IS_ARC(B) TEST(B->flag, BLOCK_BIT_ARC)
+#else
+  #define IS_ARC(B) false
+#endif
+
 #if ENABLED(LASER_POWER_INLINE)
 
   typedef struct {
@@ -150,6 +164,43 @@ enum BlockFlag : char {
 
 #endif
 
+#if ENABLED(ARC_BLOCKS)
+
+  /**
+   * An arc is traced by the stepper as a series of equal-angle chords.
+   * Each chord gets the same number of step events, so the speed along
+   * the arc follows the block's trapezoid like any straight move. The
+   * last chord gets extra events to reach a target that is off the arc.
+   */
+  typedef struct {
+    AxisEnum p, q;                          // The axes of the arc plane
+    uint16_t chords;                        // Number of chords in the arc
+    uint32_t chord_events,                  // Step events per chord
+             end_events;                    // Extra step events for the last chord
+    float theta,                            // (radians) Rotation for each chord
+          cos_T, sin_T;                     // Rotation matrix for each chord
+    xy_float_t rvec,                        // (mm) Radius vector from the center to the start
+               center,                      // (steps) Center of the arc on the P and Q axes
+               steps_per_mm;                // Steps-per-mm of the P and Q axes
+    xy_long_t end;                          // (steps) Final P and Q position
+  } block_arc_t;
+
+  // The planner's view of an arc, prepared by Planner::buffer_arc
+  typedef struct {
+    AxisEnum p, q;                          // The axes of the arc plane
+    uint16_t chords;                        // Number of chords in the arc
+    uint32_t end_error;                     // (steps) Distance from the arc to the target
+    float theta,                            // (radians) Rotation for each chord
+          cos_T, sin_T,                     // Rotation matrix for each chord
+          radius,                           // (mm) Radius of the arc
+          chord_mm,                         // (mm) Length of each chord in the arc plane
+          flat_mm;                          // (mm) Length of the arc in the arc plane
+    xy_float_t rvec,                        // (mm) Radius vector from the center to the start
+               start_dir, end_dir;          // Unit tangents at the start and end of the arc
+  } arc_plan_t;
+
+#endif
+
 /**
  * struct block_t
  *
@@ -244,6 +295,10 @@ typedef struct block_t {
     block_laser_t laser;
   #endif
 
+  #if ENABLED(ARC_BLOCKS)
+    block_arc_t arc;                        // Arc geometry, if this is an arc block
+  #endif
+
 } block_t;
 
 #if ANY(LIN_ADVANCE, SCARA_FEEDRATE_SCALING, GRADIENT_MIX, LCD_SHOW_E_TOTAL)
@@ -252,6 +307,9 @@ typedef struct block_t {
 
 #define BLOCK_MOD(n) ((n)&(BLOCK_BUFFER_SIZE-1))
 
+// Ring buffer indexes and counts. Wider for the large buffers of 32-bit boards.
+typedef IF<(BLOCK_BUFFER_SIZE > 128), uint16_t, uint8_t>::type block_index_t;
+
 #if ENABLED(LASER_POWER_INLINE)
   typedef struct {
     /**
@@ -331,10 +389,10 @@ class Planner {
      *  Reader of tail is Stepper::isr(). Always consider tail busy / read-only
      */
     static block_t block_buffer[BLOCK_BUFFER_SIZE];
-    static volatile uint8_t block_buffer_head,      // Index of the next block to be pushed
-                            block_buffer_nonbusy,   // Index of the first non busy block
-                            block_buffer_planned,   // Index of the optimally planned block
-                            block_buffer_tail;      // Index of the busy block, if any
+    static volatile block_index_t block_buffer_head,    // Index of the next block to be pushed
+                                  block_buffer_nonbusy, // Index of the first non busy block
+                                  block_buffer_planned, // Index of the optimally planned block
+                                  block_buffer_tail;    // Index of the busy block, if any
     static uint16_t cleaning_buffer_counter;        // A counter to disable queuing of blocks
     static uint8_t delay_before_delivering;         // This counter delays delivery of blocks when queue becomes empty to allow the opportunity of merging blocks
 
@@ -678,10 +736,10 @@ class Planner {
     #endif // HAS_POSITION_MODIFIERS
 
     // Number of moves currently in the planner including the busy block, if any
-    FORCE_INLINE static uint8_t movesplanned() { return BLOCK_MOD(block_buffer_head - block_buffer_tail); }
+    FORCE_INLINE static block_index_t movesplanned() { return BLOCK_MOD(block_buffer_head - block_buffer_tail); }
 
     // Number of nonbusy moves currently in the planner
-    FORCE_INLINE static uint8_t nonbusy_movesplanned() { return BLOCK_MOD(block_buffer_head - block_buffer_nonbusy); }
+    FORCE_INLINE static block_index_t nonbusy_movesplanned() { return BLOCK_MOD(block_buffer_head - block_buffer_nonbusy); }
 
     // Remove all blocks from the buffer
     FORCE_INLINE static void clear_block_buffer() { block_buffer_nonbusy = block_buffer_planned = block_buffer_head = block_buffer_tail = 0; }
@@ -690,7 +748,7 @@ class Planner {
     FORCE_INLINE static bool is_full() { return block_buffer_tail == next_block_index(block_buffer_head); }
 
     // Get count of movement slots free
-    FORCE_INLINE static uint8_t moves_free() { return BLOCK_BUFFER_SIZE - 1 - movesplanned(); }
+    FORCE_INLINE static block_index_t moves_free() { return BLOCK_BUFFER_SIZE - 1 - movesplanned(); }
 
     /**
      * Planner::get_next_free_block
@@ -699,10 +757,17 @@ class Planner {
      * - Wait for the number of spaces to open up in the planner
      * - Return the first head block
      */
-    FORCE_INLINE static block_t* get_next_free_block(uint8_t &next_buffer_head, const uint8_t count=1) {
+    FORCE_INLINE static block_t* get_next_free_block(block_index_t &next_buffer_head, const block_index_t count=1) {
 
       // Wait until there are enough slots free
-      while (moves_free() < count) { idle(); }
+      #if ENABLED(PLANNER_BENCHMARK)
+        if (moves_free() < count) {
+          BENCHMARK_IDLE_SCOPE(); // Time the whole wait, not each idle()
+          while (moves_free() < count) { idle(); }
+        }
+      #else
+        while (moves_free() < count) { idle(); }
+      #endif
 
       // Return the first available block
       next_buffer_head = next_block_index(block_buffer_head);
@@ -725,6 +790,7 @@ class Planner {
       OPTARG(HAS_POSITION_FLOAT, const xyze_pos_t &target_float)
       OPTARG(HAS_DIST_MM_ARG, const xyze_float_t &cart_dist_mm)
       , feedRate_t fr_mm_s, const uint8_t extruder, const_float_t millimeters=0.0
+      OPTARG(ARC_BLOCKS, const arc_plan_t * const arc=nullptr)
     );
 
     /**
@@ -736,6 +802,7 @@ class Planner {
      *  fr_mm_s     - (target) speed of the move
      *  extruder    - target extruder
      *  millimeters - the length of the movement, if known
+     *  arc         - arc geometry, to trace an arc instead of a line
      *
      * Returns true is movement is acceptable, false otherwise
      */
@@ -743,6 +810,7 @@ class Planner {
       OPTARG(HAS_POSITION_FLOAT, const xyze_pos_t &target_float)
       OPTARG(HAS_DIST_MM_ARG, const xyze_float_t &cart_dist_mm)
       , feedRate_t fr_mm_s, const uint8_t extruder, const_float_t millimeters=0.0
+      OPTARG(ARC_BLOCKS, const arc_plan_t * const arc=nullptr)
     );
 
     /**
@@ -776,6 +844,7 @@ class Planner {
     static bool buffer_segment(const abce_pos_t &abce
       OPTARG(HAS_DIST_MM_ARG, const xyze_float_t &cart_dist_mm)
       , const_feedRate_t fr_mm_s, const uint8_t extruder=active_extruder, const_float_t millimeters=0.0
+      OPTARG(ARC_BLOCKS, const arc_plan_t * const arc=nullptr)
     );
 
   public:
@@ -795,6 +864,24 @@ class Planner {
       OPTARG(SCARA_FEEDRATE_SCALING, const_float_t inv_duration=0.0)
     );
 
+    #if ENABLED(ARC_BLOCKS)
+      /**
+       * Add an arc to the buffer as a single block, traced by the stepper.
+       * The target is cartesian. The last chord ends exactly on it.
+       *
+       *  cart           - target position in mm
+       *  p, q           - the axes of the arc plane
+       *  rvec           - radius vector from the arc center to the current position
+       *  angular_travel - (radians) rotation around the center. Positive is counter-clockwise.
+       *  fr_mm_s        - (target) speed of the move (mm/s)
+       *  extruder       - target extruder
+       *  millimeters    - the length of the movement along the arc
+       */
+      static bool buffer_arc(const xyze_pos_t &cart, const AxisEnum p, const AxisEnum q, const xy_float_t &rvec,
+        const_float_t angular_travel, const_feedRate_t fr_mm_s, const uint8_t extruder, const_float_t millimeters
+      );
+    #endif
+
     #if ENABLED(DIRECT_STEPPING)
       static void buffer_page(const page_idx_t page_idx, const uint8_t extruder, const uint16_t num_steps);
     #endif
@@ -888,6 +975,26 @@ class Planner {
      */
     static block_t* get_current_block();
 
+    #if ENABLED(STEP_SEGMENT_BUFFER)
+      /**
+       * Get the next block for step segment preparation
+       * and mark the block as busy, ahead of the Stepper ISR.
+       * Return nullptr if there's no block ready to claim.
+       *
+       * WARNING: Must not be called from ISR contexts!
+       */
+      static block_t* get_prep_block();
+    #endif
+
+    #if ENABLED(MPCTEMP)
+      /**
+       * The nominal E speed (mm/s) of the block being stepped.
+       * Zero if no block is busy or it doesn't extrude.
+       * Used to feed forward the heat taken by the filament.
+       */
+      static float get_current_e_speed();
+    #endif
+
     /**
      * "Release" the current block so its slot can be reused.
      * Called when the current block is no longer needed.
@@ -932,8 +1039,8 @@ class Planner {
     /**
      * Get the index of the next / previous block in the ring buffer
      */
-    static constexpr uint8_t next_block_index(const uint8_t block_index) { return BLOCK_MOD(block_index + 1); }
-    static constexpr uint8_t prev_block_index(const uint8_t block_index) { return BLOCK_MOD(block_index - 1); }
+    static constexpr block_index_t next_block_index(const block_index_t block_index) { return BLOCK_MOD(block_index + 1); }
+    static constexpr block_index_t prev_block_index(const block_index_t block_index) { return BLOCK_MOD(block_index - 1); }
 
     /**
      * Calculate the distance (not time) it takes to accelerate
@@ -978,12 +1085,12 @@ class Planner {
     static void calculate_trapezoid_for_block(block_t * const block, const_float_t entry_factor, const_float_t exit_factor);
 
     static void reverse_pass_kernel(block_t * const current, const block_t * const next);
-    static void forward_pass_kernel(const block_t * const previous, block_t * const current, uint8_t block_index);
+    static void forward_pass_kernel(const block_t * const previous, block_t * const current, const block_index_t block_index);
 
     static void reverse_pass();
     static void forward_pass();
 
-    static void recalculate_trapezoids();
+    static void recalculate_trapezoids(const block_index_t planned_index);
 
     static void recalculate();
 
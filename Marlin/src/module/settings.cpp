@@ -36,7 +36,7 @@
  */
 
 // Change EEPROM version if the structure changes
-#define EEPROM_VERSION "V83"
+#define EEPROM_VERSION "V85"
 #define EEPROM_OFFSET 100
 
 // Check the integrity of data offsets.
@@ -340,6 +340,13 @@ typedef struct SettingsDataStruct {
   //
   PID_t chamberPID;                                     // M309 PID / M303 E-2 U
 
+  //
+  // MPCTEMP
+  //
+  #if ENABLED(MPCTEMP)
+    MPC_t mpc_constants[HOTENDS];                       // M306 En P C R A F H / M306 T
+  #endif
+
   //
   // User-defined Thermistors
   //
@@ -398,6 +405,16 @@ typedef struct SettingsDataStruct {
   //
   float planner_extruder_advance_K[_MAX(EXTRUDERS, 1)]; // M900 K  planner.extruder_advance_K
 
+  //
+  // INPUT_SHAPING_X / INPUT_SHAPING_Y
+  //
+  #if ENABLED(INPUT_SHAPING_X)
+    shaping_params_t shaping_x;                         // M593 X F D T
+  #endif
+  #if ENABLED(INPUT_SHAPING_Y)
+    shaping_params_t shaping_y;                         // M593 Y F D T
+  #endif
+
   //
   // HAS_MOTOR_CURRENT_PWM
   //
@@ -987,6 +1004,16 @@ void MarlinSettings::postprocess() {
       EEPROM_WRITE(chamber_pid);
     }
 
+    //
+    // Model Predictive Control
+    //
+    #if ENABLED(MPCTEMP)
+    {
+      _FIELD_TEST(mpc_constants);
+      HOTEND_LOOP() EEPROM_WRITE(thermalManager.temp_hotend[e].constants);
+    }
+    #endif
+
     //
     // User-defined Thermistors
     //
@@ -1284,6 +1311,24 @@ void MarlinSettings::postprocess() {
       #endif
     }
 
+    //
+    // Input Shaping
+    //
+    #if ENABLED(INPUT_SHAPING_X)
+    {
+      _FIELD_TEST(shaping_x);
+      const shaping_params_t shaping_x = stepper.get_shaping_params(X_AXIS);
+      EEPROM_WRITE(shaping_x);
+    }
+    #endif
+    #if ENABLED(INPUT_SHAPING_Y)
+    {
+      _FIELD_TEST(shaping_y);
+      const shaping_params_t shaping_y = stepper.get_shaping_params(Y_AXIS);
+      EEPROM_WRITE(shaping_y);
+    }
+    #endif
+
     //
     // Motor Current PWM
     //
@@ -1855,6 +1900,20 @@ void MarlinSettings::postprocess() {
         #endif
       }
 
+      //
+      // Model Predictive Control
+      //
+      #if ENABLED(MPCTEMP)
+      {
+        _FIELD_TEST(mpc_constants);
+        HOTEND_LOOP() {
+          MPC_t mpc;
+          EEPROM_READ(mpc);
+          if (!validating) thermalManager.temp_hotend[e].constants = mpc;
+        }
+      }
+      #endif
+
       //
       // User-defined Thermistors
       //
@@ -1862,6 +1921,8 @@ void MarlinSettings::postprocess() {
       {
         _FIELD_TEST(user_thermistor);
         EEPROM_READ(thermalManager.user_thermistor);
+        // Update the derived values (and lookup tables) on the next reading
+        if (!validating) LOOP_L_N(i, USER_THERMISTORS) thermalManager.user_thermistor[i].pre_calc = true;
       }
       #endif
 
@@ -2154,6 +2215,26 @@ void MarlinSettings::postprocess() {
         #endif
       }
 
+      //
+      // Input Shaping
+      //
+      #if ENABLED(INPUT_SHAPING_X)
+      {
+        shaping_params_t shaping_x;
+        _FIELD_TEST(shaping_x);
+        EEPROM_READ(shaping_x);
+        if (!validating) stepper.set_shaping_params(X_AXIS, shaping_x);
+      }
+      #endif
+      #if ENABLED(INPUT_SHAPING_Y)
+      {
+        shaping_params_t shaping_y;
+        _FIELD_TEST(shaping_y);
+        EEPROM_READ(shaping_y);
+        if (!validating) stepper.set_shaping_params(Y_AXIS, shaping_y);
+      }
+      #endif
+
       //
       // Motor Current PWM
       //
@@ -2885,6 +2966,40 @@ void MarlinSettings::reset() {
     thermalManager.temp_chamber.pid.Kd = scalePID_d(DEFAULT_chamberKd);
   #endif
 
+  //
+  // Model Predictive Control
+  //
+
+  #if ENABLED(MPCTEMP)
+    constexpr float mpc_heater_power[] = MPC_HEATER_POWER,
+                    mpc_block_heat_capacity[] = MPC_BLOCK_HEAT_CAPACITY,
+                    mpc_sensor_responsiveness[] = MPC_SENSOR_RESPONSIVENESS,
+                    mpc_ambient_xfer_coeff[] = MPC_AMBIENT_XFER_COEFF,
+                    #if ENABLED(MPC_INCLUDE_FAN)
+                      mpc_ambient_xfer_coeff_fan255[] = MPC_AMBIENT_XFER_COEFF_FAN255,
+                    #endif
+                    filament_heat_capacity_permm[] = FILAMENT_HEAT_CAPACITY_PERMM;
+
+    static_assert(WITHIN(COUNT(mpc_heater_power), 1, HOTENDS), "MPC_HEATER_POWER must have between 1 and HOTENDS items.");
+    static_assert(WITHIN(COUNT(mpc_block_heat_capacity), 1, HOTENDS), "MPC_BLOCK_HEAT_CAPACITY must have between 1 and HOTENDS items.");
+    static_assert(WITHIN(COUNT(mpc_sensor_responsiveness), 1, HOTENDS), "MPC_SENSOR_RESPONSIVENESS must have between 1 and HOTENDS items.");
+    static_assert(WITHIN(COUNT(mpc_ambient_xfer_coeff), 1, HOTENDS), "MPC_AMBIENT_XFER_COEFF must have between 1 and HOTENDS items.");
+    #if ENABLED(MPC_INCLUDE_FAN)
+      static_assert(WITHIN(COUNT(mpc_ambient_xfer_coeff_fan255), 1, HOTENDS), "MPC_AMBIENT_XFER_COEFF_FAN255 must have between 1 and HOTENDS items.");
+    #endif
+    static_assert(WITHIN(COUNT(filament_heat_capacity_permm), 1, HOTENDS), "FILAMENT_HEAT_CAPACITY_PERMM must have between 1 and HOTENDS items.");
+
+    HOTEND_LOOP() {
+      MPC_t &constants = thermalManager.temp_hotend[e].constants;
+      constants.heater_power = mpc_heater_power[ALIM(e, mpc_heater_power)];
+      constants.block_heat_capacity = mpc_block_heat_capacity[ALIM(e, mpc_block_heat_capacity)];
+      constants.sensor_responsiveness = mpc_sensor_responsiveness[ALIM(e, mpc_sensor_responsiveness)];
+      constants.ambient_xfer_coeff_fan0 = mpc_ambient_xfer_coeff[ALIM(e, mpc_ambient_xfer_coeff)];
+      constants.fan255_adjustment = TERN0(MPC_INCLUDE_FAN, mpc_ambient_xfer_coeff_fan255[ALIM(e, mpc_ambient_xfer_coeff_fan255)] - constants.ambient_xfer_coeff_fan0);
+      constants.filament_heat_capacity_permm = filament_heat_capacity_permm[ALIM(e, filament_heat_capacity_permm)];
+    }
+  #endif
+
   //
   // User-Defined Thermistors
   //
@@ -2949,6 +3064,17 @@ void MarlinSettings::reset() {
     }
   #endif
 
+  //
+  // Input Shaping
+  //
+
+  #if ENABLED(INPUT_SHAPING_X)
+    stepper.set_shaping_params(X_AXIS, { SHAPING_FREQ_X, SHAPING_ZETA_X, SHAPING_TYPE_X });
+  #endif
+  #if ENABLED(INPUT_SHAPING_Y)
+    stepper.set_shaping_params(Y_AXIS, { SHAPING_FREQ_Y, SHAPING_ZETA_Y, SHAPING_TYPE_Y });
+  #endif
+
   //
   // Motor Current PWM
   //
@@ -3471,6 +3597,23 @@ void MarlinSettings::reset() {
 
     #endif // PIDTEMP || PIDTEMPBED || PIDTEMPCHAMBER
 
+    #if ENABLED(MPCTEMP)
+      CONFIG_ECHO_HEADING("Model predictive control:");
+      HOTEND_LOOP() {
+        const MPC_t &constants = thermalManager.temp_hotend[e].constants;
+        CONFIG_ECHO_START();
+        SERIAL_ECHOPAIR("  M306 E", e);
+        SERIAL_ECHOPAIR_F(" P", constants.heater_power, 2);
+        SERIAL_ECHOPAIR_F(" C", constants.block_heat_capacity, 2);
+        SERIAL_ECHOPAIR_F(" R", constants.sensor_responsiveness, 4);
+        SERIAL_ECHOPAIR_F(" A", constants.ambient_xfer_coeff_fan0, 4);
+        #if ENABLED(MPC_INCLUDE_FAN)
+          SERIAL_ECHOPAIR_F(" F", constants.ambient_xfer_coeff_fan0 + constants.fan255_adjustment, 4);
+        #endif
+        SERIAL_ECHOLNPAIR_F(" H", constants.filament_heat_capacity_permm, 4);
+      }
+    #endif
+
     #if HAS_USER_THERMISTORS
       CONFIG_ECHO_HEADING("User thermistors:");
       LOOP_L_N(i, USER_THERMISTORS)
@@ -3855,6 +3998,25 @@ void MarlinSettings::reset() {
       #endif
     #endif
 
+    /**
+     * Input Shaping
+     */
+    #if HAS_SHAPING
+      CONFIG_ECHO_HEADING("Input Shaping:");
+      #if ENABLED(INPUT_SHAPING_X)
+      {
+        const shaping_params_t p = stepper.get_shaping_params(X_AXIS);
+        CONFIG_ECHO_MSG("  M593 X F", p.frequency, " D", p.zeta, " T", int(p.type));
+      }
+      #endif
+      #if ENABLED(INPUT_SHAPING_Y)
+      {
+        const shaping_params_t p = stepper.get_shaping_params(Y_AXIS);
+        CONFIG_ECHO_MSG("  M593 Y F", p.frequency, " D", p.zeta, " T", int(p.type));
+      }
+      #endif
+    #endif
+
     #if EITHER(HAS_MOTOR_CURRENT_SPI, HAS_MOTOR_CURRENT_PWM)
       CONFIG_ECHO_HEADING("Stepper motor currents:");
       CONFIG_ECHO_START();
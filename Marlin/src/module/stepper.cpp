@@ -234,6 +234,35 @@ uint32_t Stepper::advance_divisor = 0,
   page_step_state_t Stepper::page_step_state;
 #endif
 
+#if HAS_SHAPING
+  uint32_t Stepper::shaping_ticks; // = 0
+  #if ENABLED(INPUT_SHAPING_X)
+    AxisShaper Stepper::shaper_x;
+  #endif
+  #if ENABLED(INPUT_SHAPING_Y)
+    AxisShaper Stepper::shaper_y;
+  #endif
+#endif
+
+#if ENABLED(STEP_SEGMENT_BUFFER)
+  step_segment_t Stepper::segment_buffer[STEP_SEGMENT_BUFFER_SIZE];
+  volatile uint8_t Stepper::segment_head, // = 0
+                   Stepper::segment_tail; // = 0
+  Stepper::segment_prep_t Stepper::seg_prep; // = { nullptr }
+#endif
+
+#if ENABLED(ARC_BLOCKS)
+  uint16_t Stepper::arc_chord;
+  uint32_t Stepper::arc_chord_events,
+           Stepper::arc_end_events,
+           Stepper::arc_chord_end;
+  xy_float_t Stepper::arc_rvec;
+  xy_long_t Stepper::arc_position;
+  xyze_ulong_t Stepper::arc_per_chord,
+               Stepper::arc_remainder,
+               Stepper::arc_error;
+#endif
+
 int32_t Stepper::ticks_nominal = -1;
 #if DISABLED(S_CURVE_ACCELERATION)
   uint32_t Stepper::acc_step_rate; // needed for deceleration start point
@@ -460,6 +489,18 @@ xyze_int8_t Stepper::count_direction{0};
   #define DIR_WAIT_AFTER()
 #endif
 
+#if HAS_SHAPING
+  // Point a shaped axis the way its next motor step goes, if it doesn't already
+  #define SHAPING_SET_DIR(AXIS, SHAPER, FWD) do{ \
+    if (SHAPER.forward != (FWD)) { \
+      SHAPER.forward = (FWD); \
+      DIR_WAIT_BEFORE(); \
+      AXIS##_APPLY_DIR(SHAPER.forward ? !INVERT_##AXIS##_DIR : INVERT_##AXIS##_DIR, false); \
+      DIR_WAIT_AFTER(); \
+    } \
+  }while(0)
+#endif
+
 /**
  * Set the stepper direction of each axis
  *
@@ -503,6 +544,10 @@ void Stepper::set_directions() {
     SET_STEP_DIR(K); // K
   #endif
 
+  // Shaped axes now point the same way as their source steps
+  TERN_(INPUT_SHAPING_X, shaper_x.forward = count_direction.x > 0);
+  TERN_(INPUT_SHAPING_Y, shaper_y.forward = count_direction.y > 0);
+
   #if DISABLED(LIN_ADVANCE)
     #if ENABLED(MIXING_EXTRUDER)
        // Because this is valid for the whole block we don't know
@@ -1403,7 +1448,18 @@ void Stepper::isr() {
     // Enable ISRs to reduce USART processing latency
     ENABLE_ISRS();
 
-    if (!nextMainISR) pulse_phase_isr();                            // 0 = Do coordinated axes Stepper pulses
+    if (!nextMainISR) {
+      #if HAS_SHAPING
+        // Hold off the pulse phase while a shaper queue is full
+        if (!shaping_free_count()) nextMainISR = _MAX(shaping_next_due(), 1UL);
+        else
+      #endif
+      pulse_phase_isr();                                            // 0 = Do coordinated axes Stepper pulses
+    }
+
+    #if HAS_SHAPING
+      shaping_isr();                                                // Do delayed Input Shaping pulses, if due
+    #endif
 
     #if ENABLED(LIN_ADVANCE)
       if (!nextAdvanceISR) nextAdvanceISR = advance_isr();          // 0 = Do Linear Advance E Stepper pulses
@@ -1429,6 +1485,9 @@ void Stepper::isr() {
     // Get the interval to the next ISR call
     const uint32_t interval = _MIN(
       nextMainISR                                       // Time until the next Pulse / Block phase
+      #if HAS_SHAPING
+        , shaping_next_due()                            // Come back early for delayed shaper steps?
+      #endif
       #if ENABLED(LIN_ADVANCE)
         , nextAdvanceISR                                // Come back early for Linear Advance?
       #endif
@@ -1447,6 +1506,8 @@ void Stepper::isr() {
 
     nextMainISR -= interval;
 
+    TERN_(HAS_SHAPING, shaping_ticks += interval);
+
     #if ENABLED(LIN_ADVANCE)
       if (nextAdvanceISR != LA_ADV_NEVER) nextAdvanceISR -= interval;
     #endif
@@ -1547,6 +1608,7 @@ void Stepper::pulse_phase_isr() {
   if (abort_current_block) {
     abort_current_block = false;
     if (current_block) discard_current_block();
+    TERN_(HAS_SHAPING, shaping_discard());
   }
 
   // If there is no current block, do nothing
@@ -1559,6 +1621,12 @@ void Stepper::pulse_phase_isr() {
   const uint32_t pending_events = step_event_count - step_events_completed;
   uint8_t events_to_do = _MIN(pending_events, steps_per_isr);
 
+  // Don't take more steps than the shaper queues can hold
+  TERN_(HAS_SHAPING, NOMORE(events_to_do, shaping_free_count()));
+
+  // Stop at the end of an arc chord, to start the next one in the block phase
+  TERN_(ARC_BLOCKS, NOMORE(events_to_do, arc_chord_end - step_events_completed));
+
   // Just update the value we will get at the end of the loop
   step_events_completed += events_to_do;
 
@@ -1597,6 +1665,15 @@ void Stepper::pulse_phase_isr() {
       } \
     }while(0)
 
+    // Pass a source step to the axis shaper, which decides on the motor step
+    #define PULSE_PREP_SHAPING(AXIS, SHAPER) do{ \
+      if (step_needed[_AXIS(AXIS)]) { \
+        const bool fwd = count_direction[_AXIS(AXIS)] > 0; \
+        step_needed[_AXIS(AXIS)] = SHAPER.source_step(shaping_ticks, fwd); \
+        if (step_needed[_AXIS(AXIS)]) SHAPING_SET_DIR(AXIS, SHAPER, fwd); \
+      } \
+    }while(0)
+
     // Direct Stepping page?
     const bool is_page = IS_PAGE(current_block);
 
@@ -1710,9 +1787,11 @@ void Stepper::pulse_phase_isr() {
       // Determine if pulses are needed
       #if HAS_X_STEP
         PULSE_PREP(X);
+        TERN_(INPUT_SHAPING_X, PULSE_PREP_SHAPING(X, shaper_x));
       #endif
       #if HAS_Y_STEP
         PULSE_PREP(Y);
+        TERN_(INPUT_SHAPING_Y, PULSE_PREP_SHAPING(Y, shaper_y));
       #endif
       #if HAS_Z_STEP
         PULSE_PREP(Z);
@@ -1827,6 +1906,326 @@ void Stepper::pulse_phase_isr() {
   } while (--events_to_do);
 }
 
+#if HAS_SHAPING
+
+  /**
+   * Release the delayed impulses of shaped axes that have come due
+   * and pulse the steppers that need to follow. At most one step is
+   * taken per axis, so a backlog is worked off over the next calls.
+   */
+  void Stepper::shaping_isr() {
+    // Don't wait for the pulse phase to drop the delayed steps of an aborted move
+    if (abort_current_block) return shaping_discard();
+
+    xyze_bool_t step_needed{0};
+
+    #if ENABLED(INPUT_SHAPING_X)
+      const int8_t sx = shaper_x.release(shaping_ticks);
+      if (sx) { step_needed.x = true; SHAPING_SET_DIR(X, shaper_x, sx > 0); }
+    #endif
+    #if ENABLED(INPUT_SHAPING_Y)
+      const int8_t sy = shaper_y.release(shaping_ticks);
+      if (sy) { step_needed.y = true; SHAPING_SET_DIR(Y, shaper_y, sy > 0); }
+    #endif
+
+    if (!step_needed.x && !step_needed.y) return;
+
+    #if ISR_MULTI_STEPS
+      USING_TIMED_PULSE();
+    #endif
+
+    TERN_(INPUT_SHAPING_X, PULSE_START(X));
+    TERN_(INPUT_SHAPING_Y, PULSE_START(Y));
+
+    #if ISR_MULTI_STEPS
+      START_HIGH_PULSE();
+      AWAIT_HIGH_PULSE();
+    #endif
+
+    TERN_(INPUT_SHAPING_X, PULSE_STOP(X));
+    TERN_(INPUT_SHAPING_Y, PULSE_STOP(Y));
+
+    // Leave the pins low long enough for any pulse that follows
+    #if ISR_MULTI_STEPS
+      START_LOW_PULSE();
+      AWAIT_LOW_PULSE();
+    #endif
+  }
+
+  /**
+   * The position counts source steps as they are taken, so take
+   * back the steps that the shaped motors will no longer make.
+   */
+  void Stepper::shaping_discard() {
+    TERN_(INPUT_SHAPING_X, count_position.x -= shaper_x.clear());
+    TERN_(INPUT_SHAPING_Y, count_position.y -= shaper_y.clear());
+  }
+
+  void Stepper::set_shaping_params(const AxisEnum axis, const shaping_params_t &p) {
+    planner.synchronize();
+    const bool was_on = suspend();
+    switch (axis) {
+      #if ENABLED(INPUT_SHAPING_X)
+        case X_AXIS: shaper_x.set_params(p); break;
+      #endif
+      #if ENABLED(INPUT_SHAPING_Y)
+        case Y_AXIS: shaper_y.set_params(p); break;
+      #endif
+      default: break;
+    }
+    if (was_on) wake_up();
+  }
+
+  shaping_params_t Stepper::get_shaping_params(const AxisEnum axis) {
+    switch (axis) {
+      #if ENABLED(INPUT_SHAPING_X)
+        case X_AXIS: return shaper_x.params;
+      #endif
+      #if ENABLED(INPUT_SHAPING_Y)
+        case Y_AXIS: return shaper_y.params;
+      #endif
+      default: return { 0, 0, SHAPER_ZV };
+    }
+  }
+
+#endif // HAS_SHAPING
+
+#if ENABLED(STEP_SEGMENT_BUFFER)
+
+  /**
+   * Get the prepared segment for the current step event of the current block, or
+   * nullptr if the main loop hasn't prepared it. Segments left over from finished
+   * or dropped blocks are discarded. Called from the Stepper ISR with a current block.
+   */
+  FORCE_INLINE const step_segment_t* Stepper::current_segment() {
+    const block_index_t tail = planner.block_buffer_tail; // Index of the current block
+    while (segment_tail != segment_head) {
+      const step_segment_t * const seg = &segment_buffer[segment_tail];
+      if (seg->block_index == tail) {
+        if (step_events_completed < seg->end_event) return seg;
+      }
+      else if (BLOCK_MOD(seg->block_index - tail) < BLOCK_MOD(planner.block_buffer_nonbusy - tail))
+        return nullptr;                                   // Prepared for an upcoming block
+      segment_tail = STEP_SEGMENT_MOD(segment_tail + 1);
+    }
+    return nullptr;
+  }
+
+  // Is the block being prepared still busy, i.e., not finished or dropped?
+  bool Stepper::prep_block_busy() {
+    // Read the tail first. If it moves on meanwhile the range only gets wider.
+    const block_index_t tail = planner.block_buffer_tail, nonbusy = planner.block_buffer_nonbusy;
+    return BLOCK_MOD(seg_prep.block_index - tail) < BLOCK_MOD(nonbusy - tail);
+  }
+
+  // Claim the next block for segment preparation, if one is ready
+  bool Stepper::claim_prep_block() {
+    const block_t * const block = planner.get_prep_block();
+    if (!block) return false;
+
+    // Apply the same oversampling the ISR will use for this block
+    const uint8_t oversampling = TERN(ADAPTIVE_STEP_SMOOTHING, calc_oversampling(block->nominal_rate), 0);
+
+    seg_prep.block = block;
+    seg_prep.block_index = block - planner.block_buffer;
+    seg_prep.oversampling = oversampling;
+    seg_prep.decelerating = false;
+    seg_prep.step_event_count = block->step_event_count << oversampling;
+    seg_prep.accelerate_until = block->accelerate_until << oversampling;
+    seg_prep.decelerate_after = block->decelerate_after << oversampling;
+    seg_prep.event = seg_prep.time = 0;
+    seg_prep.acc_step_rate = block->initial_rate;
+    return true;
+  }
+
+  #if ENABLED(S_CURVE_ACCELERATION)
+    // The same 5th order Bézier speed curve as _eval_bezier_curve, in floating point
+    static uint32_t bezier_step_rate(const uint32_t v0, const uint32_t v1, const uint32_t t, const uint32_t total) {
+      const float s = float(t) / float(total), s3 = s * s * s;
+      return v0 + int32_t(float(int32_t(v1 - v0)) * s3 * (10.0f + s * (6.0f * s - 15.0f)));
+    }
+  #endif
+
+  /**
+   * Split blocks into segments of about STEP_SEGMENT_TIME at a constant step rate, doing
+   * all the trapezoid / S-curve math the Stepper ISR would otherwise do for every step.
+   * Whenever this falls behind the Stepper ISR computes the step rate itself, as before.
+   */
+  void Stepper::prep_segments() {
+    while (STEP_SEGMENT_MOD(segment_head + 1) != segment_tail) { // Room for another segment?
+
+      // Forget a block that was finished or dropped in the meantime
+      if (seg_prep.block && !prep_block_busy()) seg_prep.block = nullptr;
+
+      if (!seg_prep.block && !claim_prep_block()) return;
+
+      const block_t * const block = seg_prep.block;
+
+      // Time the deceleration from its start, as the ISR does
+      if (!seg_prep.decelerating && seg_prep.event > seg_prep.decelerate_after) {
+        seg_prep.decelerating = true;
+        seg_prep.time = 0;
+      }
+
+      // Take the step rate from halfway through the segment
+      const uint32_t t = seg_prep.time + (STEP_SEGMENT_TICKS) / 2;
+      uint32_t step_rate, end_event;
+      bool cruising = false;
+
+      if (seg_prep.event <= seg_prep.accelerate_until) {
+        end_event = seg_prep.accelerate_until + 1;
+        #if ENABLED(S_CURVE_ACCELERATION)
+          step_rate = t < block->acceleration_time
+                      ? bezier_step_rate(block->initial_rate, block->cruise_rate, t, block->acceleration_time)
+                      : block->cruise_rate;
+        #else
+          step_rate = STEP_MULTIPLY(t, block->acceleration_rate) + block->initial_rate;
+          NOMORE(step_rate, block->nominal_rate);
+          seg_prep.acc_step_rate = step_rate;
+        #endif
+      }
+      else if (seg_prep.decelerating) {
+        end_event = seg_prep.step_event_count;
+        #if ENABLED(S_CURVE_ACCELERATION)
+          step_rate = t < block->deceleration_time
+                      ? bezier_step_rate(block->cruise_rate, block->final_rate, t, block->deceleration_time)
+                      : block->final_rate;
+        #else
+          step_rate = STEP_MULTIPLY(t, block->acceleration_rate);
+          step_rate = step_rate < seg_prep.acc_step_rate ? _MAX(seg_prep.acc_step_rate - step_rate, block->final_rate) : block->final_rate;
+        #endif
+      }
+      else {
+        end_event = seg_prep.decelerate_after + 1;
+        step_rate = block->nominal_rate;
+        cruising = true;
+      }
+      NOMORE(end_event, seg_prep.step_event_count);
+
+      step_segment_t seg;
+      seg.step_rate = step_rate;
+      seg.interval = calc_timer_interval(step_rate, &seg.steps_per_isr, seg_prep.oversampling);
+      seg.block_index = seg_prep.block_index;
+
+      // Cover the segment time, or the whole cruise, ending no later than the current phase
+      const uint32_t remaining = end_event - seg_prep.event;
+      uint32_t events = cruising ? remaining : _MAX(1UL, (STEP_SEGMENT_TICKS) / seg.interval) * seg.steps_per_isr;
+      NOMORE(events, remaining);
+      seg.end_event = seg_prep.event + events;
+
+      // Add it to the buffer, unless the ISR has finished the block in the meantime
+      const bool was_enabled = suspend();
+      const bool still_busy = prep_block_busy();
+      if (still_busy) {
+        segment_buffer[segment_head] = seg;
+        segment_head = STEP_SEGMENT_MOD(segment_head + 1);
+      }
+      if (was_enabled) wake_up();
+
+      if (!still_busy || seg.end_event >= seg_prep.step_event_count)
+        seg_prep.block = nullptr;                             // Done with this block
+      else {
+        seg_prep.event = seg.end_event;
+        seg_prep.time += (events + seg.steps_per_isr - 1) / seg.steps_per_isr * seg.interval;
+      }
+    }
+  }
+
+  void Stepper::reset_segments() {
+    segment_head = segment_tail = 0;
+    seg_prep.block = nullptr;
+  }
+
+#endif // STEP_SEGMENT_BUFFER
+
+#if ENABLED(ARC_BLOCKS)
+
+  #if N_ARC_CORRECTION < 1
+    #undef N_ARC_CORRECTION
+    #define N_ARC_CORRECTION 1
+  #endif
+
+  /**
+   * Set up the Bresenham tracer to trace an arc block chord by chord.
+   * All axes share the chord's event count as the divisor. The other
+   * axes get their share of the block's steps for each chord, with the
+   * remainder spread evenly over all the chords.
+   */
+  void Stepper::start_arc(const uint8_t oversampling) {
+    const block_arc_t &arc = current_block->arc;
+
+    arc_chord_events = arc.chord_events << oversampling;
+    arc_end_events = arc.end_events << oversampling;
+    arc_chord_end = 0;
+    arc_chord = 0;
+    arc_rvec = arc.rvec;
+    arc_position.set(count_position[arc.p], count_position[arc.q]);
+
+    LOOP_LOGICAL_AXES(i) if (i != arc.p && i != arc.q) {
+      arc_per_chord[i] = current_block->steps[i] / arc.chords;
+      arc_remainder[i] = current_block->steps[i] % arc.chords;
+      arc_error[i] = 0;
+    }
+
+    next_arc_chord();
+  }
+
+  /**
+   * Start the next chord of the current arc block. Rotate the radius vector,
+   * with an exact correction every N_ARC_CORRECTION chords, as plan_arc does.
+   * The last chord always ends on the block's target, with extra events
+   * for any distance from the arc to the target.
+   */
+  void Stepper::next_arc_chord() {
+    const block_arc_t &arc = current_block->arc;
+
+    xy_long_t target;
+    uint32_t events = arc_chord_events;
+    if (++arc_chord < arc.chords) {
+      if (N_ARC_CORRECTION > 1 && (arc_chord % (N_ARC_CORRECTION))) {
+        const float r_new_q = arc_rvec.x * arc.sin_T + arc_rvec.y * arc.cos_T;
+        arc_rvec.x = arc_rvec.x * arc.cos_T - arc_rvec.y * arc.sin_T;
+        arc_rvec.y = r_new_q;
+      }
+      else {
+        const float angle = arc_chord * arc.theta, cos_Ti = cos(angle), sin_Ti = sin(angle);
+        arc_rvec.set(arc.rvec.x * cos_Ti - arc.rvec.y * sin_Ti, arc.rvec.x * sin_Ti + arc.rvec.y * cos_Ti);
+      }
+      target.set(LROUND(arc.center.x + arc_rvec.x * arc.steps_per_mm.x), LROUND(arc.center.y + arc_rvec.y * arc.steps_per_mm.y));
+    }
+    else {
+      target = arc.end;
+      events += arc_end_events;
+    }
+
+    const xy_long_t delta = target - arc_position;
+    arc_position = target;
+
+    // Bresenham for this chord
+    delta_error = -int32_t(events);
+    advance_divisor = events << 1;
+    advance_dividend[arc.p] = uint32_t(ABS(delta.x)) << 1;
+    advance_dividend[arc.q] = uint32_t(ABS(delta.y)) << 1;
+    LOOP_LOGICAL_AXES(i) if (i != arc.p && i != arc.q) {
+      uint32_t steps = arc_per_chord[i];
+      arc_error[i] += arc_remainder[i];
+      if (arc_error[i] >= arc.chords) { arc_error[i] -= arc.chords; ++steps; }
+      advance_dividend[i] = steps << 1;
+    }
+    arc_chord_end += events;
+
+    // The planar axes may turn around between chords
+    uint8_t dir_bits = current_block->direction_bits;
+    SET_BIT_TO(dir_bits, arc.p, delta.x < 0);
+    SET_BIT_TO(dir_bits, arc.q, delta.y < 0);
+    if (dir_bits != current_block->direction_bits) {
+      current_block->direction_bits = dir_bits;
+      if (arc_chord > 1) set_directions(dir_bits); // The first chord's directions are set with the block
+    }
+  }
+
+#endif // ARC_BLOCKS
+
 // This is the last half of the stepper interrupt: This one processes and
 // properly schedules blocks from the planner. This is executed after creating
 // the step pulses, so it is not time critical, as pulses are already done.
@@ -1864,23 +2263,45 @@ uint32_t Stepper::block_phase_isr() {
     else {
       // Step events not completed yet...
 
+      // Start the next chord of an arc
+      TERN_(ARC_BLOCKS, if (step_events_completed == arc_chord_end) next_arc_chord());
+
+      #if ENABLED(STEP_SEGMENT_BUFFER)
+        // A segment prepared by the main loop, if it has kept up
+        const step_segment_t * const seg = current_segment();
+      #endif
+
       // Are we in acceleration phase ?
       if (step_events_completed <= accelerate_until) { // Calculate new timer value
 
         #if ENABLED(S_CURVE_ACCELERATION)
-          // Get the next speed to use (Jerk limited!)
-          uint32_t acc_step_rate = acceleration_time < current_block->acceleration_time
-                                   ? _eval_bezier_curve(acceleration_time)
-                                   : current_block->cruise_rate;
-        #else
-          acc_step_rate = STEP_MULTIPLY(acceleration_time, current_block->acceleration_rate) + current_block->initial_rate;
-          NOMORE(acc_step_rate, current_block->nominal_rate);
+          uint32_t acc_step_rate;
+        #endif
+
+        #if ENABLED(STEP_SEGMENT_BUFFER)
+          if (seg) {
+            acc_step_rate = seg->step_rate;
+            interval = seg->interval;
+            steps_per_isr = seg->steps_per_isr;
+          }
+          else
         #endif
+        {
+          #if ENABLED(S_CURVE_ACCELERATION)
+            // Get the next speed to use (Jerk limited!)
+            acc_step_rate = acceleration_time < current_block->acceleration_time
+                            ? _eval_bezier_curve(acceleration_time)
+                            : current_block->cruise_rate;
+          #else
+            acc_step_rate = STEP_MULTIPLY(acceleration_time, current_block->acceleration_rate) + current_block->initial_rate;
+            NOMORE(acc_step_rate, current_block->nominal_rate);
+          #endif
 
-        // acc_step_rate is in steps/second
+          // acc_step_rate is in steps/second
 
-        // step_rate to timer interval and steps per stepper isr
-        interval = calc_timer_interval(acc_step_rate, &steps_per_isr);
+          // step_rate to timer interval and steps per stepper isr
+          interval = calc_timer_interval(acc_step_rate, &steps_per_isr);
+        }
         acceleration_time += interval;
 
         #if ENABLED(LIN_ADVANCE)
@@ -1924,37 +2345,49 @@ uint32_t Stepper::block_phase_isr() {
       else if (step_events_completed > decelerate_after) {
         uint32_t step_rate;
 
-        #if ENABLED(S_CURVE_ACCELERATION)
-          // If this is the 1st time we process the 2nd half of the trapezoid...
-          if (!bezier_2nd_half) {
-            // Initialize the Bézier speed curve
-            _calc_bezier_curve_coeffs(current_block->cruise_rate, current_block->final_rate, current_block->deceleration_time_inverse);
-            bezier_2nd_half = true;
-            // The first point starts at cruise rate. Just save evaluation of the Bézier curve
-            step_rate = current_block->cruise_rate;
-          }
-          else {
-            // Calculate the next speed to use
-            step_rate = deceleration_time < current_block->deceleration_time
-              ? _eval_bezier_curve(deceleration_time)
-              : current_block->final_rate;
-          }
-        #else
-
-          // Using the old trapezoidal control
-          step_rate = STEP_MULTIPLY(deceleration_time, current_block->acceleration_rate);
-          if (step_rate < acc_step_rate) { // Still decelerating?
-            step_rate = acc_step_rate - step_rate;
-            NOLESS(step_rate, current_block->final_rate);
+        #if ENABLED(STEP_SEGMENT_BUFFER)
+          if (seg) {
+            step_rate = seg->step_rate;
+            interval = seg->interval;
+            steps_per_isr = seg->steps_per_isr;
           }
           else
-            step_rate = current_block->final_rate;
         #endif
+        {
+          #if ENABLED(S_CURVE_ACCELERATION)
+            // If this is the 1st time we process the 2nd half of the trapezoid...
+            if (!bezier_2nd_half) {
+              // Initialize the Bézier speed curve
+              _calc_bezier_curve_coeffs(current_block->cruise_rate, current_block->final_rate, current_block->deceleration_time_inverse);
+              bezier_2nd_half = true;
+            }
 
-        // step_rate is in steps/second
+            // The first point starts at cruise rate. Just save evaluation of the Bézier curve
+            if (!deceleration_time)
+              step_rate = current_block->cruise_rate;
+            else {
+              // Calculate the next speed to use
+              step_rate = deceleration_time < current_block->deceleration_time
+                ? _eval_bezier_curve(deceleration_time)
+                : current_block->final_rate;
+            }
+          #else
+
+            // Using the old trapezoidal control
+            step_rate = STEP_MULTIPLY(deceleration_time, current_block->acceleration_rate);
+            if (step_rate < acc_step_rate) { // Still decelerating?
+              step_rate = acc_step_rate - step_rate;
+              NOLESS(step_rate, current_block->final_rate);
+            }
+            else
+              step_rate = current_block->final_rate;
+          #endif
+
+          // step_rate is in steps/second
 
-        // step_rate to timer interval and steps per stepper isr
-        interval = calc_timer_interval(step_rate, &steps_per_isr);
+          // step_rate to timer interval and steps per stepper isr
+          interval = calc_timer_interval(step_rate, &steps_per_isr);
+        }
         deceleration_time += interval;
 
         #if ENABLED(LIN_ADVANCE)
@@ -2007,6 +2440,13 @@ uint32_t Stepper::block_phase_isr() {
 
         // Calculate the ticks_nominal for this nominal speed, if not done yet
         if (ticks_nominal < 0) {
+          #if ENABLED(STEP_SEGMENT_BUFFER)
+            if (seg) {
+              ticks_nominal = seg->interval;
+              steps_per_isr = seg->steps_per_isr;
+            }
+            else
+          #endif
           // step_rate to timer interval and loops for the nominal speed
           ticks_nominal = calc_timer_interval(current_block->nominal_rate, &steps_per_isr);
         }
@@ -2166,14 +2606,8 @@ uint32_t Stepper::block_phase_isr() {
       acceleration_time = deceleration_time = 0;
 
       #if ENABLED(ADAPTIVE_STEP_SMOOTHING)
-        uint8_t oversampling = 0;                           // Assume no axis smoothing (via oversampling)
         // Decide if axis smoothing is possible
-        uint32_t max_rate = current_block->nominal_rate;    // Get the step event rate
-        while (max_rate < MIN_STEP_ISR_FREQUENCY) {         // As long as more ISRs are possible...
-          max_rate <<= 1;                                   // Try to double the rate
-          if (max_rate < MIN_STEP_ISR_FREQUENCY)            // Don't exceed the estimated ISR limit
-            ++oversampling;                                 // Increase the oversampling (used for left-shift)
-        }
+        const uint8_t oversampling = calc_oversampling(current_block->nominal_rate);
         oversampling_factor = oversampling;                 // For all timer interval calculations
       #else
         constexpr uint8_t oversampling = 0;
@@ -2196,6 +2630,14 @@ uint32_t Stepper::block_phase_isr() {
       accelerate_until = current_block->accelerate_until << oversampling;
       decelerate_after = current_block->decelerate_after << oversampling;
 
+      #if ENABLED(ARC_BLOCKS)
+        // Trace an arc chord by chord. Other blocks are one long "chord".
+        if (IS_ARC(current_block))
+          start_arc(oversampling);
+        else
+          arc_chord_end = step_event_count;
+      #endif
+
       TERN_(MIXING_EXTRUDER, mixer.stepper_setup(current_block->b_color))
 
       TERN_(HAS_MULTI_EXTRUDER, stepper_extruder = current_block->extruder);
@@ -2287,6 +2729,14 @@ uint32_t Stepper::block_phase_isr() {
       #endif
 
       // Calculate the initial timer interval
+      #if ENABLED(STEP_SEGMENT_BUFFER)
+        const step_segment_t * const seg = current_segment();
+        if (seg) {
+          interval = seg->interval;
+          steps_per_isr = seg->steps_per_isr;
+        }
+        else
+      #endif
       interval = calc_timer_interval(current_block->initial_rate, &steps_per_isr);
     }
     #if ENABLED(LASER_POWER_INLINE_CONTINUOUS)
@@ -2430,6 +2880,15 @@ uint32_t Stepper::block_phase_isr() {
 // The current_block could change in the middle of the read by an Stepper ISR, so
 // we must explicitly prevent that!
 bool Stepper::is_block_busy(const block_t * const block) {
+  #if ENABLED(STEP_SEGMENT_BUFFER)
+    // Blocks claimed for segment preparation are busy too. Read the tail first.
+    // If it moves on meanwhile the range only gets wider, never too narrow.
+    if (block) {
+      const block_index_t tail = planner.block_buffer_tail, nonbusy = planner.block_buffer_nonbusy;
+      if (BLOCK_MOD((block - planner.block_buffer) - tail) < BLOCK_MOD(nonbusy - tail)) return true;
+    }
+  #endif
+
   #ifdef __AVR__
     // A SW memory barrier, to ensure GCC does not overoptimize loops
     #define sw_barrier() asm volatile("": : :"memory");
@@ -2787,6 +3246,10 @@ void Stepper::set_axis_position(const AxisEnum a, const int32_t &v) {
 void Stepper::endstop_triggered(const AxisEnum axis) {
 
   const bool was_enabled = suspend();
+
+  // Record where the motors are, not where the delayed shaper steps would take them
+  TERN_(HAS_SHAPING, shaping_discard());
+
   endstops_trigsteps[axis] = (
     #if IS_CORE
       (axis == CORE_AXIS_2
@@ -49,6 +49,10 @@
   #include "speed_lookuptable.h"
 #endif
 
+#if HAS_SHAPING
+  #include "../feature/input_shaping.h"
+#endif
+
 // Disable multiple steps per ISR
 //#define DISABLE_MULTI_STEPPING
 
@@ -85,8 +89,8 @@
     #define ISR_LA_BASE_CYCLES 0UL
   #endif
 
-  // S curve interpolation adds 40 cycles
-  #if ENABLED(S_CURVE_ACCELERATION)
+  // S curve interpolation adds 40 cycles (done in the main loop with STEP_SEGMENT_BUFFER)
+  #if ENABLED(S_CURVE_ACCELERATION) && DISABLED(STEP_SEGMENT_BUFFER)
     #define ISR_S_CURVE_CYCLES 40UL
   #else
     #define ISR_S_CURVE_CYCLES 0UL
@@ -115,8 +119,8 @@
     #define ISR_LA_BASE_CYCLES 0UL
   #endif
 
-  // S curve interpolation adds 160 cycles
-  #if ENABLED(S_CURVE_ACCELERATION)
+  // S curve interpolation adds 160 cycles (done in the main loop with STEP_SEGMENT_BUFFER)
+  #if ENABLED(S_CURVE_ACCELERATION) && DISABLED(STEP_SEGMENT_BUFFER)
     #define ISR_S_CURVE_CYCLES 160UL
   #else
     #define ISR_S_CURVE_CYCLES 0UL
@@ -236,6 +240,23 @@
 // Perhaps DISABLE_MULTI_STEPPING should be required with ADAPTIVE_STEP_SMOOTHING.
 #define MIN_STEP_ISR_FREQUENCY (MAX_STEP_ISR_FREQUENCY_1X / 2)
 
+#if ENABLED(STEP_SEGMENT_BUFFER)
+  /**
+   * A step segment is a span of step events within a block run at a constant step rate.
+   * Segments are prepared in the main loop, so the Stepper ISR only has to pop them.
+   */
+  typedef struct {
+    uint32_t end_event,         // Step event count (including oversampling) that ends this segment
+             step_rate;         // Step rate in steps/s, as the trapezoid generator would have computed
+    hal_timer_t interval;       // Stepper timer ticks between ISRs
+    uint8_t steps_per_isr;      // Step events per ISR
+    block_index_t block_index;  // Index of the planner block this segment belongs to
+  } step_segment_t;
+
+  #define STEP_SEGMENT_MOD(n) ((n) & ((STEP_SEGMENT_BUFFER_SIZE) - 1))
+  #define STEP_SEGMENT_TICKS  ((STEPPER_TIMER_RATE) / 1000UL * (STEP_SEGMENT_TIME) / 1000UL)
+#endif
+
 //
 // Stepper class definition
 //
@@ -351,6 +372,51 @@ class Stepper {
       static page_step_state_t page_step_state;
     #endif
 
+    #if HAS_SHAPING
+      static uint32_t shaping_ticks;        // Time base for shaper impulses, in stepper timer ticks
+      #if ENABLED(INPUT_SHAPING_X)
+        static AxisShaper shaper_x;
+      #endif
+      #if ENABLED(INPUT_SHAPING_Y)
+        static AxisShaper shaper_y;
+      #endif
+    #endif
+
+    #if ENABLED(STEP_SEGMENT_BUFFER)
+      static step_segment_t segment_buffer[STEP_SEGMENT_BUFFER_SIZE];
+      static volatile uint8_t segment_head,   // Written by prep_segments()
+                              segment_tail;   // Written by the Stepper ISR
+
+      // Main loop state of the block being split into segments
+      typedef struct {
+        const block_t *block;       // The block being prepared, or nullptr
+        block_index_t block_index;  // Index of the block in the planner buffer
+        uint8_t oversampling;       // Same as oversampling_factor will be for this block
+        bool decelerating;
+        uint32_t step_event_count,  // Block event counts, including oversampling
+                 accelerate_until,
+                 decelerate_after,
+                 event,             // Step events prepared so far
+                 time,              // Accel / decel time prepared so far, in timer ticks
+                 acc_step_rate;     // Step rate at the end of acceleration
+      } segment_prep_t;
+
+      static segment_prep_t seg_prep;
+    #endif
+
+    #if ENABLED(ARC_BLOCKS)
+      // State of the arc block being traced, chord by chord
+      static uint16_t arc_chord;            // Index of the current chord
+      static uint32_t arc_chord_events,     // Step events per chord, including oversampling
+                      arc_end_events,       // Extra step events for the last chord, including oversampling
+                      arc_chord_end;        // Step event that ends the current chord
+      static xy_float_t arc_rvec;           // Radius vector at the end of the current chord
+      static xy_long_t arc_position;        // P and Q position at the end of the current chord
+      static xyze_ulong_t arc_per_chord,    // Whole steps per chord for the other axes...
+                          arc_remainder,    // ...plus the remainder, spread over the chords
+                          arc_error;
+    #endif
+
     static int32_t ticks_nominal;
     #if DISABLED(S_CURVE_ACCELERATION)
       static uint32_t acc_step_rate; // needed for deceleration start point
@@ -428,6 +494,43 @@ class Stepper {
       }
     #endif
 
+    #if HAS_SHAPING
+      // The Input Shaping ISR phase
+      static void shaping_isr();
+
+      // Are delayed steps still pending on any shaped axis?
+      FORCE_INLINE static bool shaping_busy() {
+        return TERN0(INPUT_SHAPING_X, shaper_x.busy()) || TERN0(INPUT_SHAPING_Y, shaper_y.busy());
+      }
+
+      // Free entries in the fullest shaper queue
+      FORCE_INLINE static uint16_t shaping_free_count() {
+        return _MIN(TERN(INPUT_SHAPING_X, shaper_x.free_count(), uint16_t(SHAPING_QUEUE_MASK)),
+                    TERN(INPUT_SHAPING_Y, shaper_y.free_count(), uint16_t(SHAPING_QUEUE_MASK)));
+      }
+
+      // Ticks until the next delayed step is due
+      FORCE_INLINE static uint32_t shaping_next_due() {
+        return _MIN(TERN(INPUT_SHAPING_X, shaper_x.next_due(shaping_ticks), AxisShaper::SHAPING_NEVER),
+                    TERN(INPUT_SHAPING_Y, shaper_y.next_due(shaping_ticks), AxisShaper::SHAPING_NEVER));
+      }
+
+      // Drop the delayed steps of an aborted move. Call from the Stepper ISR or with it suspended.
+      static void shaping_discard();
+
+      // Wait for all moves to finish, then apply new shaper parameters
+      static void set_shaping_params(const AxisEnum axis, const shaping_params_t &p);
+      static shaping_params_t get_shaping_params(const AxisEnum axis);
+    #endif
+
+    #if ENABLED(STEP_SEGMENT_BUFFER)
+      // Fill the segment buffer from the busy and upcoming blocks. Call from the main loop.
+      static void prep_segments();
+
+      // Drop all prepared segments. Call with the Stepper ISR suspended.
+      static void reset_segments();
+    #endif
+
     // Check if the given block is busy or not - Must not be called from ISR contexts
     static bool is_block_busy(const block_t * const block);
 
@@ -533,11 +636,11 @@ class Stepper {
     // Set the current position in steps
     static void _set_position(const abce_long_t &spos);
 
-    FORCE_INLINE static uint32_t calc_timer_interval(uint32_t step_rate, uint8_t *loops) {
+    FORCE_INLINE static uint32_t calc_timer_interval(uint32_t step_rate, uint8_t *loops, const uint8_t oversampling=oversampling_factor) {
       uint32_t timer;
 
       // Scale the frequency, as requested by the caller
-      step_rate <<= oversampling_factor;
+      step_rate <<= oversampling;
 
       uint8_t multistep = 1;
       #if DISABLED(DISABLE_MULTI_STEPPING)
@@ -598,6 +701,30 @@ class Stepper {
       static int32_t _eval_bezier_curve(const uint32_t curr_step);
     #endif
 
+    #if ENABLED(ADAPTIVE_STEP_SMOOTHING)
+      // Oversampling needed to keep the ISR rate for the given step rate near MIN_STEP_ISR_FREQUENCY
+      static uint8_t calc_oversampling(uint32_t step_rate) {
+        uint8_t oversampling = 0;                 // Assume no axis smoothing (via oversampling)
+        while (step_rate < MIN_STEP_ISR_FREQUENCY) {  // As long as more ISRs are possible...
+          step_rate <<= 1;                        // Try to double the rate
+          if (step_rate < MIN_STEP_ISR_FREQUENCY) // Don't exceed the estimated ISR limit
+            ++oversampling;                       // Increase the oversampling (used for left-shift)
+        }
+        return oversampling;
+      }
+    #endif
+
+    #if ENABLED(STEP_SEGMENT_BUFFER)
+      static const step_segment_t* current_segment();
+      static bool claim_prep_block();
+      static bool prep_block_busy();
+    #endif
+
+    #if ENABLED(ARC_BLOCKS)
+      static void start_arc(const uint8_t oversampling);
+      static void next_arc_chord();
+    #endif
+
     #if HAS_MOTOR_CURRENT_SPI || HAS_MOTOR_CURRENT_PWM
       static void digipot_init();
     #endif
@@ -173,6 +173,11 @@
   #define NEXT_TEMPTABLE_LEN(N) ,TEMPTABLE_##N##_LEN
   static const temp_entry_t* heater_ttbl_map[HOTENDS] = ARRAY_BY_HOTENDS(TEMPTABLE_0 REPEAT_S(1, HOTENDS, NEXT_TEMPTABLE));
   static constexpr uint8_t heater_ttbllen_map[HOTENDS] = ARRAY_BY_HOTENDS(TEMPTABLE_0_LEN REPEAT_S(1, HOTENDS, NEXT_TEMPTABLE_LEN));
+  #if ENABLED(THERMISTOR_DIRECT_INDEX)
+    #define TEMPINDEX(N) (thermistor_index<TEMPTABLE_##N, TEMPTABLE_##N##_LEN>())
+    #define NEXT_TEMPINDEX(N) ,TEMPINDEX(N)
+    static constexpr const thermistor_index_t* heater_tindex_map[HOTENDS] = ARRAY_BY_HOTENDS(TEMPINDEX(0) REPEAT_S(1, HOTENDS, NEXT_TEMPINDEX));
+  #endif
 #endif
 
 Temperature thermalManager;
@@ -478,6 +483,7 @@ const char str_t_thermal_runaway[] PROGMEM = STR_T_THERMAL_RUNAWAY,
  */
 
 volatile bool Temperature::raw_temps_ready = false;
+uint8_t Temperature::raw_reading_intervals, Temperature::reading_intervals = 1;
 
 #if ENABLED(PID_EXTRUSION_SCALING)
   int32_t Temperature::last_e_position, Temperature::lpq[LPQ_MAX_LEN];
@@ -807,6 +813,272 @@ volatile bool Temperature::raw_temps_ready = false;
 
 #endif // HAS_PID_HEATING
 
+#if ENABLED(MPC_INCLUDE_FAN)
+  // The part cooling fan acting on a hotend
+  #define MPC_FAN_INDEX(E) TERN(MPC_FAN_0_ACTIVE_HOTEND, 0, E)
+#endif
+
+#if ENABLED(MPCTEMP)
+
+  /**
+   * MPC Autotuning (M306 T)
+   *
+   * Instead of relay cycles, fit the hotend model to a single heat-up:
+   *  - Cool to ambient, with the fan on to speed it up.
+   *  - Heat at full power past 200°C, sampling the temperature as it climbs.
+   *    Three evenly spaced samples give the time constant and asymptote of the
+   *    block, and so its heat capacity and heat loss, and the sensor lag.
+   *  - Hold the temperature with the new model and measure the power it takes,
+   *    with the fan off and then on full, for a better measure of heat loss.
+   */
+  void Temperature::MPC_autotune() {
+    const uint8_t ee = active_extruder;
+    MPCHeaterInfo &hotend = temp_hotend[ee];
+    MPC_t &constants = hotend.constants;
+    const MPC_t old_constants = constants;  // Kept if the tuning fails
+
+    millis_t ms = millis(), next_report_ms = ms;
+    celsius_float_t current_temp = degHotend(ee);
+
+    // Keep the temperatures and UI updated. Return 'true' if interrupted with M108.
+    auto housekeeping = [&]() {
+      ms = millis();
+      if (updateTemperaturesIfReady()) current_temp = degHotend(ee);
+
+      if (ELAPSED(ms, next_report_ms)) {
+        next_report_ms = ms + 1000UL;
+        print_heater_states(ee);
+        SERIAL_EOL();
+      }
+
+      TERN_(HAL_IDLETASK, HAL_idletask());
+      ui.update();
+
+      if (wait_for_heatup) return false;
+      SERIAL_ECHOLNPGM(STR_MPC_AUTOTUNE_INTERRUPTED);
+      return true;
+    };
+
+    #if ENABLED(MPC_INCLUDE_FAN)
+      auto set_tuning_fan = [&](const uint8_t speed) {
+        set_fan_speed(MPC_FAN_INDEX(ee), speed);
+        planner.sync_fan_speeds(fan_speed);
+      };
+    #endif
+
+    // Leave the heater and fan off however the tuning ends, and start the model afresh
+    auto finish = [&]() {
+      wait_for_heatup = false;
+      hotend.target = 0;
+      hotend.soft_pwm_amount = 0;
+      hotend.modeled_block_temp = NAN;
+      TERN_(MPC_INCLUDE_FAN, set_tuning_fan(0));
+    };
+
+    auto failed = [&]() {
+      constants = old_constants;
+      finish();
+    };
+
+    SERIAL_ECHOLNPAIR(STR_MPC_AUTOTUNE_START, ee);
+
+    disable_all_heaters();
+    TERN_(AUTO_POWER_CONTROL, powerManager.power_on());
+
+    // Cool to ambient, until the temperature stops falling
+    SERIAL_ECHOLNPGM(STR_MPC_COOLING_TO_AMBIENT);
+    LCD_MESSAGEPGM(MSG_COOLING);
+    TERN_(MPC_INCLUDE_FAN, set_tuning_fan(255));
+
+    constexpr millis_t cool_test_interval_ms = 10000UL;
+    millis_t next_test_ms = ms + cool_test_interval_ms;
+    celsius_float_t ambient_temp = NAN;   // Set by the first test
+
+    wait_for_heatup = true;
+    for (;;) {
+      if (housekeeping()) return failed();
+      if (ELAPSED(ms, next_test_ms)) {
+        if (current_temp >= ambient_temp) {
+          ambient_temp = (ambient_temp + current_temp) / 2.0f;
+          break;
+        }
+        ambient_temp = current_temp;
+        next_test_ms += cool_test_interval_ms;
+      }
+    }
+    TERN_(MPC_INCLUDE_FAN, set_tuning_fan(0));
+    hotend.modeled_ambient_temp = ambient_temp;
+
+    // Heat at full power to 200°C, finding the fastest rise of the sensor over a few seconds
+    SERIAL_ECHOLNPGM(STR_MPC_HEATING_PAST_200);
+    LCD_MESSAGEPGM(MSG_HEATING);
+    hotend.target = 200;  // For the temperature reports
+    hotend.soft_pwm_amount = (MPC_MAX) >> 1;
+    const float heater_power = constants.heater_power * ((MPC_MAX) >> 1) / 127;
+
+    // Give up after MPC_AUTOTUNE_HEATING_TIMEOUT minutes
+    #ifndef MPC_AUTOTUNE_HEATING_TIMEOUT
+      #define MPC_AUTOTUNE_HEATING_TIMEOUT 10
+    #endif
+    const millis_t heat_start_ms = ms;
+    next_test_ms = ms;
+
+    // The last few temperatures, a second apart. Rates are taken across all of them.
+    constexpr uint8_t rate_samples = 5;
+    celsius_float_t temp_samples[rate_samples];
+    uint8_t sample_count = 0;
+    float rate = 0.0f,              // (K/s) Rise of the sensor over the last few seconds
+          rate_fastest = 0.0f,      // (K/s) Fastest rise of the sensor
+          time_fastest = 0.0f;      // (s) Time of the fastest rise from the start of heating
+    celsius_float_t temp_fastest = 0.0f;
+
+    for (;;) {
+      if (housekeeping()) return failed();
+      if (ELAPSED(ms, next_test_ms)) {
+        LOOP_L_N(i, rate_samples - 1) temp_samples[i] = temp_samples[i + 1];
+        temp_samples[rate_samples - 1] = current_temp;
+        if (sample_count < rate_samples) sample_count++;
+
+        if (sample_count == rate_samples) {
+          rate = (temp_samples[rate_samples - 1] - temp_samples[0]) / (rate_samples - 1);
+          if (rate > rate_fastest) {
+            rate_fastest = rate;
+            time_fastest = float(ms - heat_start_ms) / 1000.0f - (rate_samples - 1) / 2.0f;
+            temp_fastest = (temp_samples[rate_samples - 1] + temp_samples[0]) / 2;
+          }
+        }
+
+        if (current_temp >= 200.0f) break;
+        next_test_ms += 1000UL;
+      }
+      if (ELAPSED(ms, heat_start_ms + MIN_TO_MS(MPC_AUTOTUNE_HEATING_TIMEOUT))) {
+        SERIAL_ECHOLNPGM(STR_MPC_HEATING_TIMEOUT);
+        return failed();
+      }
+    }
+    hotend.soft_pwm_amount = 0;
+
+    if (rate_fastest <= 0.0f || rate <= 0.0f || temp_fastest - ambient_temp >= rate_fastest * time_fastest) {
+      SERIAL_ECHOLNPGM(STR_MPC_AUTOTUNE_FAILED);
+      return failed();
+    }
+
+    /**
+     * While the block heats at an almost steady rate the sensor follows the same line, a little
+     * late. That delay is the sensor's time constant. The block's rate of rise falls off in step
+     * with the heat lost to the air, so the rates at the fastest point and at 200°C give both the
+     * heat capacity and the heat loss. These are refined once the heat loss has been measured.
+     */
+    constants.sensor_responsiveness = rate_fastest / (rate_fastest * time_fastest + ambient_temp - temp_fastest);
+    const celsius_float_t block_fastest = temp_fastest + rate_fastest / constants.sensor_responsiveness,
+                          block_temp = current_temp + rate / constants.sensor_responsiveness;
+    const float rate_loss = block_temp > block_fastest ? _MAX(0.0f, rate_fastest - rate) / (block_temp - block_fastest) : 0.0f;
+    constants.block_heat_capacity = heater_power / (rate_fastest + rate_loss * (block_fastest - ambient_temp));
+    constants.ambient_xfer_coeff_fan0 = rate_loss * constants.block_heat_capacity;
+    constants.fan255_adjustment = 0.0f;
+
+    hotend.modeled_block_temp = block_temp;
+    hotend.modeled_sensor_temp = current_temp;
+
+    // Let the model settle at 200°C, then measure the power it takes to hold it
+    SERIAL_ECHOLNPAIR(STR_MPC_MEASURING_AMBIENT, current_temp);
+
+    // Settle for at least 20 seconds, and with a slow sensor long enough for it to catch up with the block
+    const millis_t settle_time = _MAX(20000UL, millis_t(4000.0f / constants.sensor_responsiveness));
+    constexpr millis_t test_duration = 20000UL;
+    constexpr millis_t test_interval_ms = millis_t(MPC_dT * 1000);
+    millis_t settle_end_ms = ms + settle_time,
+             test_end_ms = settle_end_ms + test_duration,
+             last_step_ms = ms;
+    next_test_ms = ms;
+
+    // Heat put in, and time spent, over one test. Held temperatures are averaged over the time,
+    // and the heat stored in the block is taken from its modeled temperature, which leads the sensor.
+    struct HoldTest { float energy, time, temp_time, start_temp, end_temp; } tests[1 + ENABLED(MPC_INCLUDE_FAN)];
+    for (HoldTest &test : tests) test = { 0.0f, 0.0f, 0.0f, NAN, NAN };
+    uint8_t test_index = 0;
+
+    // Heat loss per degree above ambient, less any change in the heat stored in the block
+    auto heat_loss_coeff = [&](const HoldTest &test) {
+      const float power = (test.energy - (test.end_temp - test.start_temp) * constants.block_heat_capacity) / test.time;
+      return power / (test.temp_time / test.time - ambient_temp);
+    };
+
+    for (;;) {
+      if (housekeeping()) return failed();
+
+      if (ELAPSED(ms, next_test_ms)) {
+        const float step_time = float(ms - last_step_ms) / 1000.0f;
+        last_step_ms = ms;
+        HoldTest &test = tests[test_index];
+
+        if (ELAPSED(ms, test_end_ms)) {
+          #if ENABLED(MPC_INCLUDE_FAN)
+            if (test_index == 0) {
+              set_tuning_fan(255);
+              settle_end_ms = ms + settle_time;
+              test_end_ms = settle_end_ms + test_duration;
+              test_index++;
+            }
+            else
+          #endif
+              break;
+        }
+        else if (ELAPSED(ms, settle_end_ms)) {
+          if (isnan(test.start_temp))
+            test.start_temp = hotend.modeled_block_temp;
+          else {
+            test.energy += constants.heater_power * hotend.soft_pwm_amount / 127 * step_time;
+            test.time += step_time;
+            test.temp_time += current_temp * step_time;
+            test.end_temp = hotend.modeled_block_temp;
+          }
+        }
+
+        hotend.soft_pwm_amount = (int)get_pid_output_hotend(ee) >> 1;
+        next_test_ms += test_interval_ms;
+      }
+
+      if (!WITHIN(current_temp, hotend.target - 15.0f, hotend.target + 15.0f)) {
+        SERIAL_ECHOLNPGM(STR_MPC_TEMPERATURE_ERROR);
+        return failed();
+      }
+    }
+
+    constants.ambient_xfer_coeff_fan0 = heat_loss_coeff(tests[0]);
+    #if ENABLED(MPC_INCLUDE_FAN)
+      const float ambient_xfer_coeff_fan255 = heat_loss_coeff(tests[1]);
+      constants.fan255_adjustment = ambient_xfer_coeff_fan255 - constants.ambient_xfer_coeff_fan0;
+    #endif
+
+    /**
+     * With the heat loss known, the block's heating curve is
+     *   T(t) = ambient + power / loss * (1 - e^(-t * loss / capacity))
+     * Refine the capacity and the sensor delay against that curve. Each depends a
+     * little on the other, so a few rounds are enough.
+     */
+    LOOP_L_N(i, 4) {
+      const float loss = constants.ambient_xfer_coeff_fan0,
+                  block_rise = temp_fastest + rate_fastest / constants.sensor_responsiveness - ambient_temp,
+                  heated = 1.0f - (temp_fastest - ambient_temp) * loss / heater_power;
+      if (loss <= 0.0f || heated <= 0.0f) break;
+      constants.block_heat_capacity = (heater_power - loss * block_rise) / rate_fastest;
+      const float block_time = -log(heated) * constants.block_heat_capacity / loss;  // (s) When the block was as hot
+      if (block_time >= time_fastest) break;
+      constants.sensor_responsiveness = 1.0f / (time_fastest - block_time);
+    }
+
+    finish();
+
+    SERIAL_ECHOLNPGM(STR_MPC_AUTOTUNE_FINISHED);
+    SERIAL_ECHOLNPAIR("MPC_BLOCK_HEAT_CAPACITY ", constants.block_heat_capacity);
+    SERIAL_ECHOLNPAIR_F("MPC_SENSOR_RESPONSIVENESS ", constants.sensor_responsiveness, 4);
+    SERIAL_ECHOLNPAIR_F("MPC_AMBIENT_XFER_COEFF ", constants.ambient_xfer_coeff_fan0, 4);
+    TERN_(MPC_INCLUDE_FAN, SERIAL_ECHOLNPAIR_F("MPC_AMBIENT_XFER_COEFF_FAN255 ", ambient_xfer_coeff_fan255, 4));
+  }
+
+#endif // MPCTEMP
+
 int16_t Temperature::getHeaterPower(const heater_id_t heater_id) {
   switch (heater_id) {
     #if HAS_HEATED_BED
@@ -1052,9 +1324,9 @@ void Temperature::min_temp_error(const heater_id_t heater_id) {
             pid_reset[ee] = false;
           }
 
-          work_pid[ee].Kd = work_pid[ee].Kd + PID_K2 * (PID_PARAM(Kd, ee) * (temp_dState[ee] - temp_hotend[ee].celsius) - work_pid[ee].Kd);
+          work_pid[ee].Kd = work_pid[ee].Kd + PID_K2 * (PID_PARAM(Kd, ee) * (temp_dState[ee] - temp_hotend[ee].celsius) / reading_intervals - work_pid[ee].Kd);
           const float max_power_over_i_gain = float(PID_MAX) / PID_PARAM(Ki, ee) - float(MIN_POWER);
-          temp_iState[ee] = constrain(temp_iState[ee] + pid_error, 0, max_power_over_i_gain);
+          temp_iState[ee] = constrain(temp_iState[ee] + pid_error * reading_intervals, 0, max_power_over_i_gain);
           work_pid[ee].Kp = PID_PARAM(Kp, ee) * pid_error;
           work_pid[ee].Ki = PID_PARAM(Ki, ee) * temp_iState[ee];
 
@@ -1114,6 +1386,73 @@ void Temperature::min_temp_error(const heater_id_t heater_id) {
         }
       #endif
 
+    #elif ENABLED(MPCTEMP)
+
+      MPCHeaterInfo &hotend = temp_hotend[ee];
+      const MPC_t &constants = hotend.constants;
+
+      // Start the model from the measured temperature
+      if (isnan(hotend.modeled_block_temp)) {
+        hotend.modeled_ambient_temp = _MIN(30.0f, hotend.celsius); // No warmer than a reasonable room
+        hotend.modeled_block_temp = hotend.modeled_sensor_temp = hotend.celsius;
+      }
+
+      #if HOTENDS == 1
+        constexpr bool this_hotend = true;
+      #else
+        const bool this_hotend = (ee == active_extruder);
+      #endif
+
+      // Heat lost to the air, the fan, and the filament, per degree above ambient
+      float ambient_xfer_coeff = constants.ambient_xfer_coeff_fan0;
+      #if ENABLED(MPC_INCLUDE_FAN)
+        const float fan_fraction = TERN_(MPC_FAN_0_ACTIVE_HOTEND, !this_hotend ? 0.0f :) fan_speed[MPC_FAN_INDEX(ee)] * RECIPROCAL(255);
+        ambient_xfer_coeff += fan_fraction * constants.fan255_adjustment;
+      #endif
+      if (this_hotend) {
+        // The flow of the block being stepped, so the power for new filament is on the way as it arrives
+        const float e_speed = planner.get_current_e_speed();
+        ambient_xfer_coeff += e_speed * constants.filament_heat_capacity_permm;
+      }
+
+      // Advance the model by the power applied over the last period, which may span dropped readings
+      const float dT = MPC_dT * reading_intervals;
+      float blocktempdelta = hotend.soft_pwm_amount * constants.heater_power * (dT / 127) / constants.block_heat_capacity;
+      blocktempdelta += (hotend.modeled_ambient_temp - hotend.modeled_block_temp) * ambient_xfer_coeff * dT / constants.block_heat_capacity;
+      hotend.modeled_block_temp += blocktempdelta;
+
+      const float sensortempdelta = (hotend.modeled_block_temp - hotend.modeled_sensor_temp) * (constants.sensor_responsiveness * dT);
+      hotend.modeled_sensor_temp += sensortempdelta;
+
+      // The difference from the measured temperature is either noise, which averages
+      // out, or a slow drift of the model, so steer the model towards the sensor.
+      const float delta_to_apply = (hotend.celsius - hotend.modeled_sensor_temp) * (MPC_SMOOTHING_FACTOR);
+      hotend.modeled_block_temp += delta_to_apply;
+      hotend.modeled_sensor_temp += delta_to_apply;
+
+      // Blame the rest on the ambient temperature, only when the output isn't clipped or the hotend has settled
+      if (WITHIN(hotend.soft_pwm_amount, 1, 126) || ABS(blocktempdelta + delta_to_apply) < (MPC_STEADYSTATE) * dT)
+        hotend.modeled_ambient_temp += delta_to_apply > 0.0f ? _MAX(delta_to_apply, (MPC_MIN_AMBIENT_CHANGE) * dT) : _MIN(delta_to_apply, -(MPC_MIN_AMBIENT_CHANGE) * dT);
+
+      float power = 0.0f;
+      if (hotend.target != 0 && !TERN0(HEATER_IDLE_HANDLER, heater_idle[ee].timed_out)) {
+        // The power to bring the block to the target in 2 seconds, plus the power to hold it there
+        power = (hotend.target - hotend.modeled_block_temp) * constants.block_heat_capacity / 2.0f;
+        power += (hotend.target - hotend.modeled_ambient_temp) * ambient_xfer_coeff;
+      }
+
+      // Round to the nearest step of soft_pwm_amount
+      float pid_output = power * 254.0f / constants.heater_power + 1.0f;
+      LIMIT(pid_output, 0, MPC_MAX);
+
+      #if ENABLED(PID_DEBUG)
+        if (ee == active_extruder && pid_debug_flag) {
+          SERIAL_ECHO_MSG(STR_PID_DEBUG, ee, STR_PID_DEBUG_INPUT, hotend.celsius, STR_PID_DEBUG_OUTPUT, pid_output,
+            " Block ", hotend.modeled_block_temp, " Sensor ", hotend.modeled_sensor_temp, " Ambient ", hotend.modeled_ambient_temp
+          );
+        }
+      #endif
+
     #else // No PID enabled
 
       const bool is_idling = TERN0(HEATER_IDLE_HANDLER, heater_idle[ee].timed_out);
@@ -1154,11 +1493,11 @@ void Temperature::min_temp_error(const heater_id_t heater_id) {
           pid_reset = false;
         }
 
-        temp_iState = constrain(temp_iState + pid_error, 0, max_power_over_i_gain);
+        temp_iState = constrain(temp_iState + pid_error * reading_intervals, 0, max_power_over_i_gain);
 
         work_pid.Kp = temp_bed.pid.Kp * pid_error;
         work_pid.Ki = temp_bed.pid.Ki * temp_iState;
-        work_pid.Kd = work_pid.Kd + PID_K2 * (temp_bed.pid.Kd * (temp_dState - temp_bed.celsius) - work_pid.Kd);
+        work_pid.Kd = work_pid.Kd + PID_K2 * (temp_bed.pid.Kd * (temp_dState - temp_bed.celsius) / reading_intervals - work_pid.Kd);
 
         temp_dState = temp_bed.celsius;
 
@@ -1217,11 +1556,11 @@ void Temperature::min_temp_error(const heater_id_t heater_id) {
           pid_reset = false;
         }
 
-        temp_iState = constrain(temp_iState + pid_error, 0, max_power_over_i_gain);
+        temp_iState = constrain(temp_iState + pid_error * reading_intervals, 0, max_power_over_i_gain);
 
         work_pid.Kp = temp_chamber.pid.Kp * pid_error;
         work_pid.Ki = temp_chamber.pid.Ki * temp_iState;
-        work_pid.Kd = work_pid.Kd + PID_K2 * (temp_chamber.pid.Kd * (temp_dState - temp_chamber.celsius) - work_pid.Kd);
+        work_pid.Kd = work_pid.Kd + PID_K2 * (temp_chamber.pid.Kd * (temp_dState - temp_chamber.celsius) / reading_intervals - work_pid.Kd);
 
         temp_dState = temp_chamber.celsius;
 
@@ -1625,32 +1964,45 @@ void Temperature::manage_heater() {
 #define TEMP_AD595(RAW)  ((RAW) * 5.0 * 100.0 / float(HAL_ADC_RANGE) / (OVERSAMPLENR) * (TEMP_SENSOR_AD595_GAIN) + TEMP_SENSOR_AD595_OFFSET)
 #define TEMP_AD8495(RAW) ((RAW) * 6.6 * 100.0 / float(HAL_ADC_RANGE) / (OVERSAMPLENR) * (TEMP_SENSOR_AD8495_GAIN) + TEMP_SENSOR_AD8495_OFFSET)
 
-/**
- * Bisect search for the range of the 'raw' value, then interpolate
- * proportionally between the under and over values.
- */
-#define SCAN_THERMISTOR_TABLE(TBL,LEN) do{                                \
-  uint8_t l = 0, r = LEN, m;                                              \
-  for (;;) {                                                              \
-    m = (l + r) >> 1;                                                     \
-    if (!m) return celsius_t(pgm_read_word(&TBL[0].celsius));             \
-    if (m == l || m == r) return celsius_t(pgm_read_word(&TBL[LEN-1].celsius)); \
-    int16_t v00 = pgm_read_word(&TBL[m-1].value),                         \
-            v10 = pgm_read_word(&TBL[m-0].value);                         \
-         if (raw < v00) r = m;                                            \
-    else if (raw > v10) l = m;                                            \
-    else {                                                                \
-      const celsius_t v01 = celsius_t(pgm_read_word(&TBL[m-1].celsius)),  \
-                      v11 = celsius_t(pgm_read_word(&TBL[m-0].celsius));  \
-      return v01 + (raw - v00) * float(v11 - v01) / float(v10 - v00);     \
-    }                                                                     \
-  }                                                                       \
-}while(0)
-
 #if HAS_USER_THERMISTORS
 
   user_thermistor_t Temperature::user_thermistor[USER_THERMISTORS]; // Initialized by settings.load()
 
+  #ifdef USER_THERMISTOR_TABLE_STEP
+
+    #define USER_THERMISTOR_TABLE_MINTEMP -50
+    #define USER_THERMISTOR_TABLE_MAXTEMP 500
+    #define USER_THERMISTOR_TABLE_LEN ((USER_THERMISTOR_TABLE_MAXTEMP - (USER_THERMISTOR_TABLE_MINTEMP)) / (USER_THERMISTOR_TABLE_STEP) + 1)
+
+    // The raw ADC value at each step of temperature, falling as the temperature rises
+    static int16_t user_thermistor_table[USER_THERMISTORS][USER_THERMISTOR_TABLE_LEN];
+
+    /**
+     * Fill the table for a thermistor by solving its Steinhart-Hart equation
+     * for the resistance, and so the raw value, at each table temperature.
+     */
+    static void build_user_thermistor_table(const user_thermistor_t &t, int16_t (&tbl)[USER_THERMISTOR_TABLE_LEN]) {
+      constexpr float adc_max = MAX_RAW_THERMISTOR_VALUE;
+      LOOP_L_N(i, USER_THERMISTOR_TABLE_LEN) {
+        const float t_recip = 1.0f / (USER_THERMISTOR_TABLE_MINTEMP + i * (USER_THERMISTOR_TABLE_STEP) - (THERMISTOR_ABS_ZERO_C));
+
+        // Exact for the beta equation. Newton's method refines it for a 'C' coefficient.
+        float log_resistance = (t_recip - t.sh_alpha) * t.beta;
+        if (t.sh_c_coeff != 0) LOOP_L_N(n, 4) {
+          const float f = t.sh_alpha + log_resistance * t.beta_recip + t.sh_c_coeff * cu(log_resistance) - t_recip,
+                      df = t.beta_recip + 3 * t.sh_c_coeff * sq(log_resistance);
+          log_resistance -= f / df;
+        }
+
+        // Invert resistance = series_res * (raw + 0.5) / (adc_max - raw - 0.5)
+        const float resistance = expf(log_resistance),
+                    raw = (resistance * (adc_max - 0.5f) - 0.5f * t.series_res) / (resistance + t.series_res);
+        tbl[i] = LROUND(constrain(raw, 0, adc_max));
+      }
+    }
+
+  #endif
+
   void Temperature::reset_user_thermistors() {
     user_thermistor_t default_user_thermistor[USER_THERMISTORS] = {
       #if TEMP_SENSOR_0_IS_CUSTOM
@@ -1746,24 +2098,50 @@ void Temperature::manage_heater() {
       t.beta_recip   = 1.0f / t.beta;
       t.sh_alpha     = RECIPROCAL(THERMISTOR_RESISTANCE_NOMINAL_C - (THERMISTOR_ABS_ZERO_C))
                         - (t.beta_recip * t.res_25_log) - (t.sh_c_coeff * cu(t.res_25_log));
+      #ifdef USER_THERMISTOR_TABLE_STEP
+        build_user_thermistor_table(t, user_thermistor_table[t_index]);
+      #endif
     }
 
-    // maximum adc value .. take into account the over sampling
-    const int adc_max = MAX_RAW_THERMISTOR_VALUE,
-              adc_raw = constrain(raw, 1, adc_max - 1); // constrain to prevent divide-by-zero
+    #ifdef USER_THERMISTOR_TABLE_STEP
+
+      /**
+       * Bisect the table for the steps on either side of 'raw', then interpolate
+       * in centi-degrees. Beyond the table return its end temperatures.
+       */
+      const int16_t (&tbl)[USER_THERMISTOR_TABLE_LEN] = user_thermistor_table[t_index];
+      if (raw >= tbl[0]) return USER_THERMISTOR_TABLE_MINTEMP;
+      if (raw <= tbl[USER_THERMISTOR_TABLE_LEN - 1]) return USER_THERMISTOR_TABLE_MAXTEMP;
+
+      uint16_t l = 0, r = USER_THERMISTOR_TABLE_LEN - 1;
+      while (r - l > 1) {                   // tbl[l] > raw >= tbl[r]
+        const uint16_t m = (l + r) >> 1;
+        if (raw < tbl[m]) l = m; else r = m;
+      }
+      const int32_t centi = int32_t(USER_THERMISTOR_TABLE_MINTEMP + l * (USER_THERMISTOR_TABLE_STEP)) * 100
+                          + int32_t(tbl[l] - raw) * ((USER_THERMISTOR_TABLE_STEP) * 100) / (tbl[l] - tbl[r]);
+      return centi * 0.01f;
+
+    #else
+
+      // maximum adc value .. take into account the over sampling
+      const int adc_max = MAX_RAW_THERMISTOR_VALUE,
+                adc_raw = constrain(raw, 1, adc_max - 1); // constrain to prevent divide-by-zero
 
-    const float adc_inverse = (adc_max - adc_raw) - 0.5f,
-                resistance = t.series_res * (adc_raw + 0.5f) / adc_inverse,
-                log_resistance = logf(resistance);
+      const float adc_inverse = (adc_max - adc_raw) - 0.5f,
+                  resistance = t.series_res * (adc_raw + 0.5f) / adc_inverse,
+                  log_resistance = logf(resistance);
 
-    float value = t.sh_alpha;
-    value += log_resistance * t.beta_recip;
-    if (t.sh_c_coeff != 0)
-      value += t.sh_c_coeff * cu(log_resistance);
-    value = 1.0f / value;
+      float value = t.sh_alpha;
+      value += log_resistance * t.beta_recip;
+      if (t.sh_c_coeff != 0)
+        value += t.sh_c_coeff * cu(log_resistance);
+      value = 1.0f / value;
 
-    // Return degrees C (up to 999, as the LCD only displays 3 digits)
-    return _MIN(value + THERMISTOR_ABS_ZERO_C, 999);
+      // Return degrees C (up to 999, as the LCD only displays 3 digits)
+      return _MIN(value + THERMISTOR_ABS_ZERO_C, 999);
+
+    #endif
   }
 #endif
 
@@ -1883,6 +2261,10 @@ void Temperature::manage_heater() {
 
     #if HAS_HOTEND_THERMISTOR
       // Thermistor with conversion table?
+      #if ENABLED(THERMISTOR_DIRECT_INDEX)
+        celsius_float_t celsius;
+        if (heater_tindex_map[e] && thermistor_index_lookup(*heater_tindex_map[e], raw, celsius)) return celsius;
+      #endif
       const temp_entry_t(*tt)[] = (temp_entry_t(*)[])(heater_ttbl_map[e]);
       SCAN_THERMISTOR_TABLE((*tt), heater_ttbllen_map[e]);
     #endif
@@ -1897,7 +2279,7 @@ void Temperature::manage_heater() {
     #if TEMP_SENSOR_BED_IS_CUSTOM
       return user_thermistor_to_deg_c(CTI_BED, raw);
     #elif TEMP_SENSOR_BED_IS_THERMISTOR
-      SCAN_THERMISTOR_TABLE(TEMPTABLE_BED, TEMPTABLE_BED_LEN);
+      LOOKUP_THERMISTOR_TABLE(TEMPTABLE_BED, TEMPTABLE_BED_LEN);
     #elif TEMP_SENSOR_BED_IS_AD595
       return TEMP_AD595(raw);
     #elif TEMP_SENSOR_BED_IS_AD8495
@@ -1915,7 +2297,7 @@ void Temperature::manage_heater() {
     #if TEMP_SENSOR_CHAMBER_IS_CUSTOM
       return user_thermistor_to_deg_c(CTI_CHAMBER, raw);
     #elif TEMP_SENSOR_CHAMBER_IS_THERMISTOR
-      SCAN_THERMISTOR_TABLE(TEMPTABLE_CHAMBER, TEMPTABLE_CHAMBER_LEN);
+      LOOKUP_THERMISTOR_TABLE(TEMPTABLE_CHAMBER, TEMPTABLE_CHAMBER_LEN);
     #elif TEMP_SENSOR_CHAMBER_IS_AD595
       return TEMP_AD595(raw);
     #elif TEMP_SENSOR_CHAMBER_IS_AD8495
@@ -1933,7 +2315,7 @@ void Temperature::manage_heater() {
     #if TEMP_SENSOR_COOLER_IS_CUSTOM
       return user_thermistor_to_deg_c(CTI_COOLER, raw);
     #elif TEMP_SENSOR_COOLER_IS_THERMISTOR
-      SCAN_THERMISTOR_TABLE(TEMPTABLE_COOLER, TEMPTABLE_COOLER_LEN);
+      LOOKUP_THERMISTOR_TABLE(TEMPTABLE_COOLER, TEMPTABLE_COOLER_LEN);
     #elif TEMP_SENSOR_COOLER_IS_AD595
       return TEMP_AD595(raw);
     #elif TEMP_SENSOR_COOLER_IS_AD8495
@@ -1951,7 +2333,7 @@ void Temperature::manage_heater() {
     #if TEMP_SENSOR_PROBE_IS_CUSTOM
       return user_thermistor_to_deg_c(CTI_PROBE, raw);
     #elif TEMP_SENSOR_PROBE_IS_THERMISTOR
-      SCAN_THERMISTOR_TABLE(TEMPTABLE_PROBE, TEMPTABLE_PROBE_LEN);
+      LOOKUP_THERMISTOR_TABLE(TEMPTABLE_PROBE, TEMPTABLE_PROBE_LEN);
     #elif TEMP_SENSOR_PROBE_IS_AD595
       return TEMP_AD595(raw);
     #elif TEMP_SENSOR_PROBE_IS_AD8495
@@ -1969,7 +2351,7 @@ void Temperature::manage_heater() {
     #if TEMP_SENSOR_BOARD_IS_CUSTOM
       return user_thermistor_to_deg_c(CTI_BOARD, raw);
     #elif TEMP_SENSOR_BOARD_IS_THERMISTOR
-      SCAN_THERMISTOR_TABLE(TEMPTABLE_BOARD, TEMPTABLE_BOARD_LEN);
+      LOOKUP_THERMISTOR_TABLE(TEMPTABLE_BOARD, TEMPTABLE_BOARD_LEN);
     #elif TEMP_SENSOR_BOARD_IS_AD595
       return TEMP_AD595(raw);
     #elif TEMP_SENSOR_BOARD_IS_AD8495
@@ -1991,7 +2373,7 @@ void Temperature::manage_heater() {
     #elif TEMP_SENSOR_REDUNDANT_IS_MAX_TC && REDUNDANT_TEMP_MATCH(SOURCE, E1)
       return TERN(TEMP_SENSOR_REDUNDANT_IS_MAX31865, max31865_1.temperature((uint16_t)raw), raw * 0.25);
     #elif TEMP_SENSOR_REDUNDANT_IS_THERMISTOR
-      SCAN_THERMISTOR_TABLE(TEMPTABLE_REDUNDANT, TEMPTABLE_REDUNDANT_LEN);
+      LOOKUP_THERMISTOR_TABLE(TEMPTABLE_REDUNDANT, TEMPTABLE_REDUNDANT_LEN);
     #elif TEMP_SENSOR_REDUNDANT_IS_AD595
       return TEMP_AD595(raw);
     #elif TEMP_SENSOR_REDUNDANT_IS_AD8495
@@ -2103,6 +2485,82 @@ void Temperature::updateTemperaturesFromRawValues() {
 
 } // Temperature::updateTemperaturesFromRawValues
 
+
+#if ENABLED(ADC_SCAN_MODE)
+
+  // Analog channels for the HAL to scan, in ADCSensorState order
+  static const pin_t adc_scan_pins[] = {
+    #if HAS_TEMP_ADC_0
+      TEMP_0_PIN,
+    #endif
+    #if HAS_TEMP_ADC_BED
+      TEMP_BED_PIN,
+    #endif
+    #if HAS_TEMP_ADC_CHAMBER
+      TEMP_CHAMBER_PIN,
+    #endif
+    #if HAS_TEMP_ADC_COOLER
+      TEMP_COOLER_PIN,
+    #endif
+    #if HAS_TEMP_ADC_PROBE
+      TEMP_PROBE_PIN,
+    #endif
+    #if HAS_TEMP_ADC_BOARD
+      TEMP_BOARD_PIN,
+    #endif
+    #if HAS_TEMP_ADC_REDUNDANT
+      TEMP_REDUNDANT_PIN,
+    #endif
+    #if HAS_TEMP_ADC_1
+      TEMP_1_PIN,
+    #endif
+    #if HAS_TEMP_ADC_2
+      TEMP_2_PIN,
+    #endif
+    #if HAS_TEMP_ADC_3
+      TEMP_3_PIN,
+    #endif
+    #if HAS_TEMP_ADC_4
+      TEMP_4_PIN,
+    #endif
+    #if HAS_TEMP_ADC_5
+      TEMP_5_PIN,
+    #endif
+    #if HAS_TEMP_ADC_6
+      TEMP_6_PIN,
+    #endif
+    #if HAS_TEMP_ADC_7
+      TEMP_7_PIN,
+    #endif
+    #if HAS_JOY_ADC_X
+      JOY_X_PIN,
+    #endif
+    #if HAS_JOY_ADC_Y
+      JOY_Y_PIN,
+    #endif
+    #if HAS_JOY_ADC_Z
+      JOY_Z_PIN,
+    #endif
+    #if ENABLED(FILAMENT_WIDTH_SENSOR)
+      FILWIDTH_PIN,
+    #endif
+    #if ENABLED(POWER_MONITOR_CURRENT)
+      POWER_MONITOR_CURRENT_PIN,
+    #endif
+    #if ENABLED(POWER_MONITOR_VOLTAGE)
+      POWER_MONITOR_VOLTAGE_PIN,
+    #endif
+    #if HAS_ADC_BUTTONS
+      ADC_KEYPAD_PIN,
+    #endif
+  };
+
+  // Each channel has a Prepare and a Measure state following StartSampling
+  #define ADC_SCAN_INDEX(S) ((int(S) - 1) >> 1)
+  static_assert(COUNT(adc_scan_pins) == ADC_SCAN_INDEX(SensorsReady), "adc_scan_pins must match ADCSensorState.");
+
+#endif
+
 /**
  * Initialize the temperature manager
  *
@@ -2129,6 +2587,9 @@ void Temperature::init() {
     last_e_position = 0;
   #endif
 
+  // Start the hotend models from the first reading
+  TERN_(MPCTEMP, HOTEND_LOOP() temp_hotend[e].modeled_block_temp = NAN);
+
   // Init (and disable) SPI thermocouples
   #if TEMP_SENSOR_IS_ANY_MAX_TC(0) && PIN_EXISTS(TEMP_0_CS)
     OUT_WRITE(TEMP_0_CS_PIN, HIGH);
@@ -2348,6 +2809,8 @@ void Temperature::init() {
     HAL_ANALOG_SELECT(POWER_MONITOR_VOLTAGE_PIN);
   #endif
 
+  TERN_(ADC_SCAN_MODE, HAL_adc_scan_start(adc_scan_pins, COUNT(adc_scan_pins)));
+
   HAL_timer_start(TEMP_TIMER_NUM, TEMP_TIMER_FREQUENCY);
   ENABLE_TEMPERATURE_INTERRUPT();
 
@@ -2887,9 +3350,15 @@ void Temperature::update_raw_temperatures() {
  */
 void Temperature::readings_ready() {
 
+  // Count the readings since the last update, including any dropped while it waited to be used
+  static uint8_t intervals = 0;
+  if (intervals < 255) intervals++;
+
   // Update raw values only if they're not already set.
   if (!raw_temps_ready) {
     update_raw_temperatures();
+    raw_reading_intervals = intervals;
+    intervals = 0;
     raw_temps_ready = true;
   }
 
@@ -2971,8 +3440,10 @@ public:
  */
 void Temperature::isr() {
 
-  static int8_t temp_count = -1;
-  static ADCSensorState adc_sensor_state = StartupDelay;
+  #if DISABLED(ADC_SCAN_MODE)
+    static int8_t temp_count = -1;
+    static ADCSensorState adc_sensor_state = StartupDelay;
+  #endif
   static uint8_t pwm_count = _BV(SOFT_PWM_SCALE);
 
   // avoid multiple loads of pwm_count
@@ -2981,6 +3452,29 @@ void Temperature::isr() {
   #if HAS_ADC_BUTTONS
     static unsigned int raw_ADCKey_value = 0;
     static bool ADCKey_pressed = false;
+
+    #ifndef ADC_BUTTON_DEBOUNCE_DELAY
+      #define ADC_BUTTON_DEBOUNCE_DELAY 16
+    #endif
+
+    // Debounce one reading of the ADC keypad
+    auto adc_key_sample = [](const uint16_t adc) {
+      if (ADCKey_count < ADC_BUTTON_DEBOUNCE_DELAY) {
+        raw_ADCKey_value = adc;
+        if (raw_ADCKey_value <= 900UL * HAL_ADC_RANGE / 1024UL) {
+          NOMORE(current_ADCKey_raw, raw_ADCKey_value);
+          ADCKey_count++;
+        }
+        else { //ADC Key release
+          if (ADCKey_count > 0) ADCKey_count++; else ADCKey_pressed = false;
+          if (ADCKey_pressed) {
+            ADCKey_count = 0;
+            current_ADCKey_raw = HAL_ADC_RANGE;
+          }
+        }
+      }
+      if (ADCKey_count == ADC_BUTTON_DEBOUNCE_DELAY) ADCKey_pressed = true;
+    };
   #endif
 
   #if HAS_HOTEND
@@ -3264,193 +3758,223 @@ void Temperature::isr() {
   static bool do_buttons;
   if ((do_buttons ^= true)) ui.update_buttons();
 
-  /**
-   * One sensor is sampled on every other call of the ISR.
-   * Each sensor is read 16 (OVERSAMPLENR) times, taking the average.
-   *
-   * On each Prepare pass, ADC is started for a sensor pin.
-   * On the next pass, the ADC value is read and accumulated.
-   *
-   * This gives each ADC 0.9765ms to charge up.
-   */
-  #define ACCUMULATE_ADC(obj) do{ \
-    if (!HAL_ADC_READY()) next_sensor_state = adc_sensor_state; \
-    else obj.sample(HAL_READ_ADC()); \
-  }while(0)
-
-  ADCSensorState next_sensor_state = adc_sensor_state < SensorsReady ? (ADCSensorState)(int(adc_sensor_state) + 1) : StartSampling;
-
-  switch (adc_sensor_state) {
-
-    case SensorsReady: {
-      // All sensors have been read. Stay in this state for a few
-      // ISRs to save on calls to temp update/checking code below.
-      constexpr int8_t extra_loops = MIN_ADC_ISR_LOOPS - (int8_t)SensorsReady;
-      static uint8_t delay_count = 0;
-      if (extra_loops > 0) {
-        if (delay_count == 0) delay_count = extra_loops;  // Init this delay
-        if (--delay_count)                                // While delaying...
-          next_sensor_state = SensorsReady;               // retain this state (else, next state will be 0)
-        break;
-      }
-      else {
-        adc_sensor_state = StartSampling;                 // Fall-through to start sampling
-        next_sensor_state = (ADCSensorState)(int(StartSampling) + 1);
-      }
+  #if ENABLED(ADC_SCAN_MODE)
+
+    /**
+     * The HAL converts all channels continuously into a buffer, each value
+     * the sum of the last ADC_SCAN_OVERSAMPLE conversions of the channel.
+     * Every ADC_SCAN_INTERVAL calls of the ISR, filter the latest values
+     * and hand them over as a complete set of readings.
+     */
+    static uint8_t scan_count = 0;
+    if (++scan_count >= ADC_SCAN_INTERVAL) {
+      scan_count = 0;
+
+      // Scale a channel to the sum of OVERSAMPLENR samples, or to a single sample
+      #define ADC_SCAN_OVERSAMPLED(S) uint16_t(HAL_adc_scan_value(ADC_SCAN_INDEX(S)) * (OVERSAMPLENR) / (ADC_SCAN_OVERSAMPLE))
+      #define ADC_SCAN_SINGLE(S)      uint16_t(HAL_adc_scan_value(ADC_SCAN_INDEX(S)) / (ADC_SCAN_OVERSAMPLE))
+      #define SCAN_ADC(obj,S)         obj.sample(obj.filter.apply(ADC_SCAN_OVERSAMPLED(S)))
+
+      TERN_(HAS_TEMP_ADC_0,         SCAN_ADC(temp_hotend[0], MeasureTemp_0));
+      TERN_(HAS_TEMP_ADC_BED,       SCAN_ADC(temp_bed, MeasureTemp_BED));
+      TERN_(HAS_TEMP_ADC_CHAMBER,   SCAN_ADC(temp_chamber, MeasureTemp_CHAMBER));
+      TERN_(HAS_TEMP_ADC_COOLER,    SCAN_ADC(temp_cooler, MeasureTemp_COOLER));
+      TERN_(HAS_TEMP_ADC_PROBE,     SCAN_ADC(temp_probe, MeasureTemp_PROBE));
+      TERN_(HAS_TEMP_ADC_BOARD,     SCAN_ADC(temp_board, MeasureTemp_BOARD));
+      TERN_(HAS_TEMP_ADC_REDUNDANT, SCAN_ADC(temp_redundant, MeasureTemp_REDUNDANT));
+      TERN_(HAS_TEMP_ADC_1,         SCAN_ADC(temp_hotend[1], MeasureTemp_1));
+      TERN_(HAS_TEMP_ADC_2,         SCAN_ADC(temp_hotend[2], MeasureTemp_2));
+      TERN_(HAS_TEMP_ADC_3,         SCAN_ADC(temp_hotend[3], MeasureTemp_3));
+      TERN_(HAS_TEMP_ADC_4,         SCAN_ADC(temp_hotend[4], MeasureTemp_4));
+      TERN_(HAS_TEMP_ADC_5,         SCAN_ADC(temp_hotend[5], MeasureTemp_5));
+      TERN_(HAS_TEMP_ADC_6,         SCAN_ADC(temp_hotend[6], MeasureTemp_6));
+      TERN_(HAS_TEMP_ADC_7,         SCAN_ADC(temp_hotend[7], MeasureTemp_7));
+      TERN_(HAS_JOY_ADC_X,          SCAN_ADC(joystick.x, MeasureJoy_X));
+      TERN_(HAS_JOY_ADC_Y,          SCAN_ADC(joystick.y, MeasureJoy_Y));
+      TERN_(HAS_JOY_ADC_Z,          SCAN_ADC(joystick.z, MeasureJoy_Z));
+      TERN_(FILAMENT_WIDTH_SENSOR,  filwidth.accumulate(ADC_SCAN_SINGLE(Measure_FILWIDTH)));
+      TERN_(POWER_MONITOR_CURRENT,  power_monitor.add_current_sample(ADC_SCAN_SINGLE(Measure_POWER_MONITOR_CURRENT)));
+      TERN_(POWER_MONITOR_VOLTAGE,  power_monitor.add_voltage_sample(ADC_SCAN_SINGLE(Measure_POWER_MONITOR_VOLTAGE)));
+      TERN_(HAS_ADC_BUTTONS,        adc_key_sample(ADC_SCAN_SINGLE(Measure_ADC_KEY)));
+
+      readings_ready();
     }
 
-    case StartSampling:                                   // Start of sampling loops. Do updates/checks.
-      if (++temp_count >= OVERSAMPLENR) {                 // 10 * 16 * 1/(16000000/64/256)  = 164ms.
-        temp_count = 0;
-        readings_ready();
+  #else
+
+    /**
+     * One sensor is sampled on every other call of the ISR.
+     * Each sensor is read 16 (OVERSAMPLENR) times, taking the average.
+     *
+     * On each Prepare pass, ADC is started for a sensor pin.
+     * On the next pass, the ADC value is read and accumulated.
+     *
+     * This gives each ADC 0.9765ms to charge up.
+     */
+    #define ACCUMULATE_ADC(obj) do{ \
+      if (!HAL_ADC_READY()) next_sensor_state = adc_sensor_state; \
+      else obj.sample(HAL_READ_ADC()); \
+    }while(0)
+
+    ADCSensorState next_sensor_state = adc_sensor_state < SensorsReady ? (ADCSensorState)(int(adc_sensor_state) + 1) : StartSampling;
+
+    switch (adc_sensor_state) {
+
+      case SensorsReady: {
+        // All sensors have been read. Stay in this state for a few
+        // ISRs to save on calls to temp update/checking code below.
+        constexpr int8_t extra_loops = MIN_ADC_ISR_LOOPS - (int8_t)SensorsReady;
+        static uint8_t delay_count = 0;
+        if (extra_loops > 0) {
+          if (delay_count == 0) delay_count = extra_loops;  // Init this delay
+          if (--delay_count)                                // While delaying...
+            next_sensor_state = SensorsReady;               // retain this state (else, next state will be 0)
+          break;
+        }
+        else {
+          adc_sensor_state = StartSampling;                 // Fall-through to start sampling
+          next_sensor_state = (ADCSensorState)(int(StartSampling) + 1);
+        }
       }
-      break;
 
-    #if HAS_TEMP_ADC_0
-      case PrepareTemp_0: HAL_START_ADC(TEMP_0_PIN); break;
-      case MeasureTemp_0: ACCUMULATE_ADC(temp_hotend[0]); break;
-    #endif
+      case StartSampling:                                   // Start of sampling loops. Do updates/checks.
+        if (++temp_count >= OVERSAMPLENR) {                 // 10 * 16 * 1/(16000000/64/256)  = 164ms.
+          temp_count = 0;
+          readings_ready();
+        }
+        break;
 
-    #if HAS_TEMP_ADC_BED
-      case PrepareTemp_BED: HAL_START_ADC(TEMP_BED_PIN); break;
-      case MeasureTemp_BED: ACCUMULATE_ADC(temp_bed); break;
-    #endif
+      #if HAS_TEMP_ADC_0
+        case PrepareTemp_0: HAL_START_ADC(TEMP_0_PIN); break;
+        case MeasureTemp_0: ACCUMULATE_ADC(temp_hotend[0]); break;
+      #endif
 
-    #if HAS_TEMP_ADC_CHAMBER
-      case PrepareTemp_CHAMBER: HAL_START_ADC(TEMP_CHAMBER_PIN); break;
-      case MeasureTemp_CHAMBER: ACCUMULATE_ADC(temp_chamber); break;
-    #endif
+      #if HAS_TEMP_ADC_BED
+        case PrepareTemp_BED: HAL_START_ADC(TEMP_BED_PIN); break;
+        case MeasureTemp_BED: ACCUMULATE_ADC(temp_bed); break;
+      #endif
 
-    #if HAS_TEMP_ADC_COOLER
-      case PrepareTemp_COOLER: HAL_START_ADC(TEMP_COOLER_PIN); break;
-      case MeasureTemp_COOLER: ACCUMULATE_ADC(temp_cooler); break;
-    #endif
+      #if HAS_TEMP_ADC_CHAMBER
+        case PrepareTemp_CHAMBER: HAL_START_ADC(TEMP_CHAMBER_PIN); break;
+        case MeasureTemp_CHAMBER: ACCUMULATE_ADC(temp_chamber); break;
+      #endif
 
-    #if HAS_TEMP_ADC_PROBE
-      case PrepareTemp_PROBE: HAL_START_ADC(TEMP_PROBE_PIN); break;
-      case MeasureTemp_PROBE: ACCUMULATE_ADC(temp_probe); break;
-    #endif
+      #if HAS_TEMP_ADC_COOLER
+        case PrepareTemp_COOLER: HAL_START_ADC(TEMP_COOLER_PIN); break;
+        case MeasureTemp_COOLER: ACCUMULATE_ADC(temp_cooler); break;
+      #endif
 
-    #if HAS_TEMP_ADC_BOARD
-      case PrepareTemp_BOARD: HAL_START_ADC(TEMP_BOARD_PIN); break;
-      case MeasureTemp_BOARD: ACCUMULATE_ADC(temp_board); break;
-    #endif
+      #if HAS_TEMP_ADC_PROBE
+        case PrepareTemp_PROBE: HAL_START_ADC(TEMP_PROBE_PIN); break;
+        case MeasureTemp_PROBE: ACCUMULATE_ADC(temp_probe); break;
+      #endif
 
-    #if HAS_TEMP_ADC_REDUNDANT
-      case PrepareTemp_REDUNDANT: HAL_START_ADC(TEMP_REDUNDANT_PIN); break;
-      case MeasureTemp_REDUNDANT: ACCUMULATE_ADC(temp_redundant); break;
-    #endif
+      #if HAS_TEMP_ADC_BOARD
+        case PrepareTemp_BOARD: HAL_START_ADC(TEMP_BOARD_PIN); break;
+        case MeasureTemp_BOARD: ACCUMULATE_ADC(temp_board); break;
+      #endif
 
-    #if HAS_TEMP_ADC_1
-      case PrepareTemp_1: HAL_START_ADC(TEMP_1_PIN); break;
-      case MeasureTemp_1: ACCUMULATE_ADC(temp_hotend[1]); break;
-    #endif
+      #if HAS_TEMP_ADC_REDUNDANT
+        case PrepareTemp_REDUNDANT: HAL_START_ADC(TEMP_REDUNDANT_PIN); break;
+        case MeasureTemp_REDUNDANT: ACCUMULATE_ADC(temp_redundant); break;
+      #endif
 
-    #if HAS_TEMP_ADC_2
-      case PrepareTemp_2: HAL_START_ADC(TEMP_2_PIN); break;
-      case MeasureTemp_2: ACCUMULATE_ADC(temp_hotend[2]); break;
-    #endif
+      #if HAS_TEMP_ADC_1
+        case PrepareTemp_1: HAL_START_ADC(TEMP_1_PIN); break;
+        case MeasureTemp_1: ACCUMULATE_ADC(temp_hotend[1]); break;
+      #endif
 
-    #if HAS_TEMP_ADC_3
-      case PrepareTemp_3: HAL_START_ADC(TEMP_3_PIN); break;
-      case MeasureTemp_3: ACCUMULATE_ADC(temp_hotend[3]); break;
-    #endif
+      #if HAS_TEMP_ADC_2
+        case PrepareTemp_2: HAL_START_ADC(TEMP_2_PIN); break;
+        case MeasureTemp_2: ACCUMULATE_ADC(temp_hotend[2]); break;
+      #endif
 
-    #if HAS_TEMP_ADC_4
-      case PrepareTemp_4: HAL_START_ADC(TEMP_4_PIN); break;
-      case MeasureTemp_4: ACCUMULATE_ADC(temp_hotend[4]); break;
-    #endif
+      #if HAS_TEMP_ADC_3
+        case PrepareTemp_3: HAL_START_ADC(TEMP_3_PIN); break;
+        case MeasureTemp_3: ACCUMULATE_ADC(temp_hotend[3]); break;
+      #endif
 
-    #if HAS_TEMP_ADC_5
-      case PrepareTemp_5: HAL_START_ADC(TEMP_5_PIN); break;
-      case MeasureTemp_5: ACCUMULATE_ADC(temp_hotend[5]); break;
-    #endif
+      #if HAS_TEMP_ADC_4
+        case PrepareTemp_4: HAL_START_ADC(TEMP_4_PIN); break;
+        case MeasureTemp_4: ACCUMULATE_ADC(temp_hotend[4]); break;
+      #endif
 
-    #if HAS_TEMP_ADC_6
-      case PrepareTemp_6: HAL_START_ADC(TEMP_6_PIN); break;
-      case MeasureTemp_6: ACCUMULATE_ADC(temp_hotend[6]); break;
-    #endif
+      #if HAS_TEMP_ADC_5
+        case PrepareTemp_5: HAL_START_ADC(TEMP_5_PIN); break;
+        case MeasureTemp_5: ACCUMULATE_ADC(temp_hotend[5]); break;
+      #endif
 
-    #if HAS_TEMP_ADC_7
-      case PrepareTemp_7: HAL_START_ADC(TEMP_7_PIN); break;
-      case MeasureTemp_7: ACCUMULATE_ADC(temp_hotend[7]); break;
-    #endif
+      #if HAS_TEMP_ADC_6
+        case PrepareTemp_6: HAL_START_ADC(TEMP_6_PIN); break;
+        case MeasureTemp_6: ACCUMULATE_ADC(temp_hotend[6]); break;
+      #endif
 
-    #if ENABLED(FILAMENT_WIDTH_SENSOR)
-      case Prepare_FILWIDTH: HAL_START_ADC(FILWIDTH_PIN); break;
-      case Measure_FILWIDTH:
-        if (!HAL_ADC_READY()) next_sensor_state = adc_sensor_state; // Redo this state
-        else filwidth.accumulate(HAL_READ_ADC());
-      break;
-    #endif
+      #if HAS_TEMP_ADC_7
+        case PrepareTemp_7: HAL_START_ADC(TEMP_7_PIN); break;
+        case MeasureTemp_7: ACCUMULATE_ADC(temp_hotend[7]); break;
+      #endif
 
-    #if ENABLED(POWER_MONITOR_CURRENT)
-      case Prepare_POWER_MONITOR_CURRENT:
-        HAL_START_ADC(POWER_MONITOR_CURRENT_PIN);
-        break;
-      case Measure_POWER_MONITOR_CURRENT:
-        if (!HAL_ADC_READY()) next_sensor_state = adc_sensor_state; // Redo this state
-        else power_monitor.add_current_sample(HAL_READ_ADC());
+      #if ENABLED(FILAMENT_WIDTH_SENSOR)
+        case Prepare_FILWIDTH: HAL_START_ADC(FILWIDTH_PIN); break;
+        case Measure_FILWIDTH:
+          if (!HAL_ADC_READY()) next_sensor_state = adc_sensor_state; // Redo this state
+          else filwidth.accumulate(HAL_READ_ADC());
         break;
-    #endif
+      #endif
 
-    #if ENABLED(POWER_MONITOR_VOLTAGE)
-      case Prepare_POWER_MONITOR_VOLTAGE:
-        HAL_START_ADC(POWER_MONITOR_VOLTAGE_PIN);
-        break;
-      case Measure_POWER_MONITOR_VOLTAGE:
-        if (!HAL_ADC_READY()) next_sensor_state = adc_sensor_state; // Redo this state
-        else power_monitor.add_voltage_sample(HAL_READ_ADC());
-        break;
-    #endif
+      #if ENABLED(POWER_MONITOR_CURRENT)
+        case Prepare_POWER_MONITOR_CURRENT:
+          HAL_START_ADC(POWER_MONITOR_CURRENT_PIN);
+          break;
+        case Measure_POWER_MONITOR_CURRENT:
+          if (!HAL_ADC_READY()) next_sensor_state = adc_sensor_state; // Redo this state
+          else power_monitor.add_current_sample(HAL_READ_ADC());
+          break;
+      #endif
 
-    #if HAS_JOY_ADC_X
-      case PrepareJoy_X: HAL_START_ADC(JOY_X_PIN); break;
-      case MeasureJoy_X: ACCUMULATE_ADC(joystick.x); break;
-    #endif
+      #if ENABLED(POWER_MONITOR_VOLTAGE)
+        case Prepare_POWER_MONITOR_VOLTAGE:
+          HAL_START_ADC(POWER_MONITOR_VOLTAGE_PIN);
+          break;
+        case Measure_POWER_MONITOR_VOLTAGE:
+          if (!HAL_ADC_READY()) next_sensor_state = adc_sensor_state; // Redo this state
+          else power_monitor.add_voltage_sample(HAL_READ_ADC());
+          break;
+      #endif
 
-    #if HAS_JOY_ADC_Y
-      case PrepareJoy_Y: HAL_START_ADC(JOY_Y_PIN); break;
-      case MeasureJoy_Y: ACCUMULATE_ADC(joystick.y); break;
-    #endif
+      #if HAS_JOY_ADC_X
+        case PrepareJoy_X: HAL_START_ADC(JOY_X_PIN); break;
+        case MeasureJoy_X: ACCUMULATE_ADC(joystick.x); break;
+      #endif
 
-    #if HAS_JOY_ADC_Z
-      case PrepareJoy_Z: HAL_START_ADC(JOY_Z_PIN); break;
-      case MeasureJoy_Z: ACCUMULATE_ADC(joystick.z); break;
-    #endif
+      #if HAS_JOY_ADC_Y
+        case PrepareJoy_Y: HAL_START_ADC(JOY_Y_PIN); break;
+        case MeasureJoy_Y: ACCUMULATE_ADC(joystick.y); break;
+      #endif
 
-    #if HAS_ADC_BUTTONS
-      #ifndef ADC_BUTTON_DEBOUNCE_DELAY
-        #define ADC_BUTTON_DEBOUNCE_DELAY 16
+      #if HAS_JOY_ADC_Z
+        case PrepareJoy_Z: HAL_START_ADC(JOY_Z_PIN); break;
+        case MeasureJoy_Z: ACCUMULATE_ADC(joystick.z); break;
       #endif
-      case Prepare_ADC_KEY: HAL_START_ADC(ADC_KEYPAD_PIN); break;
-      case Measure_ADC_KEY:
-        if (!HAL_ADC_READY())
-          next_sensor_state = adc_sensor_state; // redo this state
-        else if (ADCKey_count < ADC_BUTTON_DEBOUNCE_DELAY) {
-          raw_ADCKey_value = HAL_READ_ADC();
-          if (raw_ADCKey_value <= 900UL * HAL_ADC_RANGE / 1024UL) {
-            NOMORE(current_ADCKey_raw, raw_ADCKey_value);
-            ADCKey_count++;
-          }
-          else { //ADC Key release
-            if (ADCKey_count > 0) ADCKey_count++; else ADCKey_pressed = false;
-            if (ADCKey_pressed) {
-              ADCKey_count = 0;
-              current_ADCKey_raw = HAL_ADC_RANGE;
-            }
-          }
-        }
-        if (ADCKey_count == ADC_BUTTON_DEBOUNCE_DELAY) ADCKey_pressed = true;
-        break;
-    #endif // HAS_ADC_BUTTONS
 
-    case StartupDelay: break;
+      #if HAS_ADC_BUTTONS
+        case Prepare_ADC_KEY: HAL_START_ADC(ADC_KEYPAD_PIN); break;
+        case Measure_ADC_KEY:
+          if (!HAL_ADC_READY())
+            next_sensor_state = adc_sensor_state; // redo this state
+          else
+            adc_key_sample(HAL_READ_ADC());
+          break;
+      #endif // HAS_ADC_BUTTONS
+
+      case StartupDelay: break;
+
+    } // switch(adc_sensor_state)
 
-  } // switch(adc_sensor_state)
+    // Go to the next state
+    adc_sensor_state = next_sensor_state;
 
-  // Go to the next state
-  adc_sensor_state = next_sensor_state;
+  #endif // !ADC_SCAN_MODE
 
   //
   // Additional ~1KHz Tasks
@@ -77,6 +77,18 @@ hotend_pid_t;
   typedef IF<(LPQ_MAX_LEN > 255), uint16_t, uint8_t>::type lpq_ptr_t;
 #endif
 
+#if ENABLED(MPCTEMP)
+  // Model Predictive Control storage
+  typedef struct {
+    float heater_power;                 // (W) Heater cartridge power
+    float block_heat_capacity;          // (J/K) Heat capacity of the heater block
+    float sensor_responsiveness;        // (K/s per ∆K) Rate of change of the sensor from the block
+    float ambient_xfer_coeff_fan0;      // (W/K) Heat transfer to ambient with the fan off
+    float fan255_adjustment;            // (W/K) Added heat transfer with the fan on full
+    float filament_heat_capacity_permm; // (J/K/mm) Heat capacity of each mm of filament
+  } MPC_t;
+#endif
+
 #define PID_PARAM(F,H) _PID_##F(TERN(PID_PARAMS_PER_HOTEND, H, 0 & H)) // Always use 'H' to suppress warning
 #define _PID_Kp(H) TERN(PIDTEMP, Temperature::temp_hotend[H].pid.Kp, NAN)
 #define _PID_Ki(H) TERN(PIDTEMP, Temperature::temp_hotend[H].pid.Ki, NAN)
@@ -170,9 +182,16 @@ enum ADCSensorState : char {
 
 #define ACTUAL_ADC_SAMPLES _MAX(int(MIN_ADC_ISR_LOOPS), int(SensorsReady))
 
+// Number of Temperature::ISR loops between temperature readings
+#if ENABLED(ADC_SCAN_MODE)
+  #define TEMP_READING_LOOPS (ADC_SCAN_INTERVAL)
+#else
+  #define TEMP_READING_LOOPS (OVERSAMPLENR * ACTUAL_ADC_SAMPLES)
+#endif
+
 #if HAS_PID_HEATING
   #define PID_K2 (1-float(PID_K1))
-  #define PID_dT ((OVERSAMPLENR * float(ACTUAL_ADC_SAMPLES)) / TEMP_TIMER_FREQUENCY)
+  #define PID_dT (float(TEMP_READING_LOOPS) / TEMP_TIMER_FREQUENCY)
 
   // Apply the scale factors to the PID values
   #define scalePID_i(i)   ( float(i) * PID_dT )
@@ -181,15 +200,44 @@ enum ADCSensorState : char {
   #define unscalePID_d(d) ( float(d) * PID_dT )
 #endif
 
+#if ENABLED(MPCTEMP)
+  #define MPC_dT (float(TEMP_READING_LOOPS) / TEMP_TIMER_FREQUENCY)
+#endif
+
 #if ENABLED(G26_MESH_VALIDATION) && EITHER(HAS_LCD_MENU, EXTENSIBLE_UI)
   #define G26_CLICK_CAN_CANCEL 1
 #endif
 
+#if ENABLED(ADC_SCAN_MODE)
+  // Median-of-3 and IIR filter for the readings of one scanned ADC channel
+  typedef struct ADCScanFilter {
+    #if ENABLED(ADC_SCAN_MEDIAN)
+      uint16_t prev[2];
+    #endif
+    uint32_t iir;   // Filtered reading << ADC_SCAN_IIR_SHIFT
+    bool primed;
+    uint16_t apply(uint16_t v) {
+      #if ENABLED(ADC_SCAN_MEDIAN)
+        if (!primed) prev[0] = prev[1] = v;
+        const uint16_t a = prev[0], b = prev[1];
+        prev[0] = b; prev[1] = v;
+        v = _MAX(_MIN(a, b), _MIN(_MAX(a, b), v));
+      #endif
+      if (!primed) { iir = uint32_t(v) << (ADC_SCAN_IIR_SHIFT); primed = true; }
+      iir += v - (iir >> (ADC_SCAN_IIR_SHIFT));
+      return iir >> (ADC_SCAN_IIR_SHIFT);
+    }
+  } adc_scan_filter_t;
+#endif
+
 // A temperature sensor
 typedef struct TempInfo {
   uint16_t acc;
   int16_t raw;
   celsius_float_t celsius;
+  #if ENABLED(ADC_SCAN_MODE)
+    adc_scan_filter_t filter;
+  #endif
   inline void reset() { acc = 0; }
   inline void sample(const uint16_t s) { acc += s; }
   inline void update() { raw = acc; }
@@ -214,8 +262,20 @@ struct PIDHeaterInfo : public HeaterInfo {
   T pid;  // Initialized by settings.load()
 };
 
+#if ENABLED(MPCTEMP)
+  // A hotend with model predictive control
+  struct MPCHeaterInfo : public HeaterInfo {
+    MPC_t constants;              // Initialized by settings.load()
+    float modeled_block_temp,     // (°C) Heater block temperature, NAN until the model starts
+          modeled_sensor_temp,    // (°C) Sensor temperature, lagging the block
+          modeled_ambient_temp;   // (°C) Surroundings, corrected as the hotend settles
+  };
+#endif
+
 #if ENABLED(PIDTEMP)
   typedef struct PIDHeaterInfo<hotend_pid_t> hotend_info_t;
+#elif ENABLED(MPCTEMP)
+  typedef struct MPCHeaterInfo hotend_info_t;
 #else
   typedef heater_info_t hotend_info_t;
 #endif
@@ -884,6 +944,13 @@ class Temperature {
 
     #endif
 
+    #if ENABLED(MPCTEMP)
+      /**
+       * Measure the hotend model constants in response to M306 T
+       */
+      static void MPC_autotune();
+    #endif
+
     #if ENABLED(PROBING_HEATERS_OFF)
       static void pause_heaters(const bool p);
     #endif
@@ -933,10 +1000,15 @@ class Temperature {
     static inline bool updateTemperaturesIfReady() {
       if (!raw_temps_ready) return false;
       updateTemperaturesFromRawValues();
+      reading_intervals = raw_reading_intervals;
       raw_temps_ready = false;
       return true;
     }
 
+    // Reading intervals since the readings before. More than one when a slow
+    // main loop left readings unused, so the PID and MPC time step is longer.
+    static uint8_t raw_reading_intervals, reading_intervals;
+
     // MAX Thermocouples
     #if HAS_MAX_TC
       #define MAX_TC_COUNT COUNT_ENABLED(TEMP_SENSOR_0_IS_MAX_TC, TEMP_SENSOR_1_IS_MAX_TC, TEMP_SENSOR_REDUNDANT_IS_MAX_TC)
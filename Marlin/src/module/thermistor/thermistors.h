@@ -335,6 +335,131 @@ static_assert(255 > TEMPTABLE_0_LEN || 255 > TEMPTABLE_1_LEN || 255 > TEMPTABLE_
   , "Temperature conversion tables over 255 entries need special consideration."
 );
 
+/**
+ * Bisect search for the range of the 'raw' value, then interpolate
+ * proportionally between the under and over values.
+ */
+#define SCAN_THERMISTOR_TABLE(TBL,LEN) do{                                \
+  uint8_t l = 0, r = LEN, m;                                              \
+  for (;;) {                                                              \
+    m = (l + r) >> 1;                                                     \
+    if (!m) return celsius_t(pgm_read_word(&TBL[0].celsius));             \
+    if (m == l || m == r) return celsius_t(pgm_read_word(&TBL[LEN-1].celsius)); \
+    int16_t v00 = pgm_read_word(&TBL[m-1].value),                         \
+            v10 = pgm_read_word(&TBL[m-0].value);                         \
+         if (raw < v00) r = m;                                            \
+    else if (raw > v10) l = m;                                            \
+    else {                                                                \
+      const celsius_t v01 = celsius_t(pgm_read_word(&TBL[m-1].celsius)),  \
+                      v11 = celsius_t(pgm_read_word(&TBL[m-0].celsius));  \
+      return v01 + (raw - v00) * float(v11 - v01) / float(v10 - v00);     \
+    }                                                                     \
+  }                                                                       \
+}while(0)
+
+/**
+ * Direct-index thermistor tables
+ *
+ * At compile time, SCAN_THERMISTOR_TABLE is evaluated at every table ADC count
+ * (every OV(1) raw) and stored in 1/16 degrees. Most table points lie on this
+ * grid, so interpolating between two entries gives the same line segment the
+ * scan would, and a reading needs no search and no divide.
+ *
+ * A cell with a table point between two counts (e.g. OV(17.5)) or with a step
+ * (two points with the same value) has a bend the entries can't follow, so it
+ * is flagged and read with the table search instead.
+ */
+#if __cplusplus >= 201402L // Loops in constexpr functions need C++14
+
+#define THERMISTOR_INDEX_STEP     OV(1)   // Raw counts per entry
+#define THERMISTOR_INDEX_FRACTION 4       // 1/16 degree
+
+constexpr uint8_t thermistor_index_shift(const int16_t step, const uint8_t shift=0) {
+  return step > 1 ? thermistor_index_shift(step >> 1, shift + 1) : shift;
+}
+constexpr uint8_t THERMISTOR_INDEX_SHIFT = thermistor_index_shift(THERMISTOR_INDEX_STEP);
+constexpr uint16_t THERMISTOR_INDEX_LEN = (MAX_RAW_THERMISTOR_VALUE >> THERMISTOR_INDEX_SHIFT) + 2;
+
+typedef struct {
+  int16_t celsius[THERMISTOR_INDEX_LEN];        // Table temperature at each count, in 1/16 degrees
+  uint8_t scan[(THERMISTOR_INDEX_LEN + 7) / 8]; // Cells that need the table search
+} thermistor_index_t;
+
+// SCAN_THERMISTOR_TABLE for constexpr tables, in the same order of operations
+constexpr float thermistor_table_scan(const temp_entry_t * const tbl, const uint8_t len, const int32_t raw) {
+  uint8_t l = 0, r = len;
+  for (;;) {
+    const uint8_t m = (l + r) >> 1;
+    if (!m) return tbl[0].celsius;
+    if (m == l || m == r) return tbl[len - 1].celsius;
+    const int16_t v00 = tbl[m - 1].value, v10 = tbl[m].value;
+         if (raw < v00) r = m;
+    else if (raw > v10) l = m;
+    else {
+      const celsius_t v01 = tbl[m - 1].celsius, v11 = tbl[m].celsius;
+      return v01 + (raw - v00) * float(v11 - v01) / float(v10 - v00);
+    }
+  }
+}
+
+template<const temp_entry_t *TBL, uint8_t LEN>
+struct ThermistorIndex {
+  static constexpr thermistor_index_t build() {
+    thermistor_index_t t{};
+    for (uint16_t i = 0; i < THERMISTOR_INDEX_LEN; i++) {
+      const float c = thermistor_table_scan(TBL, LEN, int32_t(i) << THERMISTOR_INDEX_SHIFT) * _BV(THERMISTOR_INDEX_FRACTION);
+      t.celsius[i] = int16_t(c < 0 ? c - 0.5f : c + 0.5f);
+    }
+    for (uint8_t j = 0; j < LEN; j++) {
+      const int16_t v = TBL[j].value, i = v >> THERMISTOR_INDEX_SHIFT;
+      if (v & (THERMISTOR_INDEX_STEP - 1))
+        t.scan[i >> 3] |= _BV(i & 7);
+      else if (j && TBL[j - 1].value == v) {
+        t.scan[i >> 3] |= _BV(i & 7);
+        if (i) t.scan[(i - 1) >> 3] |= _BV((i - 1) & 7);
+      }
+    }
+    return t;
+  }
+  static constexpr thermistor_index_t table PROGMEM = build();
+};
+
+// Definition for pre-C++17 compilers, where a static constexpr member isn't inline
+template<const temp_entry_t *TBL, uint8_t LEN>
+constexpr thermistor_index_t ThermistorIndex<TBL, LEN>::table;
+
+// The index table for a sensor, or nullptr if it has no conversion table
+template<const temp_entry_t *TBL, uint8_t LEN, bool = (LEN > 1)>
+struct ThermistorIndexPtr { static constexpr const thermistor_index_t* get() { return &ThermistorIndex<TBL, LEN>::table; } };
+template<const temp_entry_t *TBL, uint8_t LEN>
+struct ThermistorIndexPtr<TBL, LEN, false> { static constexpr const thermistor_index_t* get() { return nullptr; } };
+
+template<const temp_entry_t *TBL, uint8_t LEN>
+constexpr const thermistor_index_t* thermistor_index() { return ThermistorIndexPtr<TBL, LEN>::get(); }
+
+// Interpolate between the two entries around 'raw'. Return false if the table search is needed.
+FORCE_INLINE bool thermistor_index_lookup(const thermistor_index_t &t, const int16_t raw, celsius_float_t &celsius) {
+  const uint16_t r = constrain(raw, 0, int16_t(MAX_RAW_THERMISTOR_VALUE)), i = r >> THERMISTOR_INDEX_SHIFT;
+  if (TEST(pgm_read_byte(&t.scan[i >> 3]), i & 7)) return false;
+  const int16_t c0 = pgm_read_word(&t.celsius[i]), c1 = pgm_read_word(&t.celsius[i + 1]);
+  const int32_t c = (int32_t(c0) << THERMISTOR_INDEX_SHIFT) + int32_t(c1 - c0) * (r & (THERMISTOR_INDEX_STEP - 1));
+  celsius = c * (1.0f / _BV32(THERMISTOR_INDEX_SHIFT + THERMISTOR_INDEX_FRACTION));
+  return true;
+}
+
+#endif // __cplusplus >= 201402L
+
+#if ENABLED(THERMISTOR_DIRECT_INDEX)
+  static_assert(THERMISTOR_INDEX_STEP == _BV(THERMISTOR_INDEX_SHIFT), "THERMISTOR_DIRECT_INDEX requires OVERSAMPLENR * THERMISTOR_TABLE_SCALE to be a power of 2.");
+  #define LOOKUP_THERMISTOR_TABLE(TBL,LEN) do{                  \
+    celsius_float_t celsius;                                    \
+    if (thermistor_index_lookup(*thermistor_index<TBL, LEN>(), raw, celsius)) return celsius; \
+    SCAN_THERMISTOR_TABLE(TBL,LEN);                             \
+  }while(0)
+#else
+  #define LOOKUP_THERMISTOR_TABLE(TBL,LEN) SCAN_THERMISTOR_TABLE(TBL,LEN)
+#endif
+
 // Set the high and low raw values for the heaters
 // For thermistors the highest temperature results in the lowest ADC value
 // For thermocouples the highest temperature results in the highest ADC value
@@ -378,6 +378,26 @@ bool DiskIODriver_SPI_SD::readBlock(uint32_t blockNumber, uint8_t *dst) {
   #endif
 }
 
+/**
+ * Read consecutive 512 byte blocks from an SD card with CMD18.
+ * Falls back to single block reads (with their retries) on failure.
+ *
+ * \param[in] blockNumber Logical block to start reading.
+ * \param[out] dst Pointer to the location that will receive the data.
+ * \param[in] count Number of blocks to read.
+ * \return true for success, false for failure.
+ */
+bool DiskIODriver_SPI_SD::readBlocks(uint32_t blockNumber, uint8_t *dst, const uint8_t count) {
+  #if !(IS_TEENSY_35_36 || IS_TEENSY_40_41)     // The SDHC interface reads one block at a time
+    if (DiskIODriver::readBlocks(blockNumber, dst, count)) return true;
+    if (DISABLED(SD_CHECK_AND_RETRY)) return false;
+    errorCode_ = 0;
+  #endif
+  for (uint8_t i = 0; i < count; i++, dst += 512)
+    if (!readBlock(blockNumber + i, dst)) return false;
+  return true;
+}
+
 /**
  * Read one data block in a multiple block read sequence
  *
@@ -164,6 +164,7 @@ public:
   bool writeStop() override;
 
   bool readBlock(uint32_t block, uint8_t *dst) override;
+  bool readBlocks(uint32_t block, uint8_t *dst, const uint8_t count) override;
   bool writeBlock(uint32_t blockNumber, const uint8_t *src) override;
 
   uint32_t cardSize() override;
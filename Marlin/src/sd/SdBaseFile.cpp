@@ -45,11 +45,18 @@ SdBaseFile *SdBaseFile::cwd_ = 0;   // Pointer to Current Working Directory
 // callback function for date/time
 void (*SdBaseFile::dateTime_)(uint16_t *date, uint16_t *time) = 0;
 
-// add a cluster to a file
-bool SdBaseFile::addCluster() {
+// add a cluster to a file, claiming 'count' clusters together if they can be found.
+// Each failed claim scans the whole FAT, so after one failure the file stops trying.
+bool SdBaseFile::addCluster(const uint8_t count/*=1*/) {
   if (ENABLED(SDCARD_READONLY)) return false;
 
-  if (!vol_->allocContiguous(1, &curCluster_)) return false;
+  const bool prealloc = count > 1 && !(flags_ & F_FILE_NO_PREALLOC);
+  if (prealloc && vol_->allocContiguous(count, &curCluster_))
+    flags_ |= F_FILE_PREALLOC;            // close() frees the clusters that go unused
+  else {
+    if (prealloc) flags_ |= F_FILE_NO_PREALLOC;
+    if (!vol_->allocContiguous(1, &curCluster_)) return false;
+  }
 
   // if first cluster of file link to directory entry
   if (firstCluster_ == 0) {
@@ -74,14 +81,14 @@ bool SdBaseFile::addDirCluster() {
   block = vol_->clusterStartBlock(curCluster_);
 
   // set cache to first block of cluster
-  vol_->cacheSetBlockNumber(block, true);
+  if (!vol_->cacheSetBlockNumber(block, true)) return false;
 
   // zero first block of cluster
-  memset(vol_->cacheBuffer_.data, 0, 512);
+  memset(vol_->cache()->data, 0, 512);
 
   // zero rest of cluster
   for (uint8_t i = 1; i < vol_->blocksPerCluster_; i++) {
-    if (!vol_->writeBlock(block + i, vol_->cacheBuffer_.data)) return false;
+    if (!vol_->writeBlock(block + i, vol_->cache()->data)) return false;
   }
   // Increase directory file size by cluster size
   fileSize_ += 512UL << vol_->clusterSizeShift_;
@@ -91,7 +98,7 @@ bool SdBaseFile::addDirCluster() {
 // cache a file's directory entry
 // return pointer to cached entry or null for failure
 dir_t* SdBaseFile::cacheDirEntry(uint8_t action) {
-  if (!vol_->cacheRawBlock(dirBlock_, action)) return nullptr;
+  if (!vol_->cacheRawBlock(dirBlock_, action, SdVolume::CACHE_PRIORITY_DIR)) return nullptr;
   return vol_->cache()->dir + dirIndex_;
 }
 
@@ -103,7 +110,16 @@ dir_t* SdBaseFile::cacheDirEntry(uint8_t action) {
  * Reasons for failure include no file is open or an I/O error.
  */
 bool SdBaseFile::close() {
-  bool rtn = sync();
+  bool rtn = true;
+  #if HAS_SD_PREALLOCATE
+    // free clusters claimed past the end of the file
+    if ((flags_ & F_FILE_PREALLOC) && isOpen()) {
+      flags_ &= ~F_FILE_PREALLOC;
+      rtn = truncate(fileSize_);
+    }
+  #endif
+  // flush data and the directory entry even if the truncate failed
+  if (!sync()) rtn = false;
   type_ = FAT_FILE_TYPE_CLOSED;
   return rtn;
 }
@@ -487,7 +503,7 @@ bool SdBaseFile::mkdir(SdBaseFile *parent, const uint8_t dname[11]) {
 
   // cache block for '.'  and '..'
   uint32_t block = vol_->clusterStartBlock(firstCluster_);
-  if (!vol_->cacheRawBlock(block, SdVolume::CACHE_FOR_WRITE)) return false;
+  if (!vol_->cacheRawBlock(block, SdVolume::CACHE_FOR_WRITE, SdVolume::CACHE_PRIORITY_DIR)) return false;
 
   // copy '.' to block
   memcpy(&vol_->cache()->dir[0], &d, sizeof(d));
@@ -838,9 +854,9 @@ bool SdBaseFile::openParent(SdBaseFile *dir) {
   // start block for '..'
   lbn = vol_->clusterStartBlock(cluster);
   // first block of parent dir
-  if (!vol_->cacheRawBlock(lbn, SdVolume::CACHE_FOR_READ)) return false;
+  if (!vol_->cacheRawBlock(lbn, SdVolume::CACHE_FOR_READ, SdVolume::CACHE_PRIORITY_DIR)) return false;
 
-  dir_t *p = &vol_->cacheBuffer_.dir[1];
+  dir_t *p = &vol_->cache()->dir[1];
   // verify name for '../..'
   if (p->name[0] != '.' || p->name[1] != '.') return false;
   // '..' is pointer to first cluster of parent. open '../..' to find parent
@@ -1032,13 +1048,29 @@ int16_t SdBaseFile::read(void *buf, uint16_t nbyte) {
     // amount to be read from current block
     NOMORE(n, 512 - offset);
 
+    // whole blocks left in this cluster can be read in one multiple block read,
+    // stopping short of any cached block, which may hold unwritten data
+    uint8_t nblocks = 0;
+    if (n == 512) {
+      nblocks = 1;
+      if (type_ != FAT_FILE_TYPE_ROOT_FIXED) {
+        const uint8_t blocksLeft = vol_->blocksPerCluster() - vol_->blockOfCluster(curPosition_);
+        nblocks = _MIN(toRead >> 9, blocksLeft);
+      }
+      nblocks = vol_->cacheUncached(block, nblocks);
+    }
+
     // no buffering needed if n == 512
-    if (n == 512 && block != vol_->cacheBlockNumber()) {
+    if (nblocks > 1) {
+      if (!vol_->readBlocks(block, dst, nblocks)) return -1;
+      n = uint16_t(nblocks) << 9;
+    }
+    else if (nblocks) {
       if (!vol_->readBlock(block, dst)) return -1;
     }
     else {
       // read block to cache and copy data to caller
-      if (!vol_->cacheRawBlock(block, SdVolume::CACHE_FOR_READ)) return -1;
+      if (!vol_->cacheRawBlock(block, SdVolume::CACHE_FOR_READ, isDir() ? SdVolume::CACHE_PRIORITY_DIR : SdVolume::CACHE_PRIORITY_DATA)) return -1;
       uint8_t *src = vol_->cache()->data + offset;
       memcpy(dst, src, n);
     }
@@ -1328,7 +1360,7 @@ bool SdBaseFile::rename(SdBaseFile *dirFile, const char *newPath) {
   if (dirCluster) {
     // get new dot dot
     uint32_t block = vol_->clusterStartBlock(dirCluster);
-    if (!vol_->cacheRawBlock(block, SdVolume::CACHE_FOR_READ)) return false;
+    if (!vol_->cacheRawBlock(block, SdVolume::CACHE_FOR_READ, SdVolume::CACHE_PRIORITY_DIR)) return false;
     memcpy(&entry, &vol_->cache()->dir[1], sizeof(entry));
 
     // free unused cluster
@@ -1336,7 +1368,7 @@ bool SdBaseFile::rename(SdBaseFile *dirFile, const char *newPath) {
 
     // store new dot dot
     block = vol_->clusterStartBlock(firstCluster_);
-    if (!vol_->cacheRawBlock(block, SdVolume::CACHE_FOR_WRITE)) return false;
+    if (!vol_->cacheRawBlock(block, SdVolume::CACHE_FOR_WRITE, SdVolume::CACHE_PRIORITY_DIR)) return false;
     memcpy(&vol_->cache()->dir[1], &entry, sizeof(entry));
   }
   return vol_->cacheFlush();
@@ -1537,7 +1569,7 @@ bool SdBaseFile::sync() {
     // clear directory dirty
     flags_ &= ~F_FILE_DIR_DIRTY;
   }
-  return vol_->cacheFlush();
+  return TERN1(HAS_SD_PREALLOCATE, vol_->streamStop()) && vol_->cacheFlush();
 
   FAIL:
   writeError = true;
@@ -1754,7 +1786,7 @@ int16_t SdBaseFile::write(const void *buf, uint16_t nbyte) {
       if (curCluster_ == 0) {
         if (firstCluster_ == 0) {
           // allocate first cluster of file
-          if (!addCluster()) goto FAIL;
+          if (!addCluster(TERN(HAS_SD_PREALLOCATE, SD_PREALLOCATE_CLUSTERS, 1))) goto FAIL;
         }
         else {
           curCluster_ = firstCluster_;
@@ -1765,7 +1797,7 @@ int16_t SdBaseFile::write(const void *buf, uint16_t nbyte) {
         if (!vol_->fatGet(curCluster_, &next)) goto FAIL;
         if (vol_->isEOC(next)) {
           // add cluster if at end of chain
-          if (!addCluster()) goto FAIL;
+          if (!addCluster(TERN(HAS_SD_PREALLOCATE, SD_PREALLOCATE_CLUSTERS, 1))) goto FAIL;
         }
         else {
           curCluster_ = next;
@@ -1782,18 +1814,21 @@ int16_t SdBaseFile::write(const void *buf, uint16_t nbyte) {
     uint32_t block = vol_->clusterStartBlock(curCluster_) + blockOfCluster;
     if (n == 512) {
       // full block - don't need to use cache
-      if (vol_->cacheBlockNumber() == block) {
-        // invalidate cache if block is in cache
-        vol_->cacheSetBlockNumber(0xFFFFFFFF, false);
-      }
-      if (!vol_->writeBlock(block, src)) goto FAIL;
+      // invalidate cache if block is in cache
+      vol_->cacheInvalidate(block);
+      #if HAS_SD_PREALLOCATE
+        // stream consecutive blocks, pre-erasing the rest of the cluster
+        if (!vol_->writeDataBlock(block, src, vol_->blocksPerCluster_ - blockOfCluster)) goto FAIL;
+      #else
+        if (!vol_->writeBlock(block, src)) goto FAIL;
+      #endif
     }
     else {
       if (blockOffset == 0 && curPosition_ >= fileSize_) {
         // start of new block don't need to read into cache
         if (!vol_->cacheFlush()) goto FAIL;
         // set cache dirty and SD address of block
-        vol_->cacheSetBlockNumber(block, true);
+        if (!vol_->cacheSetBlockNumber(block, true)) goto FAIL;
       }
       else {
         // rewrite part of block
@@ -352,6 +352,8 @@ class SdBaseFile {
 
   // bits defined in flags_
   static uint8_t const F_OFLAG = (O_ACCMODE | O_APPEND | O_SYNC),   // should be 0x0F
+                       F_FILE_NO_PREALLOC = 0x20,                   // a contiguous claim failed, so add single clusters
+                       F_FILE_PREALLOC = 0x40,                      // clusters were claimed past the end of the file
                        F_FILE_DIR_DIRTY = 0x80;                     // sync of directory entry required
 
   // private data
@@ -372,7 +374,7 @@ class SdBaseFile {
   //bool openParent(SdBaseFile *dir);
 
   // private functions
-  bool addCluster();
+  bool addCluster(const uint8_t count=1);
   bool addDirCluster();
   dir_t* cacheDirEntry(uint8_t action);
   int8_t lsPrintNext(uint8_t flags, uint8_t indent);
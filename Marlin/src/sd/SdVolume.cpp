@@ -39,11 +39,18 @@
 
 #if !USE_MULTIPLE_CARDS
   // raw block cache
-  uint32_t SdVolume::cacheBlockNumber_;  // current block number
-  cache_t  SdVolume::cacheBuffer_;       // 512 byte cache for Sd2Card
-  DiskIODriver *SdVolume::sdCard_;       // pointer to SD card object
-  bool     SdVolume::cacheDirty_;        // cacheFlush() will write block if true
-  uint32_t SdVolume::cacheMirrorBlock_;  // mirror  block for second FAT
+  cache_t       SdVolume::cacheBuffer_[SD_CACHE_BLOCKS];  // 512 byte caches for Sd2Card
+  cache_entry_t SdVolume::cacheEntry_[SD_CACHE_BLOCKS];   // block number and state of each cache
+  uint8_t       SdVolume::cacheIndex_;                    // cache used by the last access
+  uint32_t      SdVolume::cacheUseCount_;                 // cache accesses, for LRU
+  DiskIODriver *SdVolume::sdCard_;                        // pointer to SD card object
+  #if HAS_SD_PREALLOCATE
+    uint32_t    SdVolume::streamBlock_;                   // next block of an open multiple block write
+  #endif
+#endif
+
+#if HAS_SD_BLOCK_CACHE
+  cache_stats_t SdVolume::cacheStats_;
 #endif
 
 // find a contiguous group of clusters
@@ -120,31 +127,122 @@ bool SdVolume::allocContiguous(uint32_t count, uint32_t *curCluster) {
   return true;
 }
 
-bool SdVolume::cacheFlush() {
+#if HAS_SD_PREALLOCATE
+
+  // end an open multiple block write so the card can take other commands
+  bool SdVolume::streamStop() {
+    if (!streamBlock_) return true;
+    streamBlock_ = 0;
+    return sdCard_->writeStop();
+  }
+
+  /**
+   * Write a block of file data. Consecutive blocks go to the card as one
+   * multiple block write, which is left open so the card can program each
+   * block while the caller gets on with other work. A new multiple block
+   * write asks the card to pre-erase 'eraseCount' blocks.
+   */
+  bool SdVolume::writeDataBlock(const uint32_t block, const uint8_t *src, const uint32_t eraseCount) {
+    if (block != streamBlock_) {
+      if (!streamStop()) return false;
+      if (!sdCard_->writeStart(block, eraseCount)) return false;
+    }
+    streamBlock_ = block + 1;
+    if (!sdCard_->writeData(src)) {
+      streamStop();
+      return false;
+    }
+    return true;
+  }
+
+#endif
+
+// write a dirty cache to the card, along with its FAT mirror
+bool SdVolume::cacheWriteEntry(const uint8_t i) {
   #if DISABLED(SDCARD_READONLY)
-    if (cacheDirty_) {
-      if (!sdCard_->writeBlock(cacheBlockNumber_, cacheBuffer_.data))
+    cache_entry_t &e = cacheEntry_[i];
+    if (e.dirty) {
+      if (TERN0(HAS_SD_PREALLOCATE, !streamStop())) return false;
+      if (!sdCard_->writeBlock(e.block, cacheBuffer_[i].data))
         return false;
 
       // mirror FAT tables
-      if (cacheMirrorBlock_) {
-        if (!sdCard_->writeBlock(cacheMirrorBlock_, cacheBuffer_.data))
+      if (e.mirrorBlock) {
+        if (!sdCard_->writeBlock(e.mirrorBlock, cacheBuffer_[i].data))
           return false;
-        cacheMirrorBlock_ = 0;
+        e.mirrorBlock = 0;
       }
-      cacheDirty_ = 0;
+      e.dirty = false;
+      TERN_(HAS_SD_BLOCK_CACHE, cacheStats_.writes++);
     }
   #endif
   return true;
 }
 
-bool SdVolume::cacheRawBlock(uint32_t blockNumber, bool dirty) {
-  if (cacheBlockNumber_ != blockNumber) {
-    if (!cacheFlush()) return false;
-    if (!sdCard_->readBlock(blockNumber, cacheBuffer_.data)) return false;
-    cacheBlockNumber_ = blockNumber;
+bool SdVolume::cacheFlush() {
+  LOOP_L_N(i, SD_CACHE_BLOCKS)
+    if (!cacheWriteEntry(i)) return false;
+  return true;
+}
+
+// pick a cache to reuse: an empty one, else the least recently used,
+// with each priority level worth SD_CACHE_BLOCKS more recent accesses
+uint8_t SdVolume::cacheVictim() {
+  uint8_t victim = 0;
+  uint32_t oldest = 0;
+  LOOP_L_N(i, SD_CACHE_BLOCKS) {
+    const cache_entry_t &e = cacheEntry_[i];
+    if (e.block == 0xFFFFFFFF) return i;
+    const uint32_t age = cacheUseCount_ - e.lastUse, bonus = uint32_t(e.priority) * SD_CACHE_BLOCKS;
+    const uint32_t score = age > bonus ? age - bonus : 0;
+    if (score >= oldest) { oldest = score; victim = i; }
   }
-  if (dirty) cacheDirty_ = true;
+  return victim;
+}
+
+bool SdVolume::cacheRawBlock(uint32_t blockNumber, bool dirty, const uint8_t priority/*=CACHE_PRIORITY_DATA*/) {
+  // check the last used cache first
+  uint8_t i = cacheIndex_;
+  if (cacheEntry_[i].block != blockNumber)
+    for (i = 0; i < SD_CACHE_BLOCKS && cacheEntry_[i].block != blockNumber; i++) { /* nada */ }
+
+  if (i == SD_CACHE_BLOCKS) {
+    TERN_(HAS_SD_BLOCK_CACHE, cacheStats_.misses[priority]++);
+    i = cacheVictim();
+    if (!cacheWriteEntry(i)) return false;
+    cacheEntry_[i].block = 0xFFFFFFFF;
+    if (TERN0(HAS_SD_PREALLOCATE, !streamStop())) return false;
+    if (!sdCard_->readBlock(blockNumber, cacheBuffer_[i].data)) return false;
+    cacheEntry_[i].block = blockNumber;
+    cacheEntry_[i].mirrorBlock = 0;
+    cacheEntry_[i].priority = priority;
+  }
+  #if HAS_SD_BLOCK_CACHE
+    else
+      cacheStats_.hits[priority]++;
+  #endif
+
+  cache_entry_t &e = cacheEntry_[i];
+  NOLESS(e.priority, priority);
+  e.lastUse = ++cacheUseCount_;
+  if (dirty) e.dirty = true;
+  cacheIndex_ = i;
+  return true;
+}
+
+// used by SdBaseFile write to assign a cache to an SD block without reading it
+bool SdVolume::cacheSetBlockNumber(uint32_t blockNumber, bool dirty) {
+  LOOP_L_N(i, SD_CACHE_BLOCKS)
+    if (cacheEntry_[i].block == blockNumber) { cacheEntry_[i].block = 0xFFFFFFFF; cacheEntry_[i].dirty = false; }
+  const uint8_t i = cacheVictim();
+  if (!cacheWriteEntry(i)) return false;
+  cache_entry_t &e = cacheEntry_[i];
+  e.block = blockNumber;
+  e.mirrorBlock = 0;
+  e.priority = CACHE_PRIORITY_DATA;
+  e.lastUse = ++cacheUseCount_;
+  e.dirty = dirty;
+  cacheIndex_ = i;
   return true;
 }
 
@@ -167,15 +265,15 @@ bool SdVolume::fatGet(uint32_t cluster, uint32_t *value) {
     uint16_t index = cluster;
     index += index >> 1;
     lba = fatStartBlock_ + (index >> 9);
-    if (!cacheRawBlock(lba, CACHE_FOR_READ)) return false;
+    if (!cacheRawBlock(lba, CACHE_FOR_READ, CACHE_PRIORITY_FAT)) return false;
     index &= 0x1FF;
-    uint16_t tmp = cacheBuffer_.data[index];
+    uint16_t tmp = cache()->data[index];
     index++;
     if (index == 512) {
-      if (!cacheRawBlock(lba + 1, CACHE_FOR_READ)) return false;
+      if (!cacheRawBlock(lba + 1, CACHE_FOR_READ, CACHE_PRIORITY_FAT)) return false;
       index = 0;
     }
-    tmp |= cacheBuffer_.data[index] << 8;
+    tmp |= cache()->data[index] << 8;
     *value = cluster & 1 ? tmp >> 4 : tmp & 0xFFF;
     return true;
   }
@@ -187,10 +285,10 @@ bool SdVolume::fatGet(uint32_t cluster, uint32_t *value) {
   else
     return false;
 
-  if (lba != cacheBlockNumber_ && !cacheRawBlock(lba, CACHE_FOR_READ))
+  if (!cacheRawBlock(lba, CACHE_FOR_READ, CACHE_PRIORITY_FAT))
     return false;
 
-  *value = (fatType_ == 16) ? cacheBuffer_.fat16[cluster & 0xFF] : (cacheBuffer_.fat32[cluster & 0x7F] & FAT32MASK);
+  *value = (fatType_ == 16) ? cache()->fat16[cluster & 0xFF] : (cache()->fat32[cluster & 0x7F] & FAT32MASK);
   return true;
 }
 
@@ -209,28 +307,28 @@ bool SdVolume::fatPut(uint32_t cluster, uint32_t value) {
     uint16_t index = cluster;
     index += index >> 1;
     lba = fatStartBlock_ + (index >> 9);
-    if (!cacheRawBlock(lba, CACHE_FOR_WRITE)) return false;
+    if (!cacheRawBlock(lba, CACHE_FOR_WRITE, CACHE_PRIORITY_FAT)) return false;
     // mirror second FAT
-    if (fatCount_ > 1) cacheMirrorBlock_ = lba + blocksPerFat_;
+    if (fatCount_ > 1) cacheSetMirror(lba + blocksPerFat_);
     index &= 0x1FF;
     uint8_t tmp = value;
     if (cluster & 1) {
-      tmp = (cacheBuffer_.data[index] & 0xF) | tmp << 4;
+      tmp = (cache()->data[index] & 0xF) | tmp << 4;
     }
-    cacheBuffer_.data[index] = tmp;
+    cache()->data[index] = tmp;
     index++;
     if (index == 512) {
       lba++;
       index = 0;
-      if (!cacheRawBlock(lba, CACHE_FOR_WRITE)) return false;
+      if (!cacheRawBlock(lba, CACHE_FOR_WRITE, CACHE_PRIORITY_FAT)) return false;
       // mirror second FAT
-      if (fatCount_ > 1) cacheMirrorBlock_ = lba + blocksPerFat_;
+      if (fatCount_ > 1) cacheSetMirror(lba + blocksPerFat_);
     }
     tmp = value >> 4;
     if (!(cluster & 1)) {
-      tmp = ((cacheBuffer_.data[index] & 0xF0)) | tmp >> 4;
+      tmp = ((cache()->data[index] & 0xF0)) | tmp >> 4;
     }
-    cacheBuffer_.data[index] = tmp;
+    cache()->data[index] = tmp;
     return true;
   }
 
@@ -241,16 +339,16 @@ bool SdVolume::fatPut(uint32_t cluster, uint32_t value) {
   else
     return false;
 
-  if (!cacheRawBlock(lba, CACHE_FOR_WRITE)) return false;
+  if (!cacheRawBlock(lba, CACHE_FOR_WRITE, CACHE_PRIORITY_FAT)) return false;
 
   // store entry
   if (fatType_ == 16)
-    cacheBuffer_.fat16[cluster & 0xFF] = value;
+    cache()->fat16[cluster & 0xFF] = value;
   else
-    cacheBuffer_.fat32[cluster & 0x7F] = value;
+    cache()->fat32[cluster & 0x7F] = value;
 
   // mirror second FAT
-  if (fatCount_ > 1) cacheMirrorBlock_ = lba + blocksPerFat_;
+  if (fatCount_ > 1) cacheSetMirror(lba + blocksPerFat_);
   return true;
 }
 
@@ -289,15 +387,15 @@ int32_t SdVolume::freeClusterCount() {
     return -1;
 
   for (uint32_t lba = fatStartBlock_; todo; todo -= n, lba++) {
-    if (!cacheRawBlock(lba, CACHE_FOR_READ)) return -1;
+    if (!cacheRawBlock(lba, CACHE_FOR_READ, CACHE_PRIORITY_FAT)) return -1;
     NOMORE(n, todo);
     if (fatType_ == 16) {
       for (uint16_t i = 0; i < n; i++)
-        if (cacheBuffer_.fat16[i] == 0) free++;
+        if (cache()->fat16[i] == 0) free++;
     }
     else {
       for (uint16_t i = 0; i < n; i++)
-        if (cacheBuffer_.fat32[i] == 0) free++;
+        if (cache()->fat32[i] == 0) free++;
     }
     #ifdef ESP32
       // Needed to reset the idle task watchdog timer on ESP32 as reading the complete FAT may easily
@@ -331,24 +429,25 @@ bool SdVolume::init(DiskIODriver* dev, uint8_t part) {
   fat32_boot_t *fbs;
 
   sdCard_ = dev;
+  TERN_(HAS_SD_PREALLOCATE, streamBlock_ = 0);
   fatType_ = 0;
   allocSearchStart_ = 2;
-  cacheDirty_ = 0;  // cacheFlush() will write block if true
-  cacheMirrorBlock_ = 0;
-  cacheBlockNumber_ = 0xFFFFFFFF;
+  LOOP_L_N(i, SD_CACHE_BLOCKS) cacheEntry_[i] = { 0xFFFFFFFF, 0, 0, CACHE_PRIORITY_DATA, false };
+  cacheIndex_ = 0;
+  cacheUseCount_ = 0;
 
   // if part == 0 assume super floppy with FAT boot sector in block zero
   // if part > 0 assume mbr volume with partition table
   if (part) {
     if (part > 4) return false;
     if (!cacheRawBlock(volumeStartBlock, CACHE_FOR_READ)) return false;
-    part_t *p = &cacheBuffer_.mbr.part[part - 1];
+    part_t *p = &cache()->mbr.part[part - 1];
     if ((p->boot & 0x7F) != 0  || p->totalSectors < 100 || p->firstSector == 0)
       return false; // not a valid partition
     volumeStartBlock = p->firstSector;
   }
   if (!cacheRawBlock(volumeStartBlock, CACHE_FOR_READ)) return false;
-  fbs = &cacheBuffer_.fbs32;
+  fbs = &cache()->fbs32;
   if (fbs->bytesPerSector != 512 ||
       fbs->fatCount == 0 ||
       fbs->reservedSectorCount == 0 ||
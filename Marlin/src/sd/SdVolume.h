@@ -47,6 +47,10 @@
 #include "SdFatConfig.h"
 #include "SdFatStructs.h"
 
+#ifndef SD_CACHE_BLOCKS
+  #define SD_CACHE_BLOCKS 1
+#endif
+
 //==============================================================================
 // SdVolume class
 
@@ -64,6 +68,26 @@ union cache_t {
   fat32_fsinfo_t  fsinfo;     // Used to access to a cached FAT32 FSINFO sector.
 };
 
+/**
+ * \brief State of one block in the cache
+ */
+struct cache_entry_t {
+  uint32_t block;             // Logical number of the cached block
+  uint32_t mirrorBlock;       // Block number for mirror FAT
+  uint32_t lastUse;           // Cache access count at the last use
+  uint8_t priority;           // CACHE_PRIORITY_* of the last use
+  bool dirty;                 // cacheFlush() will write block if true
+};
+
+#if HAS_SD_BLOCK_CACHE
+  /**
+   * \brief Block cache hit and miss counters, by priority
+   */
+  struct cache_stats_t {
+    uint32_t hits[3], misses[3], writes;
+  };
+#endif
+
 /**
  * \class SdVolume
  * \brief Access FAT16 and FAT32 volumes on SD and SDHC cards.
@@ -79,10 +103,21 @@ class SdVolume {
    */
   cache_t* cacheClear() {
     if (!cacheFlush()) return 0;
-    cacheBlockNumber_ = 0xFFFFFFFF;
-    return &cacheBuffer_;
+    LOOP_L_N(i, SD_CACHE_BLOCKS) cacheEntry_[i].block = 0xFFFFFFFF;
+    cacheIndex_ = 0;
+    return &cacheBuffer_[0];
   }
 
+  // priority argument for cacheRawBlock. Higher priority blocks stay cached longer.
+  static uint8_t const CACHE_PRIORITY_DATA = 0;
+  static uint8_t const CACHE_PRIORITY_DIR = 1;
+  static uint8_t const CACHE_PRIORITY_FAT = 2;
+
+  #if HAS_SD_BLOCK_CACHE
+    static const cache_stats_t& cacheStats() { return cacheStats_; }
+    static void cacheResetStats() { cacheStats_ = {}; }
+  #endif
+
   /**
    * Initialize a FAT volume.  Try partition one first then try super
    * floppy format.
@@ -139,17 +174,29 @@ class SdVolume {
   static bool const CACHE_FOR_WRITE = true;
 
   #if USE_MULTIPLE_CARDS
-    cache_t cacheBuffer_;        // 512 byte cache for device blocks
-    uint32_t cacheBlockNumber_;  // Logical number of block in the cache
-    DiskIODriver *sdCard_;       // DiskIODriver object for cache
-    bool cacheDirty_;            // cacheFlush() will write block if true
-    uint32_t cacheMirrorBlock_;  // block number for mirror FAT
+    cache_t cacheBuffer_[SD_CACHE_BLOCKS];        // 512 byte caches for device blocks
+    cache_entry_t cacheEntry_[SD_CACHE_BLOCKS];   // Block number and state of each cache
+    uint8_t cacheIndex_;                          // Cache used by the last access
+    uint32_t cacheUseCount_;                      // Cache accesses, for LRU
+    DiskIODriver *sdCard_;                        // DiskIODriver object for cache
   #else
-    static cache_t cacheBuffer_;        // 512 byte cache for device blocks
-    static uint32_t cacheBlockNumber_;  // Logical number of block in the cache
-    static DiskIODriver *sdCard_;       // DiskIODriver object for cache
-    static bool cacheDirty_;            // cacheFlush() will write block if true
-    static uint32_t cacheMirrorBlock_;  // block number for mirror FAT
+    static cache_t cacheBuffer_[SD_CACHE_BLOCKS];        // 512 byte caches for device blocks
+    static cache_entry_t cacheEntry_[SD_CACHE_BLOCKS];   // Block number and state of each cache
+    static uint8_t cacheIndex_;                          // Cache used by the last access
+    static uint32_t cacheUseCount_;                      // Cache accesses, for LRU
+    static DiskIODriver *sdCard_;                        // DiskIODriver object for cache
+  #endif
+
+  #if HAS_SD_PREALLOCATE
+    #if USE_MULTIPLE_CARDS
+      uint32_t streamBlock_;                      // Next block of an open multiple block write, or 0
+    #else
+      static uint32_t streamBlock_;               // Next block of an open multiple block write, or 0
+    #endif
+  #endif
+
+  #if HAS_SD_BLOCK_CACHE
+    static cache_stats_t cacheStats_;
   #endif
 
   uint32_t allocSearchStart_;   // start cluster for alloc search
@@ -169,23 +216,52 @@ class SdVolume {
   uint32_t clusterStartBlock(uint32_t cluster) const { return dataStartBlock_ + ((cluster - 2) << clusterSizeShift_); }
   uint32_t blockNumber(uint32_t cluster, uint32_t position) const { return clusterStartBlock(cluster) + blockOfCluster(position); }
 
-  cache_t* cache() { return &cacheBuffer_; }
-  uint32_t cacheBlockNumber() const { return cacheBlockNumber_; }
+  // The cache used by the last access
+  cache_t* cache() { return &cacheBuffer_[cacheIndex_]; }
+  uint32_t cacheBlockNumber() const { return cacheEntry_[cacheIndex_].block; }
+
+  // Number of blocks from blockNumber, up to count, that can be read around the cache
+  uint8_t cacheUncached(const uint32_t blockNumber, const uint8_t count) const {
+    uint8_t n = count;
+    LOOP_L_N(i, SD_CACHE_BLOCKS) {
+      const uint32_t b = cacheEntry_[i].block;
+      if (b >= blockNumber && b < blockNumber + n) n = b - blockNumber;
+    }
+    return n;
+  }
+
+  // used by SdBaseFile write to drop a block it writes directly
+  void cacheInvalidate(const uint32_t blockNumber) {
+    LOOP_L_N(i, SD_CACHE_BLOCKS)
+      if (cacheEntry_[i].block == blockNumber) { cacheEntry_[i].block = 0xFFFFFFFF; cacheEntry_[i].dirty = false; }
+  }
 
   #if USE_MULTIPLE_CARDS
     bool cacheFlush();
-    bool cacheRawBlock(uint32_t blockNumber, bool dirty);
+    bool cacheRawBlock(uint32_t blockNumber, bool dirty, const uint8_t priority=CACHE_PRIORITY_DATA);
+    bool cacheSetBlockNumber(uint32_t blockNumber, bool dirty);
+    uint8_t cacheVictim();
+    bool cacheWriteEntry(const uint8_t i);
   #else
     static bool cacheFlush();
-    static bool cacheRawBlock(uint32_t blockNumber, bool dirty);
+    static bool cacheRawBlock(uint32_t blockNumber, bool dirty, const uint8_t priority=CACHE_PRIORITY_DATA);
+    static bool cacheSetBlockNumber(uint32_t blockNumber, bool dirty);
+    static uint8_t cacheVictim();
+    static bool cacheWriteEntry(const uint8_t i);
   #endif
 
-  // used by SdBaseFile write to assign cache to SD location
-  void cacheSetBlockNumber(uint32_t blockNumber, bool dirty) {
-    cacheDirty_ = dirty;
-    cacheBlockNumber_  = blockNumber;
-  }
-  void cacheSetDirty() { cacheDirty_ |= CACHE_FOR_WRITE; }
+  #if HAS_SD_PREALLOCATE
+    #if USE_MULTIPLE_CARDS
+      bool streamStop();
+      bool writeDataBlock(const uint32_t block, const uint8_t *src, const uint32_t eraseCount);
+    #else
+      static bool streamStop();
+      static bool writeDataBlock(const uint32_t block, const uint8_t *src, const uint32_t eraseCount);
+    #endif
+  #endif
+
+  void cacheSetDirty() { cacheEntry_[cacheIndex_].dirty = true; }
+  void cacheSetMirror(const uint32_t blockNumber) { cacheEntry_[cacheIndex_].mirrorBlock = blockNumber; }
   bool chainSize(uint32_t beginCluster, uint32_t *size);
   bool fatGet(uint32_t cluster, uint32_t *value);
   bool fatPut(uint32_t cluster, uint32_t value);
@@ -196,6 +272,7 @@ class SdVolume {
     if (fatType_ == 16) return cluster >= FAT16EOC_MIN;
     return  cluster >= FAT32EOC_MIN;
   }
-  bool readBlock(uint32_t block, uint8_t *dst) { return sdCard_->readBlock(block, dst); }
-  bool writeBlock(uint32_t block, const uint8_t *dst) { return sdCard_->writeBlock(block, dst); }
+  bool readBlock(uint32_t block, uint8_t *dst) { return TERN1(HAS_SD_PREALLOCATE, streamStop()) && sdCard_->readBlock(block, dst); }
+  bool readBlocks(uint32_t block, uint8_t *dst, const uint8_t count) { return TERN1(HAS_SD_PREALLOCATE, streamStop()) && sdCard_->readBlocks(block, dst, count); }
+  bool writeBlock(uint32_t block, const uint8_t *dst) { return TERN1(HAS_SD_PREALLOCATE, streamStop()) && sdCard_->writeBlock(block, dst); }
 };
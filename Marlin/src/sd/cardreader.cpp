@@ -137,6 +137,15 @@ SdFile CardReader::file;
 
 uint32_t CardReader::filesize, CardReader::sdpos;
 
+#if HAS_SD_READ_AHEAD
+  uint8_t CardReader::readahead[SD_READ_AHEAD_BLOCKS * 512];
+  uint16_t CardReader::ra_index, CardReader::ra_count;
+#endif
+
+#if ENABLED(MEATPACK_SD_FILES)
+  MeatPack CardReader::meatpack;
+#endif
+
 CardReader::CardReader() {
   changeMedia(&
     #if HAS_USB_FLASH_DRIVE && !SHARED_VOLUME_IS(SD_ONBOARD)
@@ -206,6 +215,9 @@ bool CardReader::is_dir_or_gcode(const dir_t &p) {
   return (
     flag.filenameIsDir                                  // All Directories are ok
     || (p.name[8] == 'G' && p.name[9] != '~')           // Non-backup *.G* files are accepted
+    #if ENABLED(MEATPACK_SD_FILES)
+      || (p.name[8] == 'M' && p.name[9] == 'P' && p.name[10] == ' ') // Packed *.MP files too
+    #endif
   );
 }
 
@@ -638,6 +650,8 @@ void CardReader::openFileRead(const char * const path, const uint8_t subcall_typ
   if (file.open(diveDir, fname, O_READ)) {
     filesize = file.fileSize();
     sdpos = 0;
+    TERN_(HAS_SD_READ_AHEAD, ra_index = ra_count = 0);
+    TERN_(MEATPACK_SD_FILES, beginPacked(fname));
 
     { // Don't remove this block, as the PORT_REDIRECT is a RAII
       PORT_REDIRECT(SerialMask::All);
@@ -652,6 +666,31 @@ void CardReader::openFileRead(const char * const path, const uint8_t subcall_typ
     openFailed(fname);
 }
 
+#if ENABLED(MEATPACK_SD_FILES)
+
+  /**
+   * A *.MP file is MeatPack v2. Run the commands at its head, which may set
+   * the symbol and token tables, so reading can start at any line after them.
+   * The head ends with the command that turns packing on.
+   */
+  void CardReader::beginPacked(const char * const fname) {
+    const char * const ext = strrchr(fname, '.');
+    flag.packed = ext && !strcasecmp_P(ext + 1, PSTR("MP"));
+    if (!flag.packed) return;
+    meatpack.begin_packed();
+    if (peek() != 0xFF) return;               // No head. Use the default tables.
+    meatpack.handle_command(MPCommand_DisablePacking);
+    char chars[MeatPack::kMaxOutput];
+    while (!meatpack.is_packing() && !eof()) {
+      const int16_t c = get();
+      if (c < 0) break;
+      meatpack.handle_rx_char(uint8_t(c), serial_index_t());
+      meatpack.get_result_char(chars);        // Drop anything that isn't a command
+    }
+  }
+
+#endif
+
 inline void echo_write_to_file(const char * const fname) {
   SERIAL_ECHOLNPAIR(STR_SD_WRITE_TO_FILE, fname);
 }
@@ -813,6 +852,7 @@ void CardReader::closefile(const bool store_location/*=false*/) {
   file.close();
   flag.saving = flag.logging = false;
   sdpos = 0;
+  TERN_(HAS_SD_READ_AHEAD, ra_index = ra_count = 0);
   TERN_(EMERGENCY_PARSER, emergency_parser.enable());
 
   if (store_location) {
@@ -1236,6 +1276,40 @@ uint16_t CardReader::get_num_Files() {
   );
 }
 
+#if HAS_SD_READ_AHEAD
+
+  //
+  // Refill the read-ahead buffer. Reads end on a block boundary,
+  // so whole blocks go straight from the card into the buffer.
+  //
+  bool CardReader::fillReadAhead() {
+    ra_index = ra_count = 0;
+    if (!file.isOpen()) return false;
+    const int16_t n = file.read(readahead, sizeof(readahead) - (file.curPosition() & 0x1FF));
+    if (n <= 0) return false;
+    ra_count = n;
+    return true;
+  }
+
+  //
+  // Put the file position back at sdpos before reading it directly
+  //
+  void CardReader::dropReadAhead() {
+    if (ra_index < ra_count) file.seekSet(sdpos);
+    ra_index = ra_count = 0;
+  }
+
+  int16_t CardReader::peekLine(const char * &line) {
+    if (ra_index >= ra_count && !fillReadAhead()) return -1;
+    line = (const char*)&readahead[ra_index];
+    const uint16_t avail = ra_count - ra_index;
+    uint16_t n = 0;
+    while (n < avail && !ISEOL(line[n])) n++;
+    return n < avail ? n + 1 : n;
+  }
+
+#endif // HAS_SD_READ_AHEAD
+
 //
 // Return from procedure or close out the Print Job
 //
@@ -48,6 +48,10 @@ extern const char M23_STR[], M24_STR[];
   #include "usb_flashdrive/Sd2Card_FlashDrive.h"
 #endif
 
+#if ENABLED(MEATPACK_SD_FILES)
+  #include "../feature/meatpack.h"
+#endif
+
 #if NEED_SD2CARD_SDIO
   #include "Sd2Card_sdio.h"
 #elif NEED_SD2CARD_SPI
@@ -78,6 +82,9 @@ typedef struct {
        #if ENABLED(BINARY_FILE_TRANSFER)
          , binary_mode:1
        #endif
+       #if ENABLED(MEATPACK_SD_FILES)
+         , packed:1
+       #endif
     ;
 } card_flags_t;
 
@@ -218,14 +225,38 @@ public:
   static inline bool eof()              { return getIndex() >= getFileSize(); }
 
   // File data operations
-  static inline int16_t get()                            { int16_t out = (int16_t)file.read(); sdpos = file.curPosition(); return out; }
-  static inline int16_t read(void *buf, uint16_t nbyte)  { return file.isOpen() ? file.read(buf, nbyte) : -1; }
+  #if HAS_SD_READ_AHEAD
+    static inline int16_t get() {
+      if (ra_index >= ra_count && !fillReadAhead()) return -1;
+      sdpos++;
+      return readahead[ra_index++];
+    }
+    // Point to the buffered bytes up to and including the next EOL, reading ahead if needed.
+    // Process them in place, then consume() them. Returns -1 on error or end of file.
+    static int16_t peekLine(const char * &line);
+    static inline void consume(const uint16_t n) { ra_index += n; sdpos += n; }
+    static inline int16_t peek() { return (ra_index < ra_count || fillReadAhead()) ? readahead[ra_index] : -1; }
+    static inline int16_t read(void *buf, uint16_t nbyte)  { dropReadAhead(); return file.isOpen() ? file.read(buf, nbyte) : -1; }
+  #else
+    static inline int16_t get()                            { int16_t out = (int16_t)file.read(); sdpos = file.curPosition(); return out; }
+    static inline int16_t peek()                           { return (int16_t)file.peek(); }
+    static inline int16_t read(void *buf, uint16_t nbyte)  { return file.isOpen() ? file.read(buf, nbyte) : -1; }
+  #endif
   static inline int16_t write(void *buf, uint16_t nbyte) { return file.isOpen() ? file.write(buf, nbyte) : -1; }
-  static inline void setIndex(const uint32_t index)      { file.seekSet((sdpos = index)); }
+  static inline void setIndex(const uint32_t index)      { TERN_(HAS_SD_READ_AHEAD, ra_index = ra_count = 0); file.seekSet((sdpos = index)); }
 
   // TODO: rename to diskIODriver()
   static DiskIODriver* diskIODriver() { return driver; }
 
+  #if HAS_SD_BLOCK_CACHE
+    static inline const cache_stats_t& cacheStats() { return volume.cacheStats(); }
+    static inline void resetCacheStats() { volume.cacheResetStats(); }
+  #endif
+
+  #if ENABLED(MEATPACK_SD_FILES)
+    static MeatPack meatpack;   // Decoder for a packed (*.MP) file
+  #endif
+
   #if ENABLED(AUTO_REPORT_SD_STATUS)
     //
     // SD Auto Reporting
@@ -314,6 +345,20 @@ private:
   static uint32_t filesize, // Total size of the current file, in bytes
                   sdpos;    // Index most recently read (one behind file.getPos)
 
+  //
+  // Read-ahead buffer. The file position is at the end of the buffered data.
+  //
+  #if HAS_SD_READ_AHEAD
+    static uint8_t readahead[SD_READ_AHEAD_BLOCKS * 512];
+    static uint16_t ra_index, ra_count;
+    static bool fillReadAhead();
+    static void dropReadAhead();
+  #endif
+
+  #if ENABLED(MEATPACK_SD_FILES)
+    static void beginPacked(const char * const fname);
+  #endif
+
   //
   // Procedure calls to other files
   //
@@ -57,6 +57,24 @@ public:
   virtual bool writeStop() = 0;
 
   virtual bool readBlock(uint32_t block, uint8_t* dst) = 0;
+
+  /**
+   * Read consecutive 512 byte blocks with a single multiple block read sequence.
+   *
+   * \param[in] block Logical block to start reading.
+   * \param[out] dst Pointer to the location that will receive the data.
+   * \param[in] count Number of blocks to read.
+   *
+   * \return true for success or false for failure.
+   */
+  virtual bool readBlocks(uint32_t block, uint8_t* dst, const uint8_t count) {
+    if (count == 1) return readBlock(block, dst);
+    if (!readStart(block)) return false;
+    for (uint8_t i = 0; i < count; i++, dst += 512)
+      if (!readData(dst)) { readStop(); return false; }
+    return readStop();
+  }
+
   virtual bool writeBlock(uint32_t blockNumber, const uint8_t* src) = 0;
 
   virtual uint32_t cardSize() = 0;
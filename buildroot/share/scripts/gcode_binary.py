@@ -0,0 +1,291 @@
+#!/usr/bin/env python3
+#
+# gcode_binary.py
+#
+# Convert G-code to the pre-tokenized binary G-code read by Marlin with
+# BINARY_GCODE (see Marlin/src/feature/binary_gcode.h) and back again.
+#
+# Usage: gcode_binary.py [options] in.gcode out.bgcode
+#        gcode_binary.py --decode in.bgcode out.gcode
+#        gcode_binary.py --check in.gcode
+#
+#  --decode          Convert binary G-code back to text
+#  --check           Convert to binary and back, verify that every command is
+#                    unchanged, and report the size saving
+#  --max-line N      MAX_CMD_SIZE of the firmware (default 96)
+#  --paren-comments  Strip (comments) as with PAREN_COMMENTS
+#  --quoted-strings  Keep ; and \ in "strings" as with GCODE_QUOTED_STRINGS
+#
+from __future__ import print_function
+
+import argparse
+import re
+import sys
+from decimal import Decimal
+
+KIND_G, KIND_M, KIND_T, KIND_TEXT = range(4)
+KINDS = 'GMT'
+RECORD_MARK = 0x80
+MAX_PARAMS = 15
+MAX_PLACES = 6
+
+# M-codes that take the rest of the line as a string
+STRING_MCODES = set([16, 23, 28, 30, 32, 117, 118, 928] + list(range(810, 820)))
+
+COMMAND_RE = re.compile(r'(?:N-?\d+ *)?([GMT]) *(\d+)(?:\.(\d+))?')
+PARAM_RE = re.compile(r' *([A-Z]) *([-+]?(?:\d+\.?\d*|\.\d+))?')
+VALUE_RE = re.compile(r'([-+]?)(\d*)\.?(\d*)$')
+
+class Options(object):
+  def __init__(self, max_line=96, paren_comments=False, quoted_strings=False):
+    self.max_line = max_line
+    self.paren_comments = paren_comments
+    self.quoted_strings = quoted_strings
+
+def strip_line(line, opt):
+  '''Remove comments and escapes just as Marlin does when it reads a line'''
+  out = []
+  state, esc = 'normal', False
+  for c in line:
+    if state == 'eol':
+      break
+    if state == 'paren':
+      if c == ')':
+        state = 'normal'
+      continue
+    if esc:
+      esc = False
+    elif c == '\\':
+      esc = True
+      if state != 'quoted':
+        continue
+    elif state == 'quoted':
+      if c == '"':
+        state = 'normal'
+    elif opt.quoted_strings and c == '"':
+      state = 'quoted'
+    elif c == ';':
+      break
+    elif opt.paren_comments and c == '(':
+      state = 'paren'
+      continue
+    out.append(c)
+    if len(out) >= opt.max_line - 1:
+      break
+  return ''.join(out)
+
+def is_record(c):
+  '''A line starting with this byte is a binary record. A UTF-8 BOM is not.'''
+  return c >= RECORD_MARK and (c & 0x7F) <= KIND_TEXT << 5
+
+def put_varint(out, v):
+  while v > 0x7F:
+    out.append(0x80 | (v & 0x7F))
+    v >>= 7
+  out.append(v)
+
+def get_varint(data, pos, end):
+  v = shift = 0
+  while pos < end and shift < 32:
+    b = data[pos]
+    pos += 1
+    v |= (b & 0x7F) << shift
+    if not b & 0x80:
+      return v, pos
+    shift += 7
+  raise ValueError('Bad varint')
+
+def tokenize(text):
+  '''Split a stripped line into (letter, code, subcode, [(param, value string)]) or None'''
+  m = COMMAND_RE.match(text.lstrip(' '))
+  if not m:
+    return None
+  letter, code, sub = m.group(1), int(m.group(2)), m.group(3)
+  rest = text.lstrip(' ')[m.end():]
+  star = rest.find('*')
+  if star >= 0:
+    rest = rest[:star]
+  rest = rest.rstrip(' ')
+  if (letter == 'M' and code in STRING_MCODES) or code > 0xFFFF or (sub is not None and int(sub) > 0xFF):
+    return None
+  params, pos = [], 0
+  while pos < len(rest):
+    p = PARAM_RE.match(rest, pos)
+    if not p or p.end() == pos:
+      return None
+    pos = p.end()
+    # A value must end at a space, a parameter letter, or the end of the line
+    if pos < len(rest) and not (rest[pos] == ' ' or 'A' <= rest[pos] <= 'Z'):
+      return None
+    params.append((p.group(1), p.group(2)))
+  return letter, code, None if sub is None else int(sub), params
+
+def encode_value(value):
+  '''Return (format, zigzag) for a decimal value, or None if it won't fit'''
+  sign, whole, frac = VALUE_RE.match(value).groups()
+  frac = frac.rstrip('0')
+  if len(frac) > MAX_PLACES:
+    return None
+  v = int((whole or '0') + frac)
+  if sign == '-':
+    v = -v
+  if not -(1 << 31) <= v < (1 << 31):
+    return None
+  return len(frac) + 1, (v << 1) if v >= 0 else (-v << 1) - 1
+
+def text_record(text):
+  data = text.encode('latin-1')
+  return bytearray([RECORD_MARK | KIND_TEXT << 5, len(data)]) + data
+
+def encode_line(line, opt):
+  '''Encode one line of G-code as a binary record, or None for an empty line'''
+  text = strip_line(line.rstrip('\r\n'), opt)
+  if not text.strip(' '):
+    return None
+  tokens = tokenize(text)
+  if tokens:
+    letter, code, sub, params = tokens
+    body = bytearray()
+    put_varint(body, code)
+    if sub is not None:
+      body.append(sub)
+    for param, value in params:
+      ind = ord(param) - ord('A')
+      if value is None:
+        body.append(ind)
+        continue
+      enc = encode_value(value)
+      if not enc:
+        break
+      body.append(enc[0] << 5 | ind)
+      put_varint(body, enc[1])
+    else:
+      head = RECORD_MARK | KINDS.index(letter) << 5 | (0x10 if sub is not None else 0) | len(params)
+      record = bytearray([head, len(body)]) + body
+      if len(params) <= MAX_PARAMS and len(record) <= opt.max_line + 1 and len(decode_record(record, 0)[0]) < opt.max_line:
+        return record
+  return text_record(text)
+
+def decode_record(data, pos):
+  '''Decode the record at 'pos' the way the firmware does. Return (text, next pos).'''
+  head, size = data[pos], data[pos + 1]
+  pos += 2
+  end = pos + size
+  if end > len(data):
+    raise ValueError('Record cut short')
+  kind = (head >> 5) & 0x3
+  if kind == KIND_TEXT:
+    return bytes(data[pos:end]).decode('latin-1'), end
+
+  code, pos = get_varint(data, pos, end)
+  text = KINDS[kind] + str(code)
+  if head & 0x10:
+    text += '.%d' % data[pos]
+    pos += 1
+  for _ in range(head & 0x0F):
+    param = data[pos]
+    pos += 1
+    ind, fmt = param & 0x1F, param >> 5
+    if ind > 25:
+      raise ValueError('Bad parameter letter')
+    text += ' ' + chr(ord('A') + ind)
+    if fmt:
+      zz, pos = get_varint(data, pos, end)
+      neg, mag = zz & 1, (zz >> 1) + (zz & 1)
+      places = fmt - 1
+      digits = str(mag).rjust(places + 1, '0')
+      if places:
+        digits = digits[:-places] + '.' + digits[-places:]
+      text += ('-' if neg else '') + digits
+  if pos != end:
+    raise ValueError('Record has extra bytes')
+  return text, end
+
+def decode_file(data):
+  '''Split a file of mixed binary records and text lines into lines of text'''
+  lines, pos = [], 0
+  while pos < len(data):
+    if is_record(data[pos]):
+      text, pos = decode_record(data, pos)
+      lines.append(text)
+    else:
+      eol = data.find(b'\n', pos)
+      eol = len(data) if eol < 0 else eol + 1
+      lines.append(bytes(data[pos:eol]).decode('latin-1').rstrip('\r\n'))
+      pos = eol
+  return lines
+
+def command_key(text):
+  '''The meaning of a command line, for comparison'''
+  tokens = tokenize(text)
+  if not tokens:
+    return text
+  letter, code, sub, params = tokens
+  return letter, code, sub, [(p, None if v is None else Decimal(v)) for p, v in params]
+
+def encode_file(lines, opt):
+  out = bytearray(b'; Marlin binary G-code\n')
+  for line in lines:
+    rec = encode_line(line, opt)
+    if rec:
+      out += rec
+  return out
+
+def main():
+  parser = argparse.ArgumentParser(description='Convert G-code to and from Marlin binary G-code')
+  parser.add_argument('input')
+  parser.add_argument('output', nargs='?')
+  parser.add_argument('--decode', action='store_true', help='convert binary G-code to text')
+  parser.add_argument('--check', action='store_true', help='verify a round trip and report the size')
+  parser.add_argument('--max-line', type=int, default=96, help='MAX_CMD_SIZE of the firmware')
+  parser.add_argument('--paren-comments', action='store_true', help='strip (comments)')
+  parser.add_argument('--quoted-strings', action='store_true', help='allow "quoted strings"')
+  args = parser.parse_args()
+  opt = Options(args.max_line, args.paren_comments, args.quoted_strings)
+
+  with open(args.input, 'rb') as f:
+    data = bytearray(f.read())
+
+  if args.decode:
+    text = '\n'.join(decode_file(data)) + '\n'
+    if args.output:
+      with open(args.output, 'w') as f:
+        f.write(text)
+    else:
+      sys.stdout.write(text)
+    return
+
+  lines = bytes(data).decode('latin-1').splitlines()
+  binary = encode_file(lines, opt)
+
+  if args.check:
+    decoded = decode_file(binary)[1:]     # Skip the header comment
+    originals = [t for t in (strip_line(l, opt) for l in lines) if t.strip(' ')]
+    if len(decoded) != len(originals):
+      raise ValueError('%d commands in, %d out' % (len(originals), len(decoded)))
+    errors = 0
+    for n, (a, b) in enumerate(zip(originals, decoded)):
+      if command_key(a) != command_key(b):
+        print('Mismatch: "%s" -> "%s"' % (a, b))
+        errors += 1
+    text_records = sum(1 for t in decoded if not tokenize(t))
+    print('%-16s: %d' % ('Commands', len(decoded)))
+    print('%-16s: %d' % ('Text records', text_records))
+    print('%-16s: %d bytes (%d without comments)' % ('G-code', len(data), sum(len(t) + 1 for t in originals)))
+    print('%-16s: %d bytes (%.1f%%)' % ('Binary G-code', len(binary), 100.0 * len(binary) / max(1, len(data))))
+    print('%-16s: %d' % ('Mismatches', errors))
+    if errors:
+      sys.exit(1)
+
+  if args.output:
+    with open(args.output, 'wb') as f:
+      f.write(binary)
+  elif not args.check:
+    parser.error('an output file is required')
+
+if __name__ == '__main__':
+  try:
+    main()
+  except (IOError, ValueError) as e:
+    print(e, file=sys.stderr)
+    sys.exit(1)
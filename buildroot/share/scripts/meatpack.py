@@ -0,0 +1,270 @@
+#!/usr/bin/env python3
+#
+# meatpack.py
+#
+# Pack G-code with MeatPack v2 for printing from SD as a *.MP file with
+# MEATPACK_SD_FILES, or for sending to a port with MEATPACK_V2.
+# (See Marlin/src/feature/meatpack.h)
+#
+# The symbol and token tables are learned from the G-code itself and sent
+# at the head of the output, so the firmware decodes with the same tables.
+#
+# Usage: meatpack.py [options] in.gcode out.mp
+#        meatpack.py --decode in.mp out.gcode
+#        meatpack.py --check in.gcode
+#
+#  --decode          Unpack a MeatPack v2 file to text
+#  --check           Pack and unpack, verify that every line is unchanged,
+#                    and report the size against text and MeatPack v1
+#  --default-tables  Use the firmware's default tables instead of learning them
+#  --no-spaces       Drop the spaces between parameters (not in strings)
+#  --token-size N    MEATPACK_TOKEN_SIZE of the firmware (default 6)
+#  --max-line N      MAX_CMD_SIZE of the firmware (default 96)
+#
+from __future__ import print_function
+
+import argparse
+import sys
+from collections import Counter
+
+from gcode_binary import COMMAND_RE, STRING_MCODES, Options, strip_line
+
+COMMAND_BYTE = 0xFF
+CMD_ENABLE_PACKING = 0xFB
+CMD_SELECT_VERSION = 0xF5
+CMD_SET_SYMBOLS = 0xF4
+CMD_SET_TOKEN = 0xF3
+
+ESCAPE = 0xF
+TABLE_SIZE = 15
+
+# The firmware's default tables (meatpack.cpp)
+DEFAULT_SYMBOLS = '0123456789. \nGX'
+DEFAULT_TOKENS = ['G1 X', ' Y', ' E', ' F', ' Z', 'G1 ', 'G0 ', '-', 'E', 'Y', 'F', 'Z', 'M', 'S', 'T']
+
+# The MeatPack v1 table, for comparison
+V1_SYMBOLS = set('0123456789. \nGX')
+
+class Tables(object):
+  def __init__(self, symbols=DEFAULT_SYMBOLS, tokens=DEFAULT_TOKENS):
+    self.symbols = symbols
+    self.tokens = list(tokens)
+    self.symbol_index = dict((c, i) for i, c in enumerate(symbols))
+    # Tokens by their first character, for the packer
+    self.starts = {}
+    for i, t in enumerate(self.tokens):
+      if t:
+        self.starts.setdefault(t[0], []).append((t, i))
+
+def command_bytes(cmd, args=b''):
+  return bytearray([COMMAND_BYTE, COMMAND_BYTE, cmd]) + bytearray(args)
+
+def head_bytes(tables):
+  '''Commands that select v2, set the tables, and turn packing on'''
+  out = command_bytes(CMD_SELECT_VERSION, [2])
+  out += command_bytes(CMD_SET_SYMBOLS, bytearray(tables.symbols, 'latin-1'))
+  for i, t in enumerate(tables.tokens):
+    out += command_bytes(CMD_SET_TOKEN, bytearray([i, len(t)]) + bytearray(t, 'latin-1'))
+  out += command_bytes(CMD_ENABLE_PACKING)
+  return out
+
+def pack_line(line, tables):
+  '''Return the cheapest nibbles for a line, which must end with a newline'''
+  n = len(line)
+  INF = 1 << 30
+  cost, step = [INF] * (n + 1), [None] * (n + 1)
+  cost[n] = 0
+  for i in range(n - 1, -1, -1):
+    c = line[i]
+    if c in tables.symbol_index:
+      cost[i], step[i] = 1 + cost[i + 1], (1, [tables.symbol_index[c]])
+    for t, ti in tables.starts.get(c, ()):
+      if line.startswith(t, i) and 2 + cost[i + len(t)] < cost[i]:
+        cost[i], step[i] = 2 + cost[i + len(t)], (len(t), [ESCAPE, ti])
+    if cost[i] == INF or 3 + cost[i + 1] < cost[i]:
+      b = ord(c)
+      if b >= 0xF0:
+        raise ValueError('Character 0x%02X can\'t be packed' % b)
+      cost[i], step[i] = 3 + cost[i + 1], (1, [ESCAPE, ESCAPE, b & 0xF, b >> 4])
+  nibbles, i = [], 0
+  while i < n:
+    size, nibs = step[i]
+    nibbles += nibs
+    i += size
+  return nibbles
+
+def pack_lines(lines, tables):
+  out = bytearray()
+  for line in lines:
+    nibbles = pack_line(line + '\n', tables)
+    if len(nibbles) & 1:
+      nibbles.append(0)           # A newline ends its byte
+    for i in range(0, len(nibbles), 2):
+      out.append(nibbles[i] | nibbles[i + 1] << 4)
+  return out
+
+def unpack(data):
+  '''Decode a v2 stream the way the firmware does, running its commands'''
+  tables = Tables()
+  out, i, packing = [], 0, True
+  state, literal = 'symbol', 0
+  while i < len(data):
+    b = data[i]
+    if b == COMMAND_BYTE and i + 2 < len(data) and data[i + 1] == COMMAND_BYTE:
+      cmd, i = data[i + 2], i + 3
+      if cmd == CMD_SELECT_VERSION:
+        i += 1
+      elif cmd == CMD_SET_SYMBOLS:
+        tables = Tables(data[i:i + TABLE_SIZE].decode('latin-1'), tables.tokens)
+        i += TABLE_SIZE
+      elif cmd == CMD_SET_TOKEN:
+        index, size = data[i], data[i + 1]
+        tokens = list(tables.tokens)
+        tokens[index] = data[i + 2:i + 2 + size].decode('latin-1')
+        tables = Tables(tables.symbols, tokens)
+        i += 2 + size
+      elif cmd == CMD_ENABLE_PACKING:
+        packing = True
+      continue
+    i += 1
+    if not packing:
+      out.append(chr(b))
+      continue
+    for half, nib in enumerate((b & 0xF, b >> 4)):
+      if state == 'symbol':
+        if nib == ESCAPE:
+          state = 'token'
+        else:
+          out.append(tables.symbols[nib])
+      elif state == 'token':
+        if nib == ESCAPE:
+          state = 'low'
+        else:
+          out.append(tables.tokens[nib])
+          state = 'symbol'
+      elif state == 'low':
+        literal, state = nib, 'high'
+      else:
+        out.append(chr(literal | nib << 4))
+        state = 'symbol'
+      if half == 0 and state == 'symbol' and out and out[-1].endswith('\n'):
+        break
+  return ''.join(out)
+
+def learn_tables(lines, token_size, rounds=2):
+  '''
+  Pick the symbols and tokens that pack these lines smallest. Tokens are
+  chosen one at a time by the nibbles they would save over the current
+  tables, then the symbols are the most common characters left over.
+  '''
+  sample = [l + '\n' for l in lines[:5000]]
+  symbols = DEFAULT_SYMBOLS
+  tokens = []
+  for _ in range(rounds):
+    sym = set(symbols)
+    def nibbles(s):
+      return sum(1 if c in sym else 3 for c in s)
+    text = list(sample)
+    tokens = []
+    for t in range(TABLE_SIZE):
+      counts = Counter()
+      for s in text:
+        for size in range(1, token_size + 1):
+          for i in range(len(s) - size + 1):
+            sub = s[i:i + size]
+            if '\n' not in sub and '\0' not in sub:
+              counts[sub] += 1
+      # Overlapping counts overstate repeats like "00", but they rank well enough
+      best, saving = None, 0
+      for sub, count in counts.most_common(400):
+        gain = count * (nibbles(sub) - 2)
+        if gain > saving:
+          best, saving = sub, gain
+      if not best:
+        break
+      tokens.append(best)
+      text = [s.replace(best, '\0') for s in text]
+    # The most common characters outside the tokens make the symbols
+    chars = Counter(c for s in text for c in s if c != '\0')
+    symbols = ''.join(c for c, _ in chars.most_common(TABLE_SIZE))
+    symbols += ''.join(c for c in DEFAULT_SYMBOLS if c not in symbols)[:TABLE_SIZE - len(symbols)]
+  tokens += [''] * (TABLE_SIZE - len(tokens))
+  return Tables(symbols, tokens)
+
+def remove_spaces(line):
+  '''Drop spaces between parameters. Commands with a string are left alone.'''
+  m = COMMAND_RE.match(line.lstrip(' '))
+  if m and m.group(1) == 'M' and int(m.group(2)) in STRING_MCODES:
+    return line
+  if '"' in line:
+    return line
+  return line.replace(' ', '')
+
+def v1_size(lines):
+  '''Bytes for the same lines with MeatPack v1 and its fixed table'''
+  size = 0
+  for line in lines:
+    s = line + '\n'
+    size += (len(s) + 1) // 2 + sum(1 for c in s if c not in V1_SYMBOLS)
+  return size
+
+def main():
+  parser = argparse.ArgumentParser(description='Pack G-code with MeatPack v2')
+  parser.add_argument('input')
+  parser.add_argument('output', nargs='?')
+  parser.add_argument('--decode', action='store_true', help='unpack a MeatPack v2 file')
+  parser.add_argument('--check', action='store_true', help='verify a round trip and report the size')
+  parser.add_argument('--default-tables', action='store_true', help='use the firmware default tables')
+  parser.add_argument('--no-spaces', action='store_true', help='drop spaces between parameters')
+  parser.add_argument('--token-size', type=int, default=6, help='MEATPACK_TOKEN_SIZE of the firmware')
+  parser.add_argument('--max-line', type=int, default=96, help='MAX_CMD_SIZE of the firmware')
+  args = parser.parse_args()
+  opt = Options(args.max_line)
+
+  with open(args.input, 'rb') as f:
+    data = bytearray(f.read())
+
+  if args.decode:
+    text = unpack(data)
+    if args.output:
+      with open(args.output, 'w') as f:
+        f.write(text)
+    else:
+      sys.stdout.write(text)
+    return
+
+  lines = [strip_line(l, opt).rstrip(' ') for l in bytes(data).decode('latin-1').splitlines()]
+  lines = [l for l in lines if l.strip(' ')]
+  if args.no_spaces:
+    lines = [remove_spaces(l) for l in lines]
+
+  tables = Tables() if args.default_tables else learn_tables(lines, args.token_size)
+  if any(len(t) > args.token_size for t in tables.tokens):
+    raise ValueError('A token is longer than --token-size')
+  packed = head_bytes(tables) + pack_lines(lines, tables)
+
+  if args.check:
+    text = sum(len(l) + 1 for l in lines)
+    unpacked = unpack(packed).split('\n')[:-1]
+    errors = sum(1 for a, b in zip(lines, unpacked) if a != b) + abs(len(lines) - len(unpacked))
+    print('%-16s: %s' % ('Symbols', repr(tables.symbols)))
+    print('%-16s: %s' % ('Tokens', ' '.join(repr(t) for t in tables.tokens)))
+    print('%-16s: %d bytes (%d without comments)' % ('G-code', len(data), text))
+    print('%-16s: %d bytes (%.2fx)' % ('MeatPack v1', v1_size(lines), float(text) / v1_size(lines)))
+    print('%-16s: %d bytes (%.2fx)' % ('MeatPack v2', len(packed), float(text) / len(packed)))
+    print('%-16s: %d' % ('Mismatches', errors))
+    if errors:
+      sys.exit(1)
+
+  if args.output:
+    with open(args.output, 'wb') as f:
+      f.write(packed)
+  elif not args.check:
+    parser.error('an output file is required')
+
+if __name__ == '__main__':
+  try:
+    main()
+  except (IOError, ValueError) as e:
+    print(e, file=sys.stderr)
+    sys.exit(1)
@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+#
+# step_trace.py
+#
+# Analyze a binary step trace written by the LINUX HAL with GPIO_LOGGING
+# (see Marlin/src/HAL/LINUX/hardware/IOLoggerBinary.h).
+#
+# Reconstructs the position, velocity and acceleration of each axis from its
+# step and dir pins and reports the max step rate and step-interval jitter.
+#
+# Usage: step_trace.py [--csv out.csv] [--invert XYZE] step_trace.bin
+#
+#  --csv     Write time, axis, position, velocity and acceleration for every step
+#  --invert  Axes whose dir pin is inverted (INVERT_*_DIR)
+#
+from __future__ import print_function
+
+import argparse
+import math
+import struct
+import sys
+
+class Axis(object):
+  def __init__(self, name, step_bit, dir_bit, steps_per_unit):
+    self.name = name
+    self.step_mask = 1 << step_bit
+    self.dir_mask = 1 << dir_bit
+    self.steps_per_unit = steps_per_unit or 1.0
+    self.invert = False
+
+    self.steps = 0
+    self.position = 0         # steps
+    self.min_position = 0
+    self.max_position = 0
+    self.last_ns = None       # time of the previous step
+    self.last_interval = None # ns between the previous two steps
+    self.velocity = 0.0       # units/s
+    self.min_interval = None
+    self.max_velocity = 0.0
+    self.max_accel = 0.0
+    self.jitter_sum = 0.0     # Squared change between consecutive intervals
+    self.jitter_max = 0
+    self.jitter_count = 0
+
+  def step(self, ns, forward):
+    '''Account for one step at 'ns' and return (position, velocity, acceleration) in units'''
+    self.steps += 1
+    self.position += 1 if forward != self.invert else -1
+    self.min_position = min(self.min_position, self.position)
+    self.max_position = max(self.max_position, self.position)
+
+    accel = 0.0
+    if self.last_ns is not None:
+      interval = ns - self.last_ns
+      if interval > 0:
+        velocity = 1e9 / interval / self.steps_per_unit
+        if self.min_interval is None or interval < self.min_interval:
+          self.min_interval = interval
+        self.max_velocity = max(self.max_velocity, velocity)
+        if self.last_interval is not None:
+          # Velocity changes over the mean of the two intervals
+          accel = (velocity - self.velocity) * 2e9 / (interval + self.last_interval)
+          self.max_accel = max(self.max_accel, abs(accel))
+          change = abs(interval - self.last_interval)
+          self.jitter_sum += change * change
+          self.jitter_max = max(self.jitter_max, change)
+          self.jitter_count += 1
+        self.velocity = velocity
+        self.last_interval = interval
+    self.last_ns = ns
+    return self.position / self.steps_per_unit, self.velocity, accel
+
+  def stop(self):
+    '''A direction change ends the current run of steps'''
+    self.last_ns = None
+    self.last_interval = None
+    self.velocity = 0.0
+
+def read_varint(data, pos):
+  value = shift = 0
+  while True:
+    b = data[pos]
+    pos += 1
+    value |= (b & 0x7F) << shift
+    if not b & 0x80:
+      return value, pos
+    shift += 7
+
+def read_trace(path):
+  with open(path, 'rb') as f:
+    data = bytearray(f.read())
+
+  if data[0:4] != b'MSTR':
+    raise ValueError('%s is not a step trace' % path)
+  version, pin_count, axis_count = struct.unpack_from('<BBB', data, 4)
+  if version != 1:
+    raise ValueError('Unsupported step trace version %d' % version)
+
+  pos = 8 + 2 * pin_count
+  axes = []
+  for _ in range(axis_count):
+    name, step_bit, dir_bit, _, spu = struct.unpack_from('<cBBBf', data, pos)
+    axes.append(Axis(name.decode(), step_bit, dir_bit, spu))
+    pos += 8
+
+  return axes, data, pos, (pin_count + 7) // 8
+
+def main():
+  parser = argparse.ArgumentParser(description='Analyze a LINUX HAL step trace')
+  parser.add_argument('trace')
+  parser.add_argument('--csv', help='write per-step position, velocity and acceleration')
+  parser.add_argument('--invert', default='', help='axes with an inverted dir pin, e.g. XE')
+  args = parser.parse_args()
+
+  axes, data, pos, width = read_trace(args.trace)
+  for a in axes:
+    a.invert = a.name in args.invert.upper()
+
+  csv = open(args.csv, 'w') if args.csv else None
+  if csv:
+    csv.write('time_s,axis,position,velocity,acceleration\n')
+
+  ns = records = 0
+  bitmap = 0
+  while pos < len(data):
+    delta, pos = read_varint(data, pos)
+    new = int.from_bytes(bytes(data[pos:pos + width]), 'little')
+    pos += width
+    ns += delta
+    records += 1
+
+    changed = bitmap ^ new
+    for a in axes:
+      if changed & a.dir_mask:
+        a.stop()
+      if changed & a.step_mask and new & a.step_mask:
+        p, v, acc = a.step(ns, bool(new & a.dir_mask))
+        if csv:
+          csv.write('%.9f,%s,%.4f,%.3f,%.1f\n' % (ns / 1e9, a.name, p, v, acc))
+    bitmap = new
+
+  if csv:
+    csv.close()
+
+  print('%-12s: %d records, %.3f s' % ('Trace', records, ns / 1e9))
+  for a in axes:
+    if not a.steps:
+      continue
+    rate = 1e9 / a.min_interval if a.min_interval else 0.0
+    jitter = math.sqrt(a.jitter_sum / a.jitter_count) if a.jitter_count else 0.0
+    print('%s axis' % a.name)
+    print('  %-22s: %d' % ('Steps', a.steps))
+    print('  %-22s: %.3f (range %.3f .. %.3f)' % ('Final position', a.position / a.steps_per_unit,
+          a.min_position / a.steps_per_unit, a.max_position / a.steps_per_unit))
+    print('  %-22s: %.0f steps/s' % ('Max step rate', rate))
+    print('  %-22s: %.1f units/s' % ('Max velocity', a.max_velocity))
+    print('  %-22s: %.0f units/s^2' % ('Max acceleration', a.max_accel))
+    print('  %-22s: %.3f us rms, %.3f us max' % ('Step interval jitter', jitter / 1e3, a.jitter_max / 1e3))
+
+if __name__ == '__main__':
+  try:
+    main()
+  except (IOError, ValueError) as e:
+    print(e, file=sys.stderr)
+    sys.exit(1)
@@ -0,0 +1,46 @@
+;
+; Binary G-code
+;
+; Commands covering the value formats, subcodes, and text fallbacks of
+; buildroot/share/scripts/gcode_binary.py. The linux_native test encodes
+; this file and checks that the firmware decodes every record back to the
+; same command:
+;
+;   gcode_binary.py binary-gcode.gcode binary-gcode.bgcode
+;   linux_native_benchmark --binary-gcode binary-gcode.bgcode binary-gcode.gcode
+;
+
+G28
+G90
+M83
+G92 E0
+G1 Z0.2 F600
+G1 X10 Y10.5 E0.25 F1800
+G1 X-12.125 Y+3.0 E-.5
+G1 X1.50 Y2.000 Z0.0     ; Trailing zeros
+G1 X0.000001 Y123456.789 ; Six places
+G0 X100.1234567          ; More places than a record holds
+G1 X2147483.647
+G1 X3000000000           ; Too large for a record
+G1X5Y6                   ; No spaces
+N10 G1 X5 Y5             ; Line number
+G2 X20 Y20 I5 J-5
+G3 X10 Y10 R7.5
+G4 P300
+G4 S1
+G92.1                    ; Subcode
+G38.2 Z-10 F100
+M104 S210 T0
+M140 S60
+M106 S255
+M107
+T1
+T0
+M84 X Y                  ; Parameters with no value
+M203 X500 Y500 Z20 E50
+M201 X1000 Y1000 Z100 E5000 T0 S5 P6 ; More parameters than PARSED_PARAMS
+M92 X80 X81              ; A repeated letter
+M117 Binary G-code test  ; String argument
+M118 E1 Hello, world
+M115
+M400
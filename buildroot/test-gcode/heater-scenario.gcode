@@ -0,0 +1,31 @@
+;
+; Heater Scenario
+;
+; Step the hotend and bed targets and load the hotend with the part
+; cooling fan and steady extrusion, on the LINUX simulator's heater model:
+;
+;   linux_native_benchmark --heaters buildroot/test-gcode/heater-scenario.gcode
+;
+
+G4 S1               ; First readings
+M140 S60            ; Bed from room temperature
+M104 S200           ; Hotend from room temperature
+G4 S150
+
+M106 S255           ; Part cooling fan on
+G4 S60
+M107
+G4 S30
+
+M83
+G1 E150 F150        ; 2.5mm/s of filament for a minute
+G4 S30
+
+M104 S240           ; Step up
+G4 S90
+
+M104 S180           ; Step down
+G4 S150
+
+M104 S0
+M140 S0
@@ -0,0 +1,131 @@
+;
+; Planner Benchmark Moves
+;
+; Lines, arcs, and short segments with extrusion, for linux_native_benchmark.
+; Every move is relative to a G92 origin, so no homing is needed.
+;
+
+G92 X0 Y0 Z0 E0
+M83
+M302 P1             ; Allow cold extrusion
+G1 Z0.2 F600
+
+; Square outlines
+G1 F3000
+G1 X20 Y0 E0.800
+G1 X20 Y20 E0.800
+G1 X0 Y20 E0.800
+G1 X0 Y0 E0.800
+G1 X30 Y0 E1.200
+G1 X30 Y30 E1.200
+G1 X0 Y30 E1.200
+G1 X0 Y0 E1.200
+G1 X40 Y0 E1.600
+G1 X40 Y40 E1.600
+G1 X0 Y40 E1.600
+G1 X0 Y0 E1.600
+G1 X50 Y0 E2.000
+G1 X50 Y50 E2.000
+G1 X0 Y50 E2.000
+G1 X0 Y0 E2.000
+G1 X60 Y0 E2.400
+G1 X60 Y60 E2.400
+G1 X0 Y60 E2.400
+G1 X0 Y0 E2.400
+
+; Arcs
+G1 X40 Y20 F6000
+G2 X60 Y40 I20 J0 E1.2
+G3 X40 Y60 I-20 J0 E1.2
+G2 X20 Y40 I0 J-20 E1.2
+G3 X40 Y20 I20 J0 E1.2
+G2 X60 Y40 I20 J0 E1.2
+G3 X40 Y60 I-20 J0 E1.2
+G2 X20 Y40 I0 J-20 E1.2
+G3 X40 Y20 I20 J0 E1.2
+G2 X60 Y40 I20 J0 E1.2
+G3 X40 Y60 I-20 J0 E1.2
+G2 X20 Y40 I0 J-20 E1.2
+G3 X40 Y20 I20 J0 E1.2
+G2 X60 Y40 I20 J0 E1.2
+G3 X40 Y60 I-20 J0 E1.2
+G2 X20 Y40 I0 J-20 E1.2
+G3 X40 Y20 I20 J0 E1.2
+
+; A circle of short segments
+G1 F4800
+G1 X59.924 Y41.743 E0.07
+G1 X59.696 Y43.473 E0.07
+G1 X59.319 Y45.176 E0.07
+G1 X58.794 Y46.840 E0.07
+G1 X58.126 Y48.452 E0.07
+G1 X57.321 Y50.000 E0.07
+G1 X56.383 Y51.472 E0.07
+G1 X55.321 Y52.856 E0.07
+G1 X54.142 Y54.142 E0.07
+G1 X52.856 Y55.321 E0.07
+G1 X51.472 Y56.383 E0.07
+G1 X50.000 Y57.321 E0.07
+G1 X48.452 Y58.126 E0.07
+G1 X46.840 Y58.794 E0.07
+G1 X45.176 Y59.319 E0.07
+G1 X43.473 Y59.696 E0.07
+G1 X41.743 Y59.924 E0.07
+G1 X40.000 Y60.000 E0.07
+G1 X38.257 Y59.924 E0.07
+G1 X36.527 Y59.696 E0.07
+G1 X34.824 Y59.319 E0.07
+G1 X33.160 Y58.794 E0.07
+G1 X31.548 Y58.126 E0.07
+G1 X30.000 Y57.321 E0.07
+G1 X28.528 Y56.383 E0.07
+G1 X27.144 Y55.321 E0.07
+G1 X25.858 Y54.142 E0.07
+G1 X24.679 Y52.856 E0.07
+G1 X23.617 Y51.472 E0.07
+G1 X22.679 Y50.000 E0.07
+G1 X21.874 Y48.452 E0.07
+G1 X21.206 Y46.840 E0.07
+G1 X20.681 Y45.176 E0.07
+G1 X20.304 Y43.473 E0.07
+G1 X20.076 Y41.743 E0.07
+G1 X20.000 Y40.000 E0.07
+G1 X20.076 Y38.257 E0.07
+G1 X20.304 Y36.527 E0.07
+G1 X20.681 Y34.824 E0.07
+G1 X21.206 Y33.160 E0.07
+G1 X21.874 Y31.548 E0.07
+G1 X22.679 Y30.000 E0.07
+G1 X23.617 Y28.528 E0.07
+G1 X24.679 Y27.144 E0.07
+G1 X25.858 Y25.858 E0.07
+G1 X27.144 Y24.679 E0.07
+G1 X28.528 Y23.617 E0.07
+G1 X30.000 Y22.679 E0.07
+G1 X31.548 Y21.874 E0.07
+G1 X33.160 Y21.206 E0.07
+G1 X34.824 Y20.681 E0.07
+G1 X36.527 Y20.304 E0.07
+G1 X38.257 Y20.076 E0.07
+G1 X40.000 Y20.000 E0.07
+G1 X41.743 Y20.076 E0.07
+G1 X43.473 Y20.304 E0.07
+G1 X45.176 Y20.681 E0.07
+G1 X46.840 Y21.206 E0.07
+G1 X48.452 Y21.874 E0.07
+G1 X50.000 Y22.679 E0.07
+G1 X51.472 Y23.617 E0.07
+G1 X52.856 Y24.679 E0.07
+G1 X54.142 Y25.858 E0.07
+G1 X55.321 Y27.144 E0.07
+G1 X56.383 Y28.528 E0.07
+G1 X57.321 Y30.000 E0.07
+G1 X58.126 Y31.548 E0.07
+G1 X58.794 Y33.160 E0.07
+G1 X59.319 Y34.824 E0.07
+G1 X59.696 Y36.527 E0.07
+G1 X59.924 Y38.257 E0.07
+G1 X60.000 Y40.000 E0.07
+
+G1 Z10 F600
+G1 X0 Y0 F6000